@@ -0,0 +1,72 @@
+// ArgSource.cpp - Defines the ArgSource implementations.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#include "ArgSource.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace CmdLine
+{
+    bool ArgvSource::Next(std::string_view& arg)
+    {
+        if (mNext == mArgc)
+            return false;
+
+        arg = mArgv[mNext++];
+        return true;
+    }
+
+    bool ResponseFileSource::Next(std::string_view& arg)
+    {
+        if (mNext == mArgs.size())
+            return false;
+
+        arg = mArgs[mNext++];
+        return true;
+    }
+
+#ifdef __linux__
+    // /proc/self/cmdline is usually small, so it is read in small chunks.
+    // Each argument ends with a NUL, so an empty one is an empty record.
+    ProcCmdlineSource::ProcCmdlineSource()
+        : mFd{ open("/proc/self/cmdline", O_RDONLY) }, 
+        mReader{ mFd, '\0', 4096, true }
+    {
+    }
+
+    ProcCmdlineSource::~ProcCmdlineSource()
+    {
+        if (mFd >= 0)
+            close(mFd);
+    }
+#endif
+
+    std::vector<std::string> CollectArgs(ArgSource& source)
+    {
+        std::vector<std::string> args;
+        args.reserve(source.RemainingHint());
+
+        std::string_view arg;
+        while (source.Next(arg))
+            args.emplace_back(arg);
+
+        return args;
+    }
+}
@@ -0,0 +1,246 @@
+// ArgSource.h - Declares the ArgSource class and its implementations.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_ARG_SOURCE_H
+#define CMD_LINE_ARG_SOURCE_H
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "RecordReader.h"
+#include "ResponseFile.h"
+#include "ShellCommand.h"
+
+namespace CmdLine
+{
+    /// @brief A source of command line arguments.
+    ///
+    /// Arguments don't only come from main(); they may be in a container, a
+    /// ResponseFile, a pipe or, on Linux, /proc/self/cmdline. An ArgSource
+    /// hands them out one at a time as views, only reading each one when
+    /// it's asked for, so a source never needs to hold every argument as an
+    /// owned string. For example:
+    ///
+    ///     ArgvSource source{ argc, argv };
+    ///     std::string_view arg;
+    ///     while (source.Next(arg))
+    ///         std::cout << arg << "\n";
+    ///
+    /// Besides being read directly, a source can be given to a Parser (see
+    /// Parser::Parser()) or collected with CollectArgs().
+    class ArgSource
+    {
+    public:
+        virtual ~ArgSource() = default;
+
+        /// @brief Gets the next argument.
+        ///
+        /// @param arg Set to the argument, which is only valid until the 
+        /// next call or until the source is destroyed.
+        /// @return True if there was an argument, false if there are none
+        /// left.
+        virtual bool Next(std::string_view& arg) = 0;
+
+        /// @brief Gets how many arguments are left, if that's known.
+        ///
+        /// Lets the arguments be collected without reallocating. Sources
+        /// that can't know without reading ahead, such as pipes, return 0.
+        ///
+        /// @return The number of arguments left, or 0 if it isn't known.
+        virtual std::size_t RemainingHint() const { return 0; }
+    };
+
+    /// @brief An ArgSource for the arguments passed to main().
+    class ArgvSource : public ArgSource
+    {
+    public:
+        /// @brief Constructs a new ArgvSource.
+        ///
+        /// @param argc The number of arguments, including the program name.
+        /// @param argv The arguments, as passed to main().
+        ArgvSource(int argc, const char* const* argv)
+            : mArgc{ static_cast<std::size_t>(argc > 0 ? argc : 0) }, 
+            mArgv{ argv }, mNext{ 0 }
+        { }
+
+        bool Next(std::string_view& arg) override;
+
+        std::size_t RemainingHint() const override { return mArgc - mNext; }
+    private:
+        std::size_t mArgc;
+        const char* const* mArgv;
+        std::size_t mNext;
+    };
+
+    /// @brief An ArgSource for the arguments in a container.
+    ///
+    /// Works with any container of strings, string views or C strings, e.g.
+    /// a std::vector<std::string>. The container must outlive the source
+    /// and not change while it is being read.
+    ///
+    /// @tparam C The type of container.
+    template<typename C>
+    class ContainerSource : public ArgSource
+    {
+    public:
+        /// @brief Constructs a new ContainerSource.
+        ///
+        /// @param args The container of arguments.
+        ContainerSource(const C& args)
+            : mNext{ std::begin(args) }, mEnd{ std::end(args) }
+        { }
+
+        bool Next(std::string_view& arg) override
+        {
+            if (mNext == mEnd)
+                return false;
+
+            arg = *mNext++;
+            return true;
+        }
+
+        std::size_t RemainingHint() const override
+        {
+            return static_cast<std::size_t>(std::distance(mNext, mEnd));
+        }
+    private:
+        decltype(std::begin(std::declval<const C&>())) mNext;
+        decltype(std::end(std::declval<const C&>())) mEnd;
+    };
+
+    /// @brief An ArgSource for the arguments in a ResponseFile.
+    ///
+    /// The arguments are views into the file's mapping, so the ResponseFile
+    /// must outlive the source.
+    class ResponseFileSource : public ArgSource
+    {
+    public:
+        /// @brief Constructs a new ResponseFileSource.
+        ///
+        /// @param file The ResponseFile to read the arguments of.
+        ResponseFileSource(const ResponseFile& file)
+            : mArgs{ file.Args() }, mNext{ 0 }
+        { }
+
+        bool Next(std::string_view& arg) override;
+
+        std::size_t RemainingHint() const override 
+        { 
+            return mArgs.size() - mNext; 
+        }
+    private:
+        const std::vector<std::string_view>& mArgs;
+        std::size_t mNext;
+    };
+
+    /// @brief An ArgSource for the arguments in a ShellCommand.
+    ///
+    /// The arguments are views into the command and the ShellCommand, so 
+    /// both must outlive the source.
+    class ShellCommandSource 
+        : public ContainerSource<std::vector<std::string_view>>
+    {
+    public:
+        /// @brief Constructs a new ShellCommandSource.
+        ///
+        /// @param command The ShellCommand to read the arguments of.
+        ShellCommandSource(const ShellCommand& command)
+            : ContainerSource{ command.Args() }
+        { }
+    };
+
+    /// @brief An ArgSource for the delimited records read from a file
+    /// descriptor, e.g. a pipe.
+    ///
+    /// Each record is an argument, read with a RecordReader only when it is
+    /// asked for. Empty records are skipped unless the source is asked to 
+    /// keep them.
+    class DescriptorSource : public ArgSource
+    {
+    public:
+        /// @brief Constructs a new DescriptorSource.
+        ///
+        /// The descriptor isn't closed by the source.
+        ///
+        /// @param fd The file descriptor to read, e.g. 0 for stdin.
+        /// @param delimiter The character that ends each argument.
+        /// @param keepEmpty Whether empty arguments are handed out.
+        DescriptorSource(int fd, char delimiter, bool keepEmpty = false)
+            : mReader{ fd, delimiter, defaultRecordChunkSize, keepEmpty }
+        { }
+
+        bool Next(std::string_view& arg) override 
+        { 
+            return mReader.Next(arg); 
+        }
+
+        /// @brief Determines if reading the descriptor failed.
+        ///
+        /// @return True if a read failed, otherwise false.
+        bool Failed() const { return mReader.Failed(); }
+    private:
+        RecordReader mReader;
+    };
+
+#ifdef __linux__
+    /// @brief An ArgSource for the arguments the process was started with,
+    /// read from /proc/self/cmdline.
+    ///
+    /// Lets a library find the program's arguments without them being 
+    /// passed down from main(). Only available on Linux. Every argument, 
+    /// including an empty one, is handed out, so positions match argv.
+    class ProcCmdlineSource : public ArgSource
+    {
+    public:
+        /// @brief Constructs a new ProcCmdlineSource.
+        ///
+        /// If /proc/self/cmdline can't be opened the source has no 
+        /// arguments and Failed() is true.
+        ProcCmdlineSource();
+
+        /// @brief Closes /proc/self/cmdline.
+        ~ProcCmdlineSource();
+
+        ProcCmdlineSource(const ProcCmdlineSource&) = delete;
+        ProcCmdlineSource& operator=(const ProcCmdlineSource&) = delete;
+
+        bool Next(std::string_view& arg) override 
+        { 
+            return mReader.Next(arg); 
+        }
+
+        /// @brief Determines if reading /proc/self/cmdline failed.
+        ///
+        /// @return True if it couldn't be opened or read, otherwise false.
+        bool Failed() const { return mFd < 0 || mReader.Failed(); }
+    private:
+        int mFd;
+        RecordReader mReader;
+    };
+#endif
+
+    /// @brief Reads every argument left in an ArgSource.
+    ///
+    /// @param source The source to read.
+    /// @return The arguments, in order.
+    std::vector<std::string> CollectArgs(ArgSource& source);
+}
+
+#endif
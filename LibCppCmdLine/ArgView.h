@@ -0,0 +1,173 @@
+// ArgView.h - Declares the ArgView class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_ARG_VIEW_H
+#define CMD_LINE_ARG_VIEW_H
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CmdLine
+{
+    /// @brief A random-access view of a range of arguments.
+    ///
+    /// Refers to arguments stored elsewhere, e.g. those a Parser was 
+    /// constructed with, without copying them, so making one takes O(1) 
+    /// time and memory however many arguments it covers. Each argument is
+    /// a std::string_view. The view is only valid as long as the arguments
+    /// it refers to are. For example:
+    ///
+    ///     for (std::string_view path : files.ValueView())
+    ///         Process(path);
+    class ArgView
+    {
+    public:
+        /// @brief An iterator over the arguments in an ArgView.
+        class Iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = std::string_view;
+
+            Iterator() : mArg{ nullptr } { }
+
+            explicit Iterator(const std::string* arg) : mArg{ arg } { }
+
+            reference operator*() const { return *mArg; }
+
+            reference operator[](difference_type n) const { return mArg[n]; }
+
+            Iterator& operator++() { ++mArg; return *this; }
+
+            Iterator operator++(int) { return Iterator{ mArg++ }; }
+
+            Iterator& operator--() { --mArg; return *this; }
+
+            Iterator operator--(int) { return Iterator{ mArg-- }; }
+
+            Iterator& operator+=(difference_type n) { mArg += n; return *this; }
+
+            Iterator& operator-=(difference_type n) { mArg -= n; return *this; }
+
+            Iterator operator+(difference_type n) const 
+            { 
+                return Iterator{ mArg + n }; 
+            }
+
+            friend Iterator operator+(difference_type n, Iterator i)
+            {
+                return i + n;
+            }
+
+            Iterator operator-(difference_type n) const 
+            { 
+                return Iterator{ mArg - n }; 
+            }
+
+            difference_type operator-(Iterator other) const 
+            { 
+                return mArg - other.mArg; 
+            }
+
+            bool operator==(Iterator other) const { return mArg == other.mArg; }
+
+            bool operator!=(Iterator other) const { return mArg != other.mArg; }
+
+            bool operator<(Iterator other) const { return mArg < other.mArg; }
+
+            bool operator>(Iterator other) const { return mArg > other.mArg; }
+
+            bool operator<=(Iterator other) const { return mArg <= other.mArg; }
+
+            bool operator>=(Iterator other) const { return mArg >= other.mArg; }
+        private:
+            const std::string* mArg;
+        };
+
+        /// @brief Constructs an empty ArgView.
+        ArgView() : mFirst{ nullptr }, mSize{ 0 } { }
+
+        /// @brief Constructs a new ArgView of contiguous arguments.
+        ///
+        /// @param first The first argument.
+        /// @param size The number of arguments.
+        ArgView(const std::string* first, std::size_t size)
+            : mFirst{ first }, mSize{ size }
+        { }
+
+        /// @brief Constructs a new ArgView of every argument in a vector.
+        ///
+        /// @param args The arguments.
+        ArgView(const std::vector<std::string>& args)
+            : mFirst{ args.data() }, mSize{ args.size() }
+        { }
+
+        /// @brief Gets the number of arguments in the view.
+        ///
+        /// @return The number of arguments.
+        std::size_t Size() const { return mSize; }
+
+        /// @brief Determines if the view has no arguments.
+        ///
+        /// @return True if the view is empty, otherwise false.
+        bool IsEmpty() const { return mSize == 0; }
+
+        /// @brief Gets an argument.
+        ///
+        /// @param i The index of the argument in the view.
+        /// @return The argument.
+        /// @pre The index is less than Size().
+        std::string_view operator[](std::size_t i) const { return mFirst[i]; }
+
+        /// @brief Gets part of the view.
+        ///
+        /// @param offset The index of the first argument of the part.
+        /// @param count The largest number of arguments in the part.
+        /// @return A view of the part, which is empty if the offset is past
+        /// the end.
+        ArgView Subview(std::size_t offset, std::size_t count) const
+        {
+            if (offset >= mSize)
+                return ArgView{};
+
+            std::size_t remaining = mSize - offset;
+            return ArgView{ mFirst + offset, 
+                count < remaining ? count : remaining };
+        }
+
+        /// @brief Gets an iterator to the first argument.
+        ///
+        /// @return The iterator.
+        Iterator begin() const { return Iterator{ mFirst }; }
+
+        /// @brief Gets an iterator past the last argument.
+        ///
+        /// @return The iterator.
+        Iterator end() const { return Iterator{ mFirst + mSize }; }
+    private:
+        const std::string* mFirst;
+        std::size_t mSize;
+    };
+}
+
+#endif
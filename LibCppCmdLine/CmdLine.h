@@ -115,12 +115,30 @@
 #ifndef CMD_LINE_H
 #define CMD_LINE_H
 
+#include "ArgSource.h"
+#include "ArgView.h"
+#include "CommandBuilder.h"
+#include "Error.h"
 #include "MultiPosParam.h"
 #include "Option.h"
 #include "OptionParam.h"
+#include "ParseCursor.h"
+#include "ParseError.h"
+#include "ParseGenerator.h"
+#include "ParseHandler.h"
+#include "ParseObserver.h"
+#include "ParseProfiler.h"
+#include "ParseSnapshot.h"
+#include "ParseTrace.h"
 #include "Parser.h"
 #include "PosParam.h"
+#include "Probe.h"
 #include "ProgParam.h"
+#include "RecordReader.h"
+#include "ResponseFile.h"
+#include "ShellCommand.h"
 #include "ValueOption.h"
+#include "ValuePartition.h"
+#include "WorkerPool.h"
 
 #endif
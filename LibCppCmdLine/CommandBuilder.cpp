@@ -0,0 +1,292 @@
+// CommandBuilder.cpp - Defines the CommandBuilder class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#include "CommandBuilder.h"
+
+#include <algorithm>
+#include <fstream>
+#include <utility>
+
+#ifndef _WIN32
+#include <climits>
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
+namespace CmdLine
+{
+    ArgLimits SystemArgLimits()
+    {
+#ifdef _WIN32
+        // CreateProcess() limits the whole command line to 32767 characters.
+        return ArgLimits{ 32767, 32767 };
+#else
+        long argMax = sysconf(_SC_ARG_MAX);
+        std::size_t limit = argMax > 0 
+            ? static_cast<std::size_t>(argMax) : _POSIX_ARG_MAX;
+
+        // The environment is passed in the same space as the arguments.
+        std::size_t environment = 0;
+        for (char** e = environ; e != nullptr && *e != nullptr; e++)
+            environment += CommandBuilder::ArgSize(*e);
+
+        std::size_t reserved = environment + argLimitHeadroom;
+        std::size_t total = limit > reserved ? limit - reserved : 0;
+
+#ifdef __linux__
+        // Linux also limits each argument to MAX_ARG_STRLEN, 32 pages.
+        long pageSize = sysconf(_SC_PAGESIZE);
+        std::size_t perArgument = 32 * static_cast<std::size_t>(
+            pageSize > 0 ? pageSize : 4096);
+        return ArgLimits{ total, std::min(total, perArgument) };
+#else
+        return ArgLimits{ total, total };
+#endif
+#endif
+    }
+
+    CommandBuilder::CommandBuilder(std::string program, ArgLimits limits)
+        : mProgram{ std::move(program) }, mLimits{ limits }, 
+          mMultiPosParam{ nullptr }
+    { }
+
+    void CommandBuilder::Add(const Option& o)
+    {
+        if (!o.IsSpecified())
+            return;
+
+        auto valueOption = dynamic_cast<const ValueOption*>(&o);
+        if (valueOption == nullptr)
+        {
+            mOptionArgs.push_back(o.Name());
+            return;
+        }
+
+        for (auto& value : valueOption->Values())
+        {
+            mOptionArgs.push_back(o.Name());
+            mOptionArgs.push_back(value);
+        }
+    }
+
+    void CommandBuilder::Add(const PosParam& p)
+    {
+        if (p.IsSpecified())
+            mPosArgs.push_back(p.Value());
+    }
+
+    void CommandBuilder::Set(const MultiPosParam& m)
+    {
+        mMultiPosParam = &m;
+    }
+
+    std::size_t CommandBuilder::ArgSize(std::string_view arg)
+    {
+#ifdef _WIN32
+        return arg.size() + 3;
+#else
+        return arg.size() + 1 + sizeof(char*);
+#endif
+    }
+
+    Error CommandBuilder::Build(std::vector<std::vector<std::string>>& commands,
+        const std::string& spillPath) const
+    {
+        commands.clear();
+
+        ArgView values;
+        if (mMultiPosParam != nullptr && mMultiPosParam->IsSpecified())
+            values = mMultiPosParam->ValueView();
+
+        std::vector<std::string> before;
+        std::vector<std::string> after;
+        FixedArgs(values, before, after);
+
+        std::size_t beforeSize = 0;
+        std::size_t afterSize = 0;
+        bool fits = Fits(before, beforeSize) && Fits(after, afterSize) &&
+            beforeSize + afterSize <= mLimits.total;
+        std::size_t available = fits 
+            ? mLimits.total - beforeSize - afterSize : 0;
+
+        // Values are added to the current command until the next one would
+        // take it over the limit, as xargs does.
+        std::vector<std::string> command = before;
+        std::size_t size = 0;
+        for (std::size_t i = 0; fits && i < values.Size(); i++)
+        {
+            std::size_t valueSize = ArgSize(values[i]);
+            if (values[i].size() >= mLimits.perArgument || 
+                valueSize > available)
+            {
+                fits = false;
+                break;
+            }
+
+            if (size + valueSize > available)
+            {
+                command.insert(command.end(), after.begin(), after.end());
+                commands.push_back(std::move(command));
+                command = before;
+                size = 0;
+            }
+
+            command.emplace_back(values[i]);
+            size += valueSize;
+        }
+
+        if (fits)
+        {
+            command.insert(command.end(), after.begin(), after.end());
+            commands.push_back(std::move(command));
+            return Error{};
+        }
+
+        commands.clear();
+        if (spillPath.empty())
+        {
+            return Raise<ArgumentsTooLong>(ErrorCode::ArgumentsTooLong, 
+                argumentsTooLongError);
+        }
+
+        commands.emplace_back();
+        Error e = Spill(spillPath, commands.back());
+        if (e.code != ErrorCode::None)
+            commands.clear();
+
+        return e;
+    }
+
+    Error CommandBuilder::Spill(const std::string& path, 
+        std::vector<std::string>& command) const
+    {
+        ArgView values;
+        if (mMultiPosParam != nullptr && mMultiPosParam->IsSpecified())
+            values = mMultiPosParam->ValueView();
+
+        std::vector<std::string> before;
+        std::vector<std::string> after;
+        FixedArgs(values, before, after);
+
+        // Only the positional arguments, which follow the Options, are 
+        // moved to the response file.
+        std::vector<std::string> spilled{ before.begin() + 1 + 
+            mOptionArgs.size(), before.end() };
+        before.resize(1 + mOptionArgs.size());
+        before.push_back(responseFilePrefix + path);
+
+        std::size_t size = 0;
+        if (!Fits(before, size))
+        {
+            return Raise<ArgumentsTooLong>(ErrorCode::ArgumentsTooLong, 
+                argumentsTooLongError);
+        }
+
+        // A response file holds one argument per line and skips empty 
+        // lines, and a carriage return at the end of a line is dropped.
+        auto representable = [](std::string_view arg)
+        {
+            return !arg.empty() && arg.back() != '\r' && 
+                arg.find('\n') == std::string_view::npos;
+        };
+
+        if (!std::all_of(spilled.begin(), spilled.end(), representable) ||
+            !std::all_of(values.begin(), values.end(), representable) ||
+            !std::all_of(after.begin(), after.end(), representable))
+        {
+            return Raise<Unwritable>(ErrorCode::UnwritableResponseFile, 
+                unrepresentableArgumentError);
+        }
+
+        std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+        for (auto& arg : spilled)
+            file << arg << '\n';
+        for (std::string_view value : values)
+            file << value << '\n';
+        for (auto& arg : after)
+            file << arg << '\n';
+
+        file.close();
+        if (!file)
+        {
+            return Raise<Unwritable>(ErrorCode::UnwritableResponseFile, 
+                unwritableResponseFileError);
+        }
+
+        command = std::move(before);
+        return Error{};
+    }
+
+    void CommandBuilder::FixedArgs(ArgView values, 
+        std::vector<std::string>& before, std::vector<std::string>& after) 
+        const
+    {
+        before.clear();
+        after.clear();
+        before.reserve(mOptionArgs.size() + mPosArgs.size() + 2);
+        before.push_back(mProgram);
+        before.insert(before.end(), mOptionArgs.begin(), mOptionArgs.end());
+
+        // A positional value that looks like an Option, or is itself the
+        // end-of-options marker, would be parsed as one unless it's after 
+        // the marker. Checking the prefix alone covers both.
+        auto looksLikeOption = [](std::string_view arg)
+        {
+            return StartsWithOptionPrefix(arg);
+        };
+
+        if (std::any_of(mPosArgs.begin(), mPosArgs.end(), looksLikeOption) ||
+            std::any_of(values.begin(), values.end(), looksLikeOption))
+        {
+            before.push_back(endOfOptionsMarker);
+        }
+
+        // The Parser fills a MultiPosParam parsed AfterOptions before the
+        // PosParams, so its values go first.
+        using Order = MultiPosParam::ParsingOrder;
+        bool valuesFirst = mMultiPosParam != nullptr && 
+            mMultiPosParam->Order() == Order::AfterOptions;
+        std::vector<std::string>& posArgs = valuesFirst ? after : before;
+        posArgs.insert(posArgs.end(), mPosArgs.begin(), mPosArgs.end());
+    }
+
+    bool CommandBuilder::Fits(const std::vector<std::string>& args, 
+        std::size_t& size) const
+    {
+        size = 0;
+        for (auto& arg : args)
+        {
+            if (arg.size() >= mLimits.perArgument)
+                return false;
+
+            size += ArgSize(arg);
+        }
+
+        return size <= mLimits.total;
+    }
+
+    CommandBuilder::ArgumentsTooLong::ArgumentsTooLong(const char* message)
+        : length_error(message)
+    {
+    }
+
+    CommandBuilder::Unwritable::Unwritable(const char* message)
+        : runtime_error(message)
+    {
+    }
+}
@@ -0,0 +1,212 @@
+// CommandBuilder.h - Declares the CommandBuilder class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_COMMAND_BUILDER_H
+#define CMD_LINE_COMMAND_BUILDER_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ArgView.h"
+#include "Constants.h"
+#include "Error.h"
+#include "MultiPosParam.h"
+#include "Option.h"
+#include "PosParam.h"
+#include "ValueOption.h"
+
+namespace CmdLine
+{
+    /// @brief The space left under the system limit by default, as xargs
+    /// does, for anything the limit doesn't account for.
+    constexpr std::size_t argLimitHeadroom = 2048;
+
+    /// @brief The limits on the arguments of a command.
+    struct ArgLimits
+    {
+        /// @brief The most space the arguments can take in all, as counted 
+        /// by CommandBuilder::ArgSize().
+        std::size_t total;
+
+        /// @brief The longest a single argument can be, including its 
+        /// terminating NUL.
+        std::size_t perArgument;
+    };
+
+    /// @brief Gets the limits on the arguments of commands this process 
+    /// runs.
+    ///
+    /// On POSIX systems the total is ARG_MAX less the space the environment
+    /// takes and argLimitHeadroom, and on Linux no argument can be longer
+    /// than 32 pages. On Windows the limit is the length of a command line.
+    ///
+    /// @return The limits.
+    ArgLimits SystemArgLimits();
+
+    /// @brief Builds the commands that pass parsed arguments on to another
+    /// program.
+    ///
+    /// A program that hands its work to another, e.g. one invocation of a
+    /// compiler per batch of files, adds the Options and PosParams it 
+    /// parsed and sets its MultiPosParam, and each command is built from 
+    /// their values. Options come first, then the positional values in the
+    /// order a Parser reads them back, after the end-of-options marker if 
+    /// any of them starts with an Option prefix (including a value that is
+    /// the marker itself). For example:
+    ///
+    ///     CommandBuilder builder{ "compiler" };
+    ///     builder.Add(verbose);
+    ///     builder.Add(output);
+    ///     builder.Set(files);
+    ///     std::vector<std::vector<std::string>> commands;
+    ///     builder.Build(commands, "files.rsp");
+    ///     for (auto& c : commands)
+    ///         Run(c);
+    ///
+    /// Like xargs, the MultiPosParam values are split into as few commands
+    /// as fit within the system's ArgLimits, with every other argument
+    /// repeated in each. A value too long for any command is spilled to a 
+    /// response file instead, which the program reads with 
+    /// ExpandResponseFiles().
+    class CommandBuilder
+    {
+    public:
+        /// @brief An exception thrown for arguments that don't fit on a 
+        /// command line.
+        class ArgumentsTooLong : public std::length_error
+        {
+        public:
+            /// @brief Constructs an ArgumentsTooLong exception.
+            ///
+            /// @param message The message to include with the exception.
+            ArgumentsTooLong(const char* message);
+        };
+
+        /// @brief An exception thrown for a response file that can't be
+        /// written.
+        class Unwritable : public std::runtime_error
+        {
+        public:
+            /// @brief Constructs an Unwritable exception.
+            ///
+            /// @param message The message to include with the exception.
+            Unwritable(const char* message);
+        };
+
+        /// @brief Constructs a new CommandBuilder.
+        ///
+        /// @param program The program each command runs, which is the first
+        /// argument of each.
+        /// @param limits The limits each command must fit within.
+        CommandBuilder(std::string program, 
+            ArgLimits limits = SystemArgLimits());
+
+        /// @brief Adds an Option to each command if it's specified.
+        ///
+        /// A ValueOption is added once per value, followed by the value.
+        ///
+        /// @param o The Option to add.
+        void Add(const Option& o);
+
+        /// @brief Adds a PosParam to each command if it's specified.
+        ///
+        /// PosParams are added in the order they are on the Parser.
+        ///
+        /// @param p The PosParam to add.
+        void Add(const PosParam& p);
+
+        /// @brief Sets the MultiPosParam whose values are split between 
+        /// the commands.
+        ///
+        /// The values are read when the commands are built, so the
+        /// MultiPosParam must still exist then.
+        ///
+        /// @param m The MultiPosParam.
+        void Set(const MultiPosParam& m);
+
+        /// @brief Gets the space an argument takes on a command line.
+        ///
+        /// On POSIX systems an argument takes its length, its terminating 
+        /// NUL and the pointer to it. On Windows it takes its length, the
+        /// quotes around it and the space before it.
+        ///
+        /// @param arg The argument.
+        /// @return The space the argument takes.
+        static std::size_t ArgSize(std::string_view arg);
+
+        /// @brief Builds the commands.
+        ///
+        /// Builds a single command if no MultiPosParam is set or it has no
+        /// values. Otherwise the values are split between as few commands
+        /// as fit within the limits. If any value can't fit in a command, 
+        /// a spill path is given, the positional values are written to it 
+        /// with Spill() and a single command is built that refers to it.
+        ///
+        /// @param commands Set to the arguments of each command.
+        /// @param spillPath The path of the response file to spill to, or 
+        /// an empty path not to.
+        /// @return The error that prevented the commands being built, if 
+        /// the library is built without exceptions (see Error).
+        /// @exception ArgumentsTooLong An argument can't fit in a command.
+        /// @exception Unwritable The response file couldn't be written.
+        Error Build(std::vector<std::vector<std::string>>& commands,
+            const std::string& spillPath = "") const;
+
+        /// @brief Builds a command that reads its positional values from a 
+        /// response file.
+        ///
+        /// Writes the positional values, including the end-of-options 
+        /// marker if it's needed, to the file one per line, and builds a 
+        /// command of the program, the Options and "@" followed by the path.
+        ///
+        /// @param path The path of the response file to write.
+        /// @param command Set to the arguments of the command.
+        /// @return The error that prevented the command being built, if the
+        /// library is built without exceptions (see Error).
+        /// @exception ArgumentsTooLong The command doesn't fit.
+        /// @exception Unwritable A value is empty or spans lines, or the 
+        /// response file couldn't be written.
+        Error Spill(const std::string& path, 
+            std::vector<std::string>& command) const;
+    private:
+        std::string mProgram;
+        ArgLimits mLimits;
+        std::vector<std::string> mOptionArgs;
+        std::vector<std::string> mPosArgs;
+        const MultiPosParam* mMultiPosParam;
+
+        /// @brief Gets the arguments before and after the MultiPosParam 
+        /// values, which every command has.
+        ///
+        /// @param values The MultiPosParam values.
+        /// @param before Set to the arguments before the values.
+        /// @param after Set to the arguments after the values.
+        void FixedArgs(ArgView values, std::vector<std::string>& before,
+            std::vector<std::string>& after) const;
+
+        /// @brief Determines if arguments fit within the limits.
+        ///
+        /// @param args The arguments.
+        /// @param size Set to the space the arguments take.
+        /// @return True if they fit, otherwise false.
+        bool Fits(const std::vector<std::string>& args, std::size_t& size) 
+            const;
+    };
+}
+
+#endif
@@ -34,6 +34,9 @@ namespace CmdLine
     const char* unixOptionLongPrefix{ "--" };
     const char* windowsOptionShortPrefix{ "/" };
     const char* windowsOptionLongPrefix{ "/" };
+    const char* endOfOptionsMarker{ "--" };
+    const char responseFilePrefix{ '@' };
+    const char* stdinArgument{ "-" };
 
     const char helpOptionShortName{ 'h' };
     const char* helpOptionLongName{ "help" };
@@ -91,4 +94,28 @@ namespace CmdLine
     { 
         "cannot add a duplicate PosParam to the Parser" 
     };
+    const char* unreadableResponseFileError
+    {
+        "cannot read the response file"
+    };
+    const char* argumentsTooLongError
+    {
+        "the arguments don't fit on a command line"
+    };
+    const char* unwritableResponseFileError
+    {
+        "cannot write the response file"
+    };
+    const char* unrepresentableArgumentError
+    {
+        "an argument is empty or spans lines, so it can't be in a response file"
+    };
+    const char* invalidSnapshotError
+    {
+        "the data isn't a valid parse snapshot"
+    };
+    const char* unterminatedQuoteError
+    {
+        "a quote in the command isn't closed"
+    };
 }
@@ -58,6 +58,15 @@ namespace CmdLine
     /// @brief The long option prefix used with Option::Style::Windows.
     extern const char* windowsOptionLongPrefix;
 
+    /// @brief The argument after which every argument is positional.
+    extern const char* endOfOptionsMarker;
+
+    /// @brief The prefix of an argument naming a ResponseFile.
+    extern const char responseFilePrefix;
+
+    /// @brief The argument standing for the values on standard input.
+    extern const char* stdinArgument;
+
     /// @brief The short option name for the built-in help option.
     extern const char helpOptionShortName;
 
@@ -124,6 +133,26 @@ namespace CmdLine
     /// @brief An error message for adding a duplicate 
     /// CommandLine::OptionParameter.
     extern const char* duplicateOptionParamError;
+
+    /// @brief An error message for a ResponseFile that can't be read.
+    extern const char* unreadableResponseFileError;
+
+    /// @brief An error message for arguments that don't fit on a command 
+    /// line.
+    extern const char* argumentsTooLongError;
+
+    /// @brief An error message for a response file that can't be written.
+    extern const char* unwritableResponseFileError;
+
+    /// @brief An error message for an argument a response file can't hold.
+    extern const char* unrepresentableArgumentError;
+
+    /// @brief An error message for data that isn't a valid ParseSnapshot.
+    extern const char* invalidSnapshotError;
+
+    /// @brief An error message for a ShellCommand with a quote that isn't 
+    /// closed.
+    extern const char* unterminatedQuoteError;
 }
 
 #endif
@@ -0,0 +1,57 @@
+// Error.cpp - Defines the Error functions.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include "Error.h"
+
+namespace CmdLine
+{
+    const char* ErrorCodeName(ErrorCode c)
+    {
+        switch (c)
+        {
+            case ErrorCode::None:
+                return "None";
+            case ErrorCode::InvalidDefinition:
+                return "InvalidDefinition";
+            case ErrorCode::InvalidPair:
+                return "InvalidPair";
+            case ErrorCode::NullParameter:
+                return "NullParameter";
+            case ErrorCode::EmptyArguments:
+                return "EmptyArguments";
+            case ErrorCode::DuplicateOption:
+                return "DuplicateOption";
+            case ErrorCode::DuplicatePosParam:
+                return "DuplicatePosParam";
+            case ErrorCode::NullOptionParam:
+                return "NullOptionParam";
+            case ErrorCode::DuplicateOptionParam:
+                return "DuplicateOptionParam";
+            case ErrorCode::UnreadableResponseFile:
+                return "UnreadableResponseFile";
+            case ErrorCode::ArgumentsTooLong:
+                return "ArgumentsTooLong";
+            case ErrorCode::UnwritableResponseFile:
+                return "UnwritableResponseFile";
+            case ErrorCode::InvalidSnapshot:
+                return "InvalidSnapshot";
+            case ErrorCode::UnterminatedQuote:
+                return "UnterminatedQuote";
+        }
+
+        return "";
+    }
+}
@@ -0,0 +1,121 @@
+// Error.h - Declares the Error struct and error reporting helpers.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_ERROR_H
+#define CMD_LINE_ERROR_H
+
+namespace CmdLine
+{
+    /// @brief The kinds of error the library reports.
+    ///
+    /// Each kind corresponds to one of the exceptions the library throws,
+    /// e.g. ErrorCode::DuplicateOption to Parser::DuplicateOption.
+    enum class ErrorCode
+    {
+        /// @brief There is no error.
+        None,
+
+        /// @brief A Param::Definition is invalid.
+        InvalidDefinition,
+
+        /// @brief A string isn't a NameValuePair.
+        InvalidPair,
+
+        /// @brief A null Param was given to a Parser.
+        NullParameter,
+
+        /// @brief A Parser was given no arguments.
+        EmptyArguments,
+
+        /// @brief An Option with the same name was already added.
+        DuplicateOption,
+
+        /// @brief A PosParam with the same name was already added.
+        DuplicatePosParam,
+
+        /// @brief A null OptionParam was given to a ValueOption.
+        NullOptionParam,
+
+        /// @brief An OptionParam with the same name was already added.
+        DuplicateOptionParam,
+
+        /// @brief A ResponseFile couldn't be read.
+        UnreadableResponseFile,
+
+        /// @brief Arguments don't fit on a command line.
+        ArgumentsTooLong,
+
+        /// @brief A response file couldn't be written.
+        UnwritableResponseFile,
+
+        /// @brief Data isn't a valid ParseSnapshot.
+        InvalidSnapshot,
+
+        /// @brief A quote in a ShellCommand isn't closed.
+        UnterminatedQuote
+    };
+
+    /// @brief An error reported without throwing an exception.
+    ///
+    /// When the library is built with CMD_LINE_NO_EXCEPTIONS defined (see 
+    /// the LIBCPPCMDLINE_EXCEPTIONS CMake option), nothing it does throws.
+    /// Methods that would otherwise throw return an Error instead, and
+    /// constructors that would throw record one that can be checked with 
+    /// ConstructionError(). For example:
+    ///
+    ///     Option verbose{ verboseDef };
+    ///     if (verbose.ConstructionError().code != ErrorCode::None)
+    ///         return 1;
+    ///
+    ///     if (parser.Add(&verbose).code != ErrorCode::None)
+    ///         return 1;
+    ///
+    /// When exceptions are enabled the same methods throw as they always
+    /// have, so an Error they return is always ErrorCode::None.
+    struct Error
+    {
+        /// @brief The kind of error.
+        ErrorCode code{ ErrorCode::None };
+
+        /// @brief The message the corresponding exception would carry.
+        const char* message{ "" };
+    };
+
+    /// @brief Gets the name of an ErrorCode.
+    ///
+    /// @param c The ErrorCode to get the name of.
+    /// @return The name of the code, e.g. "DuplicateOption".
+    const char* ErrorCodeName(ErrorCode c);
+
+    /// @brief Reports an error the way the library was built to.
+    ///
+    /// @tparam E The type of exception to throw.
+    /// @param code The kind of error.
+    /// @param message The message describing the error.
+    /// @return The Error, if the library is built without exceptions.
+    /// @exception E Thrown unless CMD_LINE_NO_EXCEPTIONS is defined.
+    template<typename E>
+    Error Raise([[maybe_unused]] ErrorCode code, const char* message)
+    {
+#ifdef CMD_LINE_NO_EXCEPTIONS
+        return Error{ code, message };
+#else
+        throw E{ message };
+#endif
+    }
+}
+
+#endif
@@ -0,0 +1,40 @@
+// JsonString.h - Declares the JSON string escaping helper.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_JSON_STRING_H
+#define CMD_LINE_JSON_STRING_H
+
+#include <string>
+
+namespace CmdLine
+{
+    /// @brief Appends a string to JSON text as a quoted JSON string.
+    ///
+    /// Quotes, backslashes and control characters are escaped; everything
+    /// else, including UTF-8 sequences, is copied as is. Both ParseProfiler
+    /// and the benchmark tools write JSON this way. For example:
+    ///
+    ///     std::string json{ "{\"name\":" };
+    ///     AppendJsonString(json, p.Name());
+    ///     json += '}';
+    ///
+    /// @param out The JSON text to append to.
+    /// @param s The string to append.
+    void AppendJsonString(std::string& out, const std::string& s);
+}
+
+#endif
@@ -15,14 +15,19 @@
 // limitations under the License.
 
 #include "MultiPosParam.h"
+#include "RecordReader.h"
 
 namespace CmdLine
 {
     MultiPosParam::MultiPosParam(Definition d)
-        : mDefinition{ d }, mIsSpecified{ false }, mOrder{ ParsingOrder::End }
+        : mDefinition{ d }, mIsSpecified{ false }, mIsViewed{ false }, 
+          mOrder{ ParsingOrder::End }
     {
         if (!IsValidNonOptionName(mDefinition.name))
-            throw InvalidDefinition{ nameError };
+        {
+            mConstructionError = Raise<InvalidDefinition>(
+                ErrorCode::InvalidDefinition, nameError);
+        }
     }
 
     std::string MultiPosParam::HelpInfo() const
@@ -35,6 +40,8 @@ namespace CmdLine
         if (CanPopulate(args))
         {
             mIsSpecified = true;
+            CopyViewedValues();
+            mValues.reserve(mValues.size() + args.size());
 
             while (args.size() > 0)
             {
@@ -50,6 +57,59 @@ namespace CmdLine
         }
     }
 
+    bool MultiPosParam::PopulateOperands(std::deque<std::string>& args)
+    {
+        if (args.empty())
+            return false;
+
+        mIsSpecified = true;
+        CopyViewedValues();
+        mValues.reserve(mValues.size() + args.size());
+        std::move(args.begin(), args.end(), std::back_inserter(mValues));
+        args.clear();
+        return true;
+    }
+
+    bool MultiPosParam::PopulateView(ArgView args)
+    {
+        if (args.IsEmpty())
+            return false;
+
+        // Values from an earlier population are kept in front, as they 
+        // would be by Populate().
+        if (mIsViewed || !mValues.empty())
+        {
+            CopyViewedValues();
+            mValues.insert(mValues.end(), args.begin(), args.end());
+        }
+        else
+        {
+            mView = args;
+            mIsViewed = true;
+        }
+
+        mIsSpecified = true;
+        return true;
+    }
+
+    std::vector<std::string> MultiPosParam::Values() const
+    {
+        if (!mIsViewed)
+            return mValues;
+
+        return std::vector<std::string>{ mView.begin(), mView.end() };
+    }
+
+    void MultiPosParam::CopyViewedValues()
+    {
+        if (!mIsViewed)
+            return;
+
+        mValues.assign(mView.begin(), mView.end());
+        mView = ArgView{};
+        mIsViewed = false;
+    }
+
     bool MultiPosParam::CanPopulate(const std::deque<std::string>& args) const
     {
         if (args.size() == 0)
@@ -64,6 +124,34 @@ namespace CmdLine
         return true;
     }
 
+    bool MultiPosParam::ForEachValue(
+        const std::function<void(std::string_view)>& f, int stdinFd) const
+    {
+        bool stdinRead = mDefinition.stdinFormat == StdinFormat::None;
+        for (std::string_view value : ValueView())
+        {
+            if (stdinRead || value != stdinArgument)
+            {
+                f(value);
+                continue;
+            }
+
+            char delimiter = mDefinition.stdinFormat == StdinFormat::Lines
+                ? '\n' : '\0';
+            RecordReader reader{ stdinFd, delimiter };
+            std::string_view record;
+            while (reader.Next(record))
+                f(record);
+
+            if (reader.Failed())
+                return false;
+
+            stdinRead = true;
+        }
+
+        return true;
+    }
+
     std::size_t MultiPosParam::Consumes(const std::deque<std::string>& args)
         const
     {
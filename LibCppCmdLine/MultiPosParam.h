@@ -17,12 +17,18 @@
 #ifndef CMD_LINE_MULTI_POS_PARAM_H
 #define CMD_LINE_MULTI_POS_PARAM_H
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
 #include <string>
+#include <string_view>
 #include <vector>
+#include "ArgView.h"
 #include "Param.h"
 #include "ArgParam.h"
 #include "Option.h"
 #include "Validation.h"
+#include "ValuePartition.h"
 #include "Help.h"
 
 namespace CmdLine
@@ -65,6 +71,25 @@ namespace CmdLine
             AfterOptions  
         };
 
+        /// @brief Determines how values are read from standard input.
+        ///
+        /// A program fed its values by a pipeline is typically passed "-"
+        /// in place of the values, e.g. "find -print0 | tool -". The
+        /// format determines whether the MultiPosParam treats "-" that way
+        /// and how the values piped to it are separated.
+        enum class StdinFormat
+        {
+            /// @brief "-" is an ordinary value. This is the default value.
+            None,
+
+            /// @brief "-" stands for the lines of standard input.
+            Lines,
+
+            /// @brief "-" stands for the NUL-terminated records of standard
+            /// input, as written by "find -print0" or "xargs -0".
+            NullTerminated
+        };
+
         /// @brief This definition is used to construct a MutiPosParam.
         /// 
         /// A MultiPosParam::Definition is passed to the MultiPosParam
@@ -91,6 +116,16 @@ namespace CmdLine
             ///
             /// @sa Order().
             ParsingOrder order = ParsingOrder::End;
+
+            /// @brief Determines the MultiPosParam::StdinFormat.
+            ///
+            /// @sa ForEachValue().
+            StdinFormat stdinFormat = StdinFormat::None;
+
+            /// @brief Determines if the values refer to the arguments.
+            ///
+            /// @sa IsLazy().
+            bool isLazy = false;
         };
 
         /// @brief Constructs a new MultiPosParam.
@@ -190,6 +225,36 @@ namespace CmdLine
         /// @return True if the arguments can populate, otherwise false.
         bool CanPopulate(const std::deque<std::string>& args) const override;
 
+        /// @brief Populates the MultiPosParam from operands.
+        ///
+        /// Operands are the arguments after the end-of-options marker, which
+        /// are positional even if they look like Options. Unlike Populate(),
+        /// which checks every argument, this takes the remaining arguments
+        /// as they are, though a derived class may still refuse them, which
+        /// fails the parse.
+        /// 
+        /// @param args The arguments to populate the MultiPosParam.
+        /// @return True if population is successful, otherwise false.
+        /// @pre Size of arguments > 0.
+        /// @post The MultiPosParam is marked specified.
+        /// @post The argument queue, arguments, is emtpied.
+        /// @post Consumed arguments are added to the MultiPosParam values.
+        virtual bool PopulateOperands(std::deque<std::string>& args);
+
+        /// @brief Populates the MultiPosParam with a view of its arguments.
+        ///
+        /// Used by the Parser instead of Populate() or PopulateOperands()
+        /// when the MultiPosParam IsLazy() and its arguments are still next
+        /// to each other where the Parser stores them. Nothing is copied, so
+        /// this takes O(1) time and memory however many arguments there are.
+        ///
+        /// @param args The view of the arguments, which must stay valid as
+        /// long as the values are used.
+        /// @return True if population is successful, otherwise false.
+        /// @post The MultiPosParam is marked specified if args isn't empty.
+        /// @post The values are the arguments in args.
+        bool PopulateView(ArgView args);
+
         /// @brief Gets the number of arguments the MultiPosParam consumes.
         ///
         /// Each MultiPosParam consumes a certain number of arguments
@@ -209,11 +274,80 @@ namespace CmdLine
         /// each argument.
         /// 
         /// @return The values the MultiPosParam was populated with.
-        std::vector<std::string> Values() const 
-        { 
-            return mValues; 
+        std::vector<std::string> Values() const;
+
+        /// @brief Gets a view of the values without copying them.
+        ///
+        /// Refers to the same values as Values(), in the same order. When 
+        /// the MultiPosParam IsLazy(), they usually refer to the arguments 
+        /// the Parser was constructed with, so the view is only valid as 
+        /// long as the Parser is. For example:
+        ///
+        ///     for (std::string_view path : files.ValueView())
+        ///         Process(path);
+        ///
+        /// @return The view of the values.
+        ArgView ValueView() const
+        {
+            return mIsViewed ? mView : ArgView{ mValues };
+        }
+
+        /// @brief Splits the values into chunks for parallel processing.
+        ///
+        /// The chunks are views of ValueView(), so nothing is copied and they
+        /// are valid for as long as it is. For example:
+        ///
+        ///     WorkerPool pool;
+        ///     pool.ForEach(files.Partition(), 
+        ///         [](std::string_view path) { Process(path); });
+        ///
+        /// @param chunkSize The largest number of values in a chunk, or 0
+        /// for defaultChunksPerThread chunks per hardware thread.
+        /// @return The partition of the values.
+        ValuePartition Partition(std::size_t chunkSize = 0) const
+        {
+            return ValuePartition{ ValueView(), chunkSize };
         }
 
+        /// @brief Indicates whether the values refer to the arguments.
+        ///
+        /// A lazy MultiPosParam is populated with a view of the arguments 
+        /// the Parser was constructed with, so populating it takes O(1) 
+        /// time however many values there are, e.g. when a shell expands a 
+        /// glob to a million paths. Use ValueView() to read the values 
+        /// without copying them. The Parser can only do this when the 
+        /// ParsingOrder is End and no Option or end-of-options marker is 
+        /// among the values, otherwise the values are copied as usual.
+        ///
+        /// @return True if the MultiPosParam is lazy, otherwise false.
+        bool IsLazy() const
+        {
+            return mDefinition.isLazy;
+        }
+
+        /// @brief Visits each value, streaming standard input in place of
+        /// "-".
+        ///
+        /// Visits the values in order, like iterating Values(). Unless the 
+        /// StdinFormat is None, a "-" value is replaced by the records read
+        /// from standard input with a RecordReader. Each record is visited 
+        /// as soon as it has been read, so processing can start before the 
+        /// input ends and the records are never all held in memory at once.
+        /// Only the first "-" reads standard input. For example:
+        ///
+        ///     files.ForEachValue([](std::string_view path) 
+        ///     { 
+        ///         Process(path); 
+        ///     });
+        ///
+        /// @param f The function to call with each value, which is only 
+        /// valid for the duration of the call.
+        /// @param stdinFd The file descriptor to read in place of standard
+        /// input.
+        /// @return False if reading standard input failed, otherwise true.
+        bool ForEachValue(const std::function<void(std::string_view)>& f,
+            int stdinFd = 0) const;
+
         /// @brief Gets the ParsingOrder of the MultiPosParam. 
         ///
         /// The ParsingOrder determines whether a command line
@@ -230,7 +364,14 @@ namespace CmdLine
         Definition mDefinition;
         bool mIsSpecified;
         std::vector<std::string> mValues;
+        ArgView mView;
+        bool mIsViewed;
         ParsingOrder mOrder;
+
+        /// @brief Copies the values from the view, if any, into mValues.
+        ///
+        /// @post The values no longer refer to the arguments.
+        void CopyViewedValues();
     };
 }
 
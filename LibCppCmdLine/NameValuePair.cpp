@@ -22,7 +22,9 @@ namespace CmdLine
     {
         if (!IsNameValuePair(pair))
         {
-            throw InvalidPair{ nameError };
+            mConstructionError = Raise<InvalidPair>(ErrorCode::InvalidPair, 
+                nameError);
+            return;
         }
 
         if (pair.find('=') != std::string::npos)
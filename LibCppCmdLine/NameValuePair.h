@@ -21,6 +21,7 @@
 #include <stdexcept>
 #include <sstream>
 #include "Constants.h"
+#include "Error.h"
 #include "Validation.h"
 
 namespace CmdLine
@@ -60,6 +61,15 @@ namespace CmdLine
         /// @invariant The value will consist of everything after the = sign.
         NameValuePair(std::string pair);
 
+        /// @brief Gets the error that occurred constructing the pair.
+        ///
+        /// Only a library built without exceptions records an error here; 
+        /// otherwise the constructor throws it instead (see Error).
+        ///
+        /// @return The error, whose code is ErrorCode::None if the pair was
+        /// valid.
+        const Error& ConstructionError() const { return mConstructionError; }
+
         /// @brief Gets the name from the NameValuePair.
         ///
         /// @return The name from the NameValuePair.
@@ -72,6 +82,7 @@ namespace CmdLine
     private:
         std::string mName;
         std::string mValue;
+        Error mConstructionError;
     };
 
     /// @brief Determines if the specified string represents a NameValuePair.
@@ -22,19 +22,30 @@ namespace CmdLine
         : mIsSpecified{ false }, mDefinition{ d }
     {
         if (mDefinition.shortName == 0 && mDefinition.longName == "")
-            throw InvalidDefinition(optionEmptyNameError);
+        {
+            mConstructionError = Raise<InvalidDefinition>(
+                ErrorCode::InvalidDefinition, optionEmptyNameError);
+            return;
+        }
 
         if (mDefinition.shortName != 0)
         {
             bool isAlphaNumeric = std::isalnum(mDefinition.shortName);
             if (!isAlphaNumeric && mDefinition.shortName != '?')
-                throw InvalidDefinition(optionShortNameError);
+            {
+                mConstructionError = Raise<InvalidDefinition>(
+                    ErrorCode::InvalidDefinition, optionShortNameError);
+                return;
+            }
         }
         
         if (mDefinition.longName != "")
         {
             if (!IsValidNonOptionName(mDefinition.longName))
-                throw InvalidDefinition(optionLongNameError);
+            {
+                mConstructionError = Raise<InvalidDefinition>(
+                    ErrorCode::InvalidDefinition, optionLongNameError);
+            }
         }
     }
 
@@ -76,15 +87,16 @@ namespace CmdLine
     bool Option::CanPopulate(const std::deque<std::string>& args) const
     {
         if (args.size() > 0)
-        {
-            std::string a = args.front();
-            if (a == PrefixShortName() || a == PrefixLongName())
-                return true;
-        }
+            return Matches(args.front());
         
         return false;
     }
 
+    bool Option::Matches(std::string_view arg) const
+    {
+        return MatchesOption(arg, mDefinition);
+    }
+
     std::string Option::PrefixShortName() const
     {
         // PrependPrefix works with strings so convert the char to a string.
@@ -118,7 +130,32 @@ namespace CmdLine
         return prefixedName.str();
     }
 
-    bool StartsWithOptionPrefix(std::string arg)
+    bool MatchesOption(std::string_view arg, const Option::Definition& d)
+    {
+        const bool windows = d.style == Option::Style::Windows;
+        std::string_view shortPrefix = windows ? windowsOptionShortPrefix 
+            : unixOptionShortPrefix;
+        std::string_view longPrefix = windows ? windowsOptionLongPrefix 
+            : unixOptionLongPrefix;
+
+        if (d.shortName != 0 && arg.size() == shortPrefix.size() + 1 &&
+            arg.back() == d.shortName &&
+            arg.compare(0, shortPrefix.size(), shortPrefix) == 0)
+        {
+            return true;
+        }
+
+        // An Option without a long name can't be specified by one, not even
+        // by an empty argument.
+        if (d.longName.empty())
+            return false;
+
+        return arg.size() == longPrefix.size() + d.longName.size() &&
+            arg.compare(0, longPrefix.size(), longPrefix) == 0 &&
+            arg.substr(longPrefix.size()) == d.longName;
+    }
+
+    bool StartsWithOptionPrefix(std::string_view arg)
     {
         bool s = arg.rfind(unixOptionShortPrefix, 0) == 0;
         s = s || arg.rfind(unixOptionLongPrefix, 0) == 0;
@@ -126,7 +163,7 @@ namespace CmdLine
         return s || arg.rfind(windowsOptionLongPrefix, 0) == 0;
     }
 
-    bool IsOption(std::string arg)
+    bool IsOption(std::string_view arg)
     {
         if (!StartsWithOptionPrefix(arg))
             return false;
@@ -134,7 +171,7 @@ namespace CmdLine
         if (arg.length() <= 1)
             return false;
 
-        std::string argWithoutPrefix = arg.substr(1);
+        std::string_view argWithoutPrefix = arg.substr(1);
 
         // Account for the Unix long option where 2 chars need to be removed
         if (StartsWithOptionPrefix(argWithoutPrefix))
@@ -18,6 +18,7 @@
 #define CMD_LINE_OPTION_H
 
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <iomanip>
 #include <stdexcept>
@@ -98,6 +99,11 @@ namespace CmdLine
             ///
             /// @sa Option::Style.
             Style style = Style::Unix;
+
+            /// @brief Determines whether the Option short-circuits parsing.
+            ///
+            /// @sa Option::IsShortCircuit().
+            bool isShortCircuit = false;
         };
 
         /// @brief Constructs a new Option.
@@ -172,6 +178,19 @@ namespace CmdLine
             return mDefinition.isMandatory; 
         }
 
+        /// @brief Indicates whether the Option short-circuits parsing.
+        ///
+        /// As soon as the Parser finds a short-circuit Option among the
+        /// arguments it stops, populating only that Option and the 
+        /// ProgParam. The rest of the arguments are ignored, even ones that 
+        /// would otherwise make parsing fail, which suits Options such as
+        /// help or version that make a program ignore everything else. The
+        /// Parser's built-in help option short-circuits.
+        ///
+        /// @return True if the Option short-circuits parsing, otherwise 
+        /// false.
+        bool IsShortCircuit() const { return mDefinition.isShortCircuit; }
+
         /// @brief Populates this Option from an argument queue.
         ///
         /// Accepts a reference to an argument queue (deque) and attempts to 
@@ -197,6 +216,16 @@ namespace CmdLine
         /// @return True if the arguments can populate, otherwise false.
         bool CanPopulate(const std::deque<std::string>& args) const override;
 
+        /// @brief Determines if an argument specifies this Option.
+        ///
+        /// An argument specifies the Option if it is the Option's prefixed
+        /// short or long name. Unlike CanPopulate(), the argument does not
+        /// need to be at the front of an argument queue.
+        /// 
+        /// @param arg The argument to evaluate.
+        /// @return True if the argument specifies the Option, otherwise false.
+        bool Matches(std::string_view arg) const;
+
         /// @brief Gets the number of arguments the Option consumes.
         ///
         /// An Option should consume exactly 1 argument.
@@ -264,6 +293,27 @@ namespace CmdLine
         std::string PrependPrefix(std::string prefix, std::string name) const;
     };
 
+    /// @brief Determines if an argument specifies an Option.
+    ///
+    /// An argument specifies the Option the Option::Definition defines if it
+    /// is the Option's prefixed short or long name. The argument is compared
+    /// against the prefix and name in place, without building the prefixed
+    /// names, so nothing is allocated.
+    /// 
+    /// @param arg The argument to evaluate.
+    /// @param d The definition of the Option.
+    /// @return True if the argument specifies the Option, otherwise false.
+    bool MatchesOption(std::string_view arg, const Option::Definition& d);
+
+    /// @brief Determines if the specified argument starts with an Option prefix.
+    ///
+    /// Checks the argument against both the Unix and Windows Option prefixes
+    /// without checking whether the rest of the argument is a valid name.
+    /// 
+    /// @param arg The argument to evaluate.
+    /// @return True if the argument starts with an Option prefix.
+    bool StartsWithOptionPrefix(std::string_view arg);
+
     /// @brief Determines if the specified argument represents an Option.
     ///
     /// A command line argument represents an Option if it begins with a valid
@@ -271,7 +321,7 @@ namespace CmdLine
     /// 
     /// @param arg The argument to evaluate.
     /// @return True if the argument represents an Option, otherwise false.
-    bool IsOption(std::string arg);
+    bool IsOption(std::string_view arg);
 }
 
 #endif
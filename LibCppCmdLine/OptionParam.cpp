@@ -22,7 +22,10 @@ namespace CmdLine
         : mDefinition{ definition }, mIsSpecified{ false }
     {
         if (!IsValidNonOptionName(mDefinition.name))
-            throw InvalidDefinition(nameError);
+        {
+            mConstructionError = Raise<InvalidDefinition>(
+                ErrorCode::InvalidDefinition, nameError);
+        }
     }
 
     std::string OptionParam::HelpInfo() const
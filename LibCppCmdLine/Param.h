@@ -20,6 +20,7 @@
 #include <string>
 #include <deque>
 #include <stdexcept>
+#include "Error.h"
 
 namespace CmdLine
 {
@@ -121,6 +122,18 @@ namespace CmdLine
         /// 
         /// @return True if the Param is mandatory, otherwise false.
         virtual bool IsMandatory() const = 0;
+
+        /// @brief Gets the error that occurred constructing the Param.
+        ///
+        /// Only a library built without exceptions records an error here; 
+        /// otherwise the constructor throws it instead (see Error).
+        ///
+        /// @return The error, whose code is ErrorCode::None if the 
+        /// Param::Definition was valid.
+        const Error& ConstructionError() const { return mConstructionError; }
+    protected:
+        /// @brief The error that occurred constructing the Param, if any.
+        Error mConstructionError;
     };
 }
 
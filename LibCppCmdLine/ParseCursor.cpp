@@ -0,0 +1,153 @@
+// ParseCursor.cpp - Defines the ParseCursor class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#include "ParseCursor.h"
+#include "ValueOption.h"
+
+namespace CmdLine
+{
+    bool ParseCursor::Next(ParsedItem& item)
+    {
+        if (mIsDone)
+            return false;
+
+        // The program name is skipped.
+        std::string_view arg;
+        if (mArgIndex == 0 && !mSource.Next(arg))
+        {
+            mIsDone = true;
+            return false;
+        }
+
+        // The value of the ValueOption parsed last.
+        if (mPendingValue != nullptr)
+        {
+            const Option* option = mPendingValue;
+            mPendingValue = nullptr;
+            if (!mSource.Next(arg))
+            {
+                return Fail(ParseError::Kind::MissingOptionValue, mArgIndex,
+                    option);
+            }
+
+            mIsDone = option->IsShortCircuit();
+            item = ParsedItem{ ParsedItem::Kind::Value, option, arg, 
+                ++mArgIndex };
+            return true;
+        }
+
+        while (mSource.Next(arg))
+        {
+            mArgIndex++;
+
+            if (!mAfterEndOfOptions && arg == endOfOptionsMarker)
+            {
+                mAfterEndOfOptions = true;
+                continue;
+            }
+
+            const Option* option = nullptr;
+            if (!mAfterEndOfOptions)
+            {
+                for (auto* o : mOptions)
+                {
+                    if (o->Matches(arg))
+                    {
+                        option = o;
+                        break;
+                    }
+                }
+            }
+
+            if (option == nullptr)
+            {
+                if (!mAfterEndOfOptions && IsOption(arg))
+                {
+                    // A short-circuit Option further on still takes effect.
+                    std::size_t unknownIndex = mArgIndex;
+                    if (FindShortCircuit(item))
+                        return true;
+
+                    return Fail(ParseError::Kind::UnknownOption, 
+                        unknownIndex);
+                }
+
+                item = ParsedItem{ ParsedItem::Kind::Positional, nullptr, 
+                    arg, mArgIndex };
+                return true;
+            }
+
+            // Asking the Option how many arguments it consumes would need 
+            // them in a queue, but only a ValueOption takes any more.
+            if (dynamic_cast<const ValueOption*>(option) != nullptr)
+                mPendingValue = option;
+
+            // Nothing after a short-circuit Option is parsed, except its
+            // own value.
+            if (option->IsShortCircuit() && mPendingValue == nullptr)
+                mIsDone = true;
+
+            item = ParsedItem{ ParsedItem::Kind::Option, option, arg, 
+                mArgIndex };
+            return true;
+        }
+
+        mIsDone = true;
+        return false;
+    }
+
+    bool ParseCursor::FindShortCircuit(ParsedItem& item)
+    {
+        std::string_view arg;
+        while (mSource.Next(arg))
+        {
+            mArgIndex++;
+            if (arg == endOfOptionsMarker)
+                return false;
+
+            if (!IsOption(arg))
+                continue;
+
+            for (auto* o : mOptions)
+            {
+                if (!o->IsShortCircuit() || !o->Matches(arg))
+                    continue;
+
+                if (dynamic_cast<const ValueOption*>(o) != nullptr)
+                    mPendingValue = o;
+                else
+                    mIsDone = true;
+
+                item = ParsedItem{ ParsedItem::Kind::Option, o, arg, 
+                    mArgIndex };
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool ParseCursor::Fail(ParseError::Kind k, std::size_t argIndex, 
+        const ArgParam* expected)
+    {
+        mLastError.kind = k;
+        mLastError.argIndex = argIndex;
+        mLastError.expected = expected;
+        mIsDone = true;
+        return false;
+    }
+}
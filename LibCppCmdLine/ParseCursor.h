@@ -0,0 +1,143 @@
+// ParseCursor.h - Declares the ParseCursor class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_PARSE_CURSOR_H
+#define CMD_LINE_PARSE_CURSOR_H
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+#include "ArgSource.h"
+#include "Option.h"
+#include "ParseError.h"
+
+namespace CmdLine
+{
+    /// @brief An argument parsed by a ParseCursor.
+    struct ParsedItem
+    {
+        /// @brief The kinds of item.
+        enum class Kind
+        {
+            /// @brief The argument specifies an Option.
+            Option,
+
+            /// @brief The argument is the value of a ValueOption.
+            Value,
+
+            /// @brief The argument is positional.
+            Positional
+        };
+
+        /// @brief The kind of item.
+        Kind kind{ Kind::Positional };
+
+        /// @brief The Option specified, or the ValueOption the value is 
+        /// for; null for a positional argument.
+        const Option* option{ nullptr };
+
+        /// @brief The argument, which is only valid until the next item is
+        /// parsed.
+        std::string_view arg;
+
+        /// @brief Where the argument is on the command line.
+        std::size_t argIndex{ 0 };
+    };
+
+    /// @brief Parses arguments one item at a time as they are read.
+    ///
+    /// A ParseCursor is the engine behind Parser::Parse() with a 
+    /// ParseHandler, but lets the caller pull each ParsedItem when it's 
+    /// ready for it instead of being called back, e.g. to interleave 
+    /// parsing with its own work. It's usually created with 
+    /// Parser::Cursor(). For example:
+    ///
+    ///     ParseCursor cursor = parser.Cursor(source);
+    ///     ParsedItem item;
+    ///     while (cursor.Next(item))
+    ///         Process(item);
+    ///
+    ///     if (cursor.LastError().kind != ParseError::Kind::None)
+    ///         return 1;
+    ///
+    /// The first argument is the program name, which is skipped. Options 
+    /// are matched in the order they are specified, wherever they are, and
+    /// arguments after the end-of-options marker are always positional.
+    /// Parsing stops after a short-circuit Option. As with Parse(), an 
+    /// invalid argument doesn't stop a short-circuit Option after it from
+    /// taking effect: the arguments up to the end-of-options marker are 
+    /// read until one is found, which is the next item instead of an error.
+    /// Unlike Parse(), the items before the invalid argument have already
+    /// been pulled by then. Nothing is stored and no Param is populated, so
+    /// parsing takes constant memory.
+    class ParseCursor
+    {
+    public:
+        /// @brief Constructs a new ParseCursor.
+        ///
+        /// @param options The Options to match, which must outlive the 
+        /// cursor.
+        /// @param source The source of the arguments, including the program
+        /// name.
+        ParseCursor(const std::vector<Option*>& options, ArgSource& source)
+            : mOptions{ options }, mSource{ source }, mArgIndex{ 0 }, 
+            mAfterEndOfOptions{ false }, mIsDone{ false }
+        { }
+
+        /// @brief Parses the next item.
+        ///
+        /// @param item Set to the item parsed.
+        /// @return True if an item was parsed, false once the arguments run
+        /// out, after a short-circuit Option or if an argument is invalid.
+        /// @post LastError() describes the invalid argument, if any.
+        bool Next(ParsedItem& item);
+
+        /// @brief Gets the error that stopped parsing.
+        ///
+        /// @return The error, whose kind is ParseError::Kind::None unless an
+        /// invalid argument was found.
+        const ParseError& LastError() const { return mLastError; }
+    private:
+        const std::vector<Option*>& mOptions;
+        ArgSource& mSource;
+        std::size_t mArgIndex;
+        bool mAfterEndOfOptions;
+        bool mIsDone;
+        const Option* mPendingValue{ nullptr };
+        ParseError mLastError;
+
+        /// @brief Looks for a short-circuit Option after an invalid 
+        /// argument.
+        ///
+        /// Reads the arguments left up to the end-of-options marker.
+        ///
+        /// @param item Set to the short-circuit Option, if one is found.
+        /// @return True if a short-circuit Option was found, otherwise false.
+        bool FindShortCircuit(ParsedItem& item);
+
+        /// @brief Stops parsing because of an invalid argument.
+        ///
+        /// @param k The kind of error.
+        /// @param argIndex The position of the argument on the command line.
+        /// @param expected The ArgParam expected to populate, if any.
+        /// @return False, so the caller can return the result.
+        bool Fail(ParseError::Kind k, std::size_t argIndex, 
+            const ArgParam* expected = nullptr);
+    };
+}
+
+#endif
@@ -0,0 +1,41 @@
+// ParseError.cpp - Defines the ParseError functions.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include "ParseError.h"
+
+namespace CmdLine
+{
+    const char* ParseErrorKindName(ParseError::Kind k)
+    {
+        switch (k)
+        {
+            case ParseError::Kind::None:
+                return "None";
+            case ParseError::Kind::UnknownOption:
+                return "UnknownOption";
+            case ParseError::Kind::MissingOptionValue:
+                return "MissingOptionValue";
+            case ParseError::Kind::UnexpectedArgument:
+                return "UnexpectedArgument";
+            case ParseError::Kind::PopulateFailed:
+                return "PopulateFailed";
+            case ParseError::Kind::NoProgress:
+                return "NoProgress";
+        }
+
+        return "";
+    }
+}
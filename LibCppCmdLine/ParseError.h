@@ -0,0 +1,87 @@
+// ParseError.h - Declares the ParseError struct.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_PARSE_ERROR_H
+#define CMD_LINE_PARSE_ERROR_H
+
+#include <cstddef>
+#include "ArgParam.h"
+
+namespace CmdLine
+{
+    /// @brief Describes why Parser::Parse() failed.
+    ///
+    /// Parsing fails on the first argument that can't be parsed, so a
+    /// ParseError identifies that argument by its index in the arguments
+    /// the Parser was constructed with, along with the ArgParam that was
+    /// expected to populate from it, if there was one. A ParseError is
+    /// filled in as a side effect of the checks parsing makes anyway, so
+    /// reporting one costs no more than the failure itself. For example:
+    ///
+    ///     if (parser.Parse() == Parser::Status::Failure)
+    ///     {
+    ///         const ParseError& e = parser.LastError();
+    ///         std::cerr << ParseErrorKindName(e.kind) << ": " 
+    ///             << args[e.argIndex] << std::endl;
+    ///     }
+    struct ParseError
+    {
+        /// @brief The kinds of parse failure.
+        enum class Kind
+        {
+            /// @brief Parsing hasn't failed.
+            None,
+
+            /// @brief An option argument doesn't match any Option.
+            UnknownOption,
+
+            /// @brief An Option doesn't have enough arguments left to 
+            /// consume, e.g. a ValueOption given as the last argument.
+            MissingOptionValue,
+
+            /// @brief No ArgParam can populate from an argument, e.g. there
+            /// are more positional arguments than positional parameters.
+            UnexpectedArgument,
+
+            /// @brief The ArgParam that could populate from an argument 
+            /// failed to.
+            PopulateFailed,
+
+            /// @brief An ArgParam populated from an argument without 
+            /// consuming it, which would have made parsing loop forever.
+            NoProgress
+        };
+
+        /// @brief The kind of failure.
+        Kind kind{ Kind::None };
+
+        /// @brief The index of the offending argument, 0 being the program
+        /// name.
+        std::size_t argIndex{ 0 };
+
+        /// @brief The ArgParam expected to populate from the argument, or
+        /// nullptr if there wasn't one.
+        const ArgParam* expected{ nullptr };
+    };
+
+    /// @brief Gets the name of a ParseError::Kind.
+    ///
+    /// @param k The ParseError::Kind to get the name of.
+    /// @return The name of the kind, e.g. "UnknownOption".
+    const char* ParseErrorKindName(ParseError::Kind k);
+}
+
+#endif
@@ -0,0 +1,222 @@
+// ParseGenerator.h - Declares the ParseGenerator class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_PARSE_GENERATOR_H
+#define CMD_LINE_PARSE_GENERATOR_H
+
+#include "ArgSource.h"
+#include "ParseCursor.h"
+#include "ParseError.h"
+#include "Parser.h"
+
+// Coroutines need C++20, which the library itself doesn't, so everything 
+// here is header-only and only declared for code compiled with coroutine 
+// support.
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define CMD_LINE_PARSE_GENERATOR
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <utility>
+
+namespace CmdLine
+{
+    /// @brief A lazy sequence of the items parsed from an ArgSource.
+    ///
+    /// Returned by ParseItems(), which parses each item with a ParseCursor
+    /// only when the sequence is advanced, so a program can interleave 
+    /// parsing a huge number of arguments with its own work. Advancing
+    /// resumes the coroutine and copies nothing; the only allocation is 
+    /// the coroutine itself, once per parse. For example:
+    ///
+    ///     ParseGenerator items = ParseItems(parser, source);
+    ///     for (const ParsedItem& item : items)
+    ///         Process(item);
+    ///
+    ///     if (items.LastError().kind != ParseError::Kind::None)
+    ///         return 1;
+    ///
+    /// Only available when compiled as C++20 with coroutine support, in 
+    /// which case CMD_LINE_PARSE_GENERATOR is defined.
+    class ParseGenerator
+    {
+    public:
+        /// @brief The state of the coroutine.
+        struct promise_type
+        {
+            const ParsedItem* current{ nullptr };
+            ParseError error;
+            std::exception_ptr exception;
+
+            ParseGenerator get_return_object()
+            {
+                return ParseGenerator{ 
+                    std::coroutine_handle<promise_type>::from_promise(*this)
+                };
+            }
+
+            std::suspend_always initial_suspend() noexcept { return { }; }
+
+            std::suspend_always final_suspend() noexcept { return { }; }
+
+            std::suspend_always yield_value(const ParsedItem& item) noexcept
+            {
+                current = &item;
+                return { };
+            }
+
+            void return_value(const ParseError& e) noexcept { error = e; }
+
+            void unhandled_exception() 
+            { 
+                exception = std::current_exception(); 
+            }
+        };
+
+        /// @brief An iterator over the parsed items.
+        class Iterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = ParsedItem;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const ParsedItem*;
+            using reference = const ParsedItem&;
+
+            Iterator() = default;
+
+            reference operator*() const 
+            { 
+                return *mCoroutine.promise().current; 
+            }
+
+            pointer operator->() const { return mCoroutine.promise().current; }
+
+            Iterator& operator++()
+            {
+                Resume(mCoroutine);
+                return *this;
+            }
+
+            void operator++(int) { ++*this; }
+
+            bool operator==(std::default_sentinel_t) const
+            {
+                return !mCoroutine || mCoroutine.done();
+            }
+        private:
+            friend class ParseGenerator;
+
+            std::coroutine_handle<promise_type> mCoroutine;
+
+            explicit Iterator(std::coroutine_handle<promise_type> c)
+                : mCoroutine{ c }
+            { }
+        };
+
+        ParseGenerator(ParseGenerator&& other) noexcept
+            : mCoroutine{ std::exchange(other.mCoroutine, nullptr) }
+        { }
+
+        ParseGenerator& operator=(ParseGenerator&& other) noexcept
+        {
+            std::swap(mCoroutine, other.mCoroutine);
+            return *this;
+        }
+
+        ParseGenerator(const ParseGenerator&) = delete;
+        ParseGenerator& operator=(const ParseGenerator&) = delete;
+
+        /// @brief Destroys the coroutine, stopping parsing.
+        ~ParseGenerator()
+        {
+            if (mCoroutine)
+                mCoroutine.destroy();
+        }
+
+        /// @brief Parses the first item.
+        ///
+        /// May only be called once.
+        ///
+        /// @return An iterator to the first item.
+        Iterator begin()
+        {
+            Resume(mCoroutine);
+            return Iterator{ mCoroutine };
+        }
+
+        /// @brief Gets the end of the sequence.
+        ///
+        /// @return A sentinel equal to an iterator past the last item.
+        std::default_sentinel_t end() const { return { }; }
+
+        /// @brief Gets the error that stopped parsing.
+        ///
+        /// @return The error, whose kind is ParseError::Kind::None unless 
+        /// the sequence ended at an invalid argument.
+        const ParseError& LastError() const 
+        { 
+            return mCoroutine.promise().error; 
+        }
+    private:
+        std::coroutine_handle<promise_type> mCoroutine;
+
+        explicit ParseGenerator(std::coroutine_handle<promise_type> c)
+            : mCoroutine{ c }
+        { }
+
+        /// @brief Parses the next item.
+        ///
+        /// @param c The coroutine to resume.
+        /// @exception Rethrows anything the ArgSource threw.
+        static void Resume(std::coroutine_handle<promise_type> c)
+        {
+            if (!c || c.done())
+                return;
+
+            c.resume();
+            if (c.promise().exception)
+                std::rethrow_exception(c.promise().exception);
+        }
+    };
+
+    /// @brief Parses the items in an ArgSource as a lazy sequence.
+    ///
+    /// Parses the same way as Parser::Parse() with a ParseHandler, using 
+    /// the Parser's Options. The Parser and the source must outlive the 
+    /// sequence.
+    ///
+    /// @param parser The Parser whose Options to match.
+    /// @param source The source of the arguments, including the program
+    /// name.
+    /// @return The sequence of items, parsed as it is advanced.
+    inline ParseGenerator ParseItems(const Parser& parser, ArgSource& source)
+    {
+        ParseCursor cursor = parser.Cursor(source);
+        ParsedItem item;
+        while (cursor.Next(item))
+            co_yield item;
+
+        co_return cursor.LastError();
+    }
+}
+
+#endif
+
+#endif
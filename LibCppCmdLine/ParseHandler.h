@@ -0,0 +1,81 @@
+// ParseHandler.h - Declares the ParseHandler class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_PARSE_HANDLER_H
+#define CMD_LINE_PARSE_HANDLER_H
+
+#include <cstddef>
+#include <string_view>
+#include "Option.h"
+
+namespace CmdLine
+{
+    /// @brief Handles the events of a streaming parse (base class).
+    ///
+    /// Parsing an ArgSource with a ParseHandler (see Parser::Parse()) calls
+    /// the handler as each argument is read instead of populating any 
+    /// Param, so a program that only needs to react to each argument once,
+    /// e.g. to process millions of paths from a pipe, can start straight
+    /// away and nothing is stored. Every callback does nothing by default, 
+    /// so an implementation only overrides the ones it needs. Returning 
+    /// false from a callback stops parsing.
+    class ParseHandler
+    {
+    public:
+        /// @brief Destructs a ParseHandler.
+        virtual ~ParseHandler() = default;
+
+        /// @brief Called when an argument specifies an Option.
+        ///
+        /// For a ValueOption, ValueSeen() is called next with its value.
+        ///
+        /// @param o The Option specified.
+        /// @param argIndex Where the argument is on the command line.
+        /// @return True to keep parsing, false to stop.
+        virtual bool OptionSeen([[maybe_unused]] const Option& o,
+            [[maybe_unused]] std::size_t argIndex)
+        {
+            return true;
+        }
+
+        /// @brief Called with the value of a ValueOption.
+        ///
+        /// @param o The ValueOption the value is for.
+        /// @param value The value, which is only valid during the call.
+        /// @param argIndex Where the value is on the command line.
+        /// @return True to keep parsing, false to stop.
+        virtual bool ValueSeen([[maybe_unused]] const Option& o,
+            [[maybe_unused]] std::string_view value,
+            [[maybe_unused]] std::size_t argIndex)
+        {
+            return true;
+        }
+
+        /// @brief Called when an argument is positional.
+        ///
+        /// @param arg The argument, which is only valid during the call.
+        /// @param argIndex Where the argument is on the command line.
+        /// @return True to keep parsing, false to stop.
+        virtual bool PositionalSeen([[maybe_unused]] std::string_view arg,
+            [[maybe_unused]] std::size_t argIndex)
+        {
+            return true;
+        }
+    };
+}
+
+#endif
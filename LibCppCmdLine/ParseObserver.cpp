@@ -0,0 +1,35 @@
+// ParseObserver.cpp - Defines the ParseObserver functions.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include "ParseObserver.h"
+
+namespace CmdLine
+{
+    const char* ParsePhaseName(ParsePhase p)
+    {
+        switch (p)
+        {
+            case ParsePhase::FillArgQueue:
+                return "FillArgQueue";
+            case ParsePhase::FillArgParamVector:
+                return "FillArgParamVector";
+            case ParsePhase::PopulateArgParams:
+                return "PopulateArgParams";
+        }
+
+        return "";
+    }
+}
@@ -0,0 +1,87 @@
+// ParseObserver.h - Declares the ParseObserver class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_PARSE_OBSERVER_H
+#define CMD_LINE_PARSE_OBSERVER_H
+
+#include "ArgParam.h"
+
+namespace CmdLine
+{
+    /// @brief The phases of Parser::Parse(), in the order they run.
+    enum class ParsePhase
+    {
+        /// @brief Orders the arguments for parsing (Options first).
+        FillArgQueue,
+
+        /// @brief Combines every ArgParam into the order they're tried in.
+        FillArgParamVector,
+
+        /// @brief Populates an ArgParam from each argument in turn.
+        PopulateArgParams
+    };
+
+    /// @brief Gets the name of a ParsePhase.
+    ///
+    /// @param p The ParsePhase to get the name of.
+    /// @return The name of the phase, e.g. "FillArgQueue".
+    const char* ParsePhaseName(ParsePhase p);
+
+    /// @brief Observes the progress of a Parser (base class).
+    ///
+    /// A ParseObserver set on a Parser (see Parser::Set()) is notified as
+    /// each ParsePhase starts and finishes and around each call to 
+    /// ArgParam::Populate(), which is enough to attribute the time a parse
+    /// takes to the phase or ArgParam that spent it (see ParseProfiler).
+    /// Every callback does nothing by default, so an implementation only
+    /// overrides the ones it needs. A Parser without an observer only pays
+    /// for a null pointer check at each callback site, and none at all when
+    /// the library is built with CMD_LINE_NO_PARSE_OBSERVERS defined.
+    class ParseObserver
+    {
+    public:
+        /// @brief Destructs a ParseObserver.
+        virtual ~ParseObserver() = default;
+
+        /// @brief Called before a ParsePhase starts.
+        ///
+        /// @param p The ParsePhase that is starting.
+        virtual void PhaseStarted([[maybe_unused]] ParsePhase p) { }
+
+        /// @brief Called after a ParsePhase finishes.
+        ///
+        /// Also called when the phase fails, which ends the parse.
+        ///
+        /// @param p The ParsePhase that finished.
+        virtual void PhaseFinished([[maybe_unused]] ParsePhase p) { }
+
+        /// @brief Called before an ArgParam is populated.
+        ///
+        /// @param p The ArgParam about to be populated.
+        virtual void PopulateStarted([[maybe_unused]] const ArgParam& p)
+        { }
+
+        /// @brief Called after an ArgParam is populated.
+        ///
+        /// @param p The ArgParam that was populated.
+        /// @param populated The result of ArgParam::Populate().
+        virtual void PopulateFinished([[maybe_unused]] const ArgParam& p,
+            [[maybe_unused]] bool populated)
+        { }
+    };
+}
+
+#endif
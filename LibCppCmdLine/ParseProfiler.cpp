@@ -0,0 +1,132 @@
+// ParseProfiler.cpp - Defines the ParseProfiler class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include <cstdio>
+#include "JsonString.h"
+#include "ParseProfiler.h"
+
+namespace
+{
+    // Trace event timestamps and durations are in microseconds.
+    std::string Microseconds(std::chrono::steady_clock::duration d)
+    {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.3f",
+            std::chrono::duration<double, std::micro>(d).count());
+        return text;
+    }
+}
+
+namespace CmdLine
+{
+    ParseProfiler::ParseProfiler()
+    {
+        Reset();
+    }
+
+    void ParseProfiler::PhaseStarted(ParsePhase p)
+    {
+        mPhaseStarts[static_cast<std::size_t>(p)] = Clock::now();
+    }
+
+    void ParseProfiler::PhaseFinished(ParsePhase p)
+    {
+        const Clock::time_point end = Clock::now();
+        const std::size_t i = static_cast<std::size_t>(p);
+
+        mPhaseDurations[i] += std::chrono::duration_cast<
+            std::chrono::nanoseconds>(end - mPhaseStarts[i]);
+        mEvents.push_back(Event{ true, i, true, mPhaseStarts[i], end });
+    }
+
+    void ParseProfiler::PopulateStarted(const ArgParam& p)
+    {
+        // Looking the ArgParam up by address avoids building its name on
+        // every populate call; the name is only needed the first time.
+        auto found = mParamIndexes.find(&p);
+        if (found == mParamIndexes.end())
+        {
+            found = mParamIndexes.emplace(&p, mParams.size()).first;
+            mParams.push_back(ParamProfile{ p.Name() });
+        }
+
+        mPopulatingIndex = found->second;
+        mPopulateStart = Clock::now();
+    }
+
+    void ParseProfiler::PopulateFinished(const ArgParam&, bool populated)
+    {
+        const Clock::time_point end = Clock::now();
+
+        ParamProfile& profile = mParams[mPopulatingIndex];
+        profile.populateCount++;
+        profile.populateTime += std::chrono::duration_cast<
+            std::chrono::nanoseconds>(end - mPopulateStart);
+        mEvents.push_back(Event{ false, mPopulatingIndex, populated, 
+            mPopulateStart, end });
+    }
+
+    std::string ParseProfiler::ToChromeTrace() const
+    {
+        std::string trace{ "{\"traceEvents\":[" };
+
+        for (std::size_t i = 0; i < mEvents.size(); i++)
+        {
+            const Event& e = mEvents[i];
+
+            trace += i == 0 ? "\n" : ",\n";
+            trace += "{\"name\":";
+            if (e.isPhase)
+            {
+                AppendJsonString(trace, 
+                    ParsePhaseName(static_cast<ParsePhase>(e.index)));
+                trace += ",\"cat\":\"phase\"";
+            }
+            else
+            {
+                AppendJsonString(trace, mParams[e.index].name);
+                trace += ",\"cat\":\"populate\"";
+            }
+
+            trace += ",\"ph\":\"X\",\"ts\":" + Microseconds(e.start - mOrigin);
+            trace += ",\"dur\":" + Microseconds(e.end - e.start);
+            trace += ",\"pid\":1,\"tid\":1";
+
+            if (!e.isPhase)
+            {
+                trace += ",\"args\":{\"populated\":";
+                trace += e.populated ? "true}" : "false}";
+            }
+
+            trace += '}';
+        }
+
+        trace += "\n],\"displayTimeUnit\":\"ns\"}\n";
+        return trace;
+    }
+
+    void ParseProfiler::Reset()
+    {
+        mOrigin = Clock::now();
+        mPhaseStarts.fill(mOrigin);
+        mPhaseDurations.fill(std::chrono::nanoseconds{ 0 });
+        mParams.clear();
+        mParamIndexes.clear();
+        mPopulatingIndex = 0;
+        mPopulateStart = mOrigin;
+        mEvents.clear();
+    }
+}
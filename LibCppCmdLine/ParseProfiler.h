@@ -0,0 +1,133 @@
+// ParseProfiler.h - Declares the ParseProfiler class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_PARSE_PROFILER_H
+#define CMD_LINE_PARSE_PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ParseObserver.h"
+
+namespace CmdLine
+{
+    /// @brief The number of ParsePhase values.
+    constexpr std::size_t parsePhaseCount = 3;
+
+    /// @brief Profiles where the time spent parsing goes.
+    ///
+    /// A ParseObserver that records how long each ParsePhase takes, how many
+    /// times each ArgParam is populated and how long populating it takes.
+    /// Every phase and populate call is also recorded as an event, and the
+    /// events can be exported as Chrome trace-event JSON to be inspected in
+    /// chrome://tracing or Perfetto. Recording an event per populate call
+    /// means memory grows with the number of arguments parsed, so a profiler
+    /// is meant for diagnosing slow parses rather than being left attached.
+    /// Results accumulate across parses until Reset() is called. For example:
+    ///
+    ///     ParseProfiler profiler;
+    ///     parser.Set(&profiler);
+    ///     parser.Parse();
+    ///     std::ofstream{ "parse.json" } << profiler.ToChromeTrace();
+    class ParseProfiler : public ParseObserver
+    {
+    public:
+        /// @brief The populate statistics of one ArgParam.
+        struct ParamProfile
+        {
+            /// @brief The name of the ArgParam.
+            std::string name;
+
+            /// @brief The number of times the ArgParam was populated.
+            std::size_t populateCount{ 0 };
+
+            /// @brief The total time spent populating the ArgParam.
+            std::chrono::nanoseconds populateTime{ 0 };
+        };
+
+        /// @brief Constructs a new ParseProfiler with nothing recorded.
+        ParseProfiler();
+
+        void PhaseStarted(ParsePhase p) override;
+
+        void PhaseFinished(ParsePhase p) override;
+
+        void PopulateStarted(const ArgParam& p) override;
+
+        void PopulateFinished(const ArgParam& p, bool populated) override;
+
+        /// @brief Gets the total time spent in a ParsePhase.
+        ///
+        /// @param p The ParsePhase.
+        /// @return The total time spent in the phase.
+        std::chrono::nanoseconds PhaseDuration(ParsePhase p) const
+        {
+            return mPhaseDurations[static_cast<std::size_t>(p)];
+        }
+
+        /// @brief Gets the populate statistics of each ArgParam.
+        ///
+        /// Only ArgParams that were populated at least once are included.
+        ///
+        /// @return The statistics, in the order each ArgParam was first
+        /// populated.
+        const std::vector<ParamProfile>& Params() const { return mParams; }
+
+        /// @brief Exports the recorded events as Chrome trace-event JSON.
+        ///
+        /// Each ParsePhase and each populate call is a complete ("X") event
+        /// with its start time relative to when recording started, so the
+        /// populate calls nest inside the PopulateArgParams phase.
+        ///
+        /// @return The JSON text.
+        std::string ToChromeTrace() const;
+
+        /// @brief Discards everything recorded so far.
+        void Reset();
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        /// @brief A recorded phase or populate call.
+        struct Event
+        {
+            /// @brief Whether the event is a phase or a populate call.
+            bool isPhase;
+
+            /// @brief The ParsePhase, or the index of the ParamProfile.
+            std::size_t index;
+
+            /// @brief The result of a populate call.
+            bool populated;
+
+            Clock::time_point start;
+            Clock::time_point end;
+        };
+
+        Clock::time_point mOrigin;
+        std::array<Clock::time_point, parsePhaseCount> mPhaseStarts;
+        std::array<std::chrono::nanoseconds, parsePhaseCount> mPhaseDurations;
+        std::vector<ParamProfile> mParams;
+        std::unordered_map<const ArgParam*, std::size_t> mParamIndexes;
+        std::size_t mPopulatingIndex;
+        Clock::time_point mPopulateStart;
+        std::vector<Event> mEvents;
+    };
+}
+
+#endif
@@ -0,0 +1,295 @@
+// ParseSnapshot.cpp - Defines the ParseSnapshot and SnapshotWriter classes.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#include "ParseSnapshot.h"
+
+#include <cstring>
+#include "MultiPosParam.h"
+#include "PosParam.h"
+#include "ProgParam.h"
+#include "ValueOption.h"
+
+namespace
+{
+    // The sizes of the parts of a snapshot, in bytes.
+    constexpr std::size_t headerSize = 6 * sizeof(std::uint32_t);
+    constexpr std::size_t paramEntrySize = 4 * sizeof(std::uint32_t);
+    constexpr std::size_t valueEntrySize = 2 * sizeof(std::uint32_t);
+
+    /// @brief Gets the size of the bitset of specified ArgParams.
+    ///
+    /// @param paramCount The number of ArgParams.
+    /// @return The size in bytes, a whole number of 64-bit words.
+    std::size_t FlagsSize(std::size_t paramCount)
+    {
+        return (paramCount + 63) / 64 * sizeof(std::uint64_t);
+    }
+
+    /// @brief Writes a 32-bit field, which needn't be aligned.
+    ///
+    /// @param out Where to write the field.
+    /// @param value The value of the field.
+    /// @return Where the next field goes.
+    unsigned char* Put(unsigned char* out, std::size_t value)
+    {
+        std::uint32_t field = static_cast<std::uint32_t>(value);
+        std::memcpy(out, &field, sizeof(field));
+        return out + sizeof(field);
+    }
+
+    /// @brief Reads a 32-bit field, which needn't be aligned.
+    ///
+    /// @param in The field.
+    /// @param index The index of the field from in.
+    /// @return The value of the field.
+    std::size_t Get(const unsigned char* in, std::size_t index = 0)
+    {
+        std::uint32_t field;
+        std::memcpy(&field, in + index * sizeof(field), sizeof(field));
+        return field;
+    }
+}
+
+namespace CmdLine
+{
+    void SnapshotWriter::Add(const ArgParam& p)
+    {
+        Entry e{ p.Name(), p.IsSpecified(), {}, {} };
+
+        if (auto prog = dynamic_cast<const ProgParam*>(&p))
+        {
+            if (prog->IsSpecified())
+                e.values.push_back(prog->Value());
+        }
+        else if (auto valueOption = dynamic_cast<const ValueOption*>(&p))
+        {
+            e.values = valueOption->Values();
+        }
+        else if (auto pos = dynamic_cast<const PosParam*>(&p))
+        {
+            if (pos->IsSpecified())
+                e.values.push_back(pos->Value());
+        }
+        else if (auto multi = dynamic_cast<const MultiPosParam*>(&p))
+        {
+            e.view = multi->ValueView();
+        }
+
+        mEntries.push_back(std::move(e));
+    }
+
+    std::size_t SnapshotWriter::Size() const
+    {
+        std::size_t size = headerSize + FlagsSize(mEntries.size()) + 
+            mEntries.size() * paramEntrySize;
+
+        for (auto& e : mEntries)
+        {
+            size += e.name.size();
+            for (auto& value : e.values)
+                size += valueEntrySize + value.size();
+            for (std::string_view value : e.view)
+                size += valueEntrySize + value.size();
+        }
+
+        return size;
+    }
+
+    void SnapshotWriter::Write(void* out) const
+    {
+        std::size_t valueCount = 0;
+        std::size_t poolSize = 0;
+        for (auto& e : mEntries)
+        {
+            valueCount += e.values.size() + e.view.Size();
+            poolSize += e.name.size();
+            for (auto& value : e.values)
+                poolSize += value.size();
+            for (std::string_view value : e.view)
+                poolSize += value.size();
+        }
+
+        std::size_t size = Size();
+        auto data = static_cast<unsigned char*>(out);
+        unsigned char* header = data;
+        header = Put(header, snapshotMagic);
+        header = Put(header, snapshotVersion);
+        header = Put(header, size);
+        header = Put(header, mEntries.size());
+        header = Put(header, valueCount);
+        Put(header, poolSize);
+
+        unsigned char* flags = data + headerSize;
+        std::size_t flagsSize = FlagsSize(mEntries.size());
+        std::memset(flags, 0, flagsSize);
+
+        unsigned char* params = flags + flagsSize;
+        unsigned char* values = params + mEntries.size() * paramEntrySize;
+        unsigned char* pool = values + valueCount * valueEntrySize;
+        std::size_t poolOffset = 0;
+        std::size_t valueIndex = 0;
+
+        auto addString = [&](std::string_view s)
+        {
+            std::memcpy(pool + poolOffset, s.data(), s.size());
+            poolOffset += s.size();
+        };
+
+        auto addValue = [&](std::string_view value)
+        {
+            values = Put(values, poolOffset);
+            values = Put(values, value.size());
+            addString(value);
+            valueIndex++;
+        };
+
+        for (std::size_t i = 0; i < mEntries.size(); i++)
+        {
+            const Entry& e = mEntries[i];
+            if (e.isSpecified)
+                flags[i / 8] |= static_cast<unsigned char>(1u << (i % 8));
+
+            params = Put(params, poolOffset);
+            params = Put(params, e.name.size());
+            params = Put(params, valueIndex);
+            params = Put(params, e.values.size() + e.view.Size());
+            addString(e.name);
+
+            for (auto& value : e.values)
+                addValue(value);
+            for (std::string_view value : e.view)
+                addValue(value);
+        }
+    }
+
+    std::vector<char> SnapshotWriter::Write() const
+    {
+        std::vector<char> data(Size());
+        Write(data.data());
+        return data;
+    }
+
+    ParseSnapshot::ParseSnapshot(const void* data, std::size_t size)
+        : mData{ static_cast<const unsigned char*>(data) }, mParamCount{ 0 },
+          mValueCount{ 0 }, mFlags{ nullptr }, mParams{ nullptr }, 
+          mValues{ nullptr }, mPool{ nullptr }
+    {
+        if (!Validate(size))
+        {
+            mParamCount = 0;
+            mValueCount = 0;
+            mConstructionError = Raise<Invalid>(ErrorCode::InvalidSnapshot, 
+                invalidSnapshotError);
+        }
+    }
+
+    std::size_t ParseSnapshot::Find(std::string_view name) const
+    {
+        for (std::size_t i = 0; i < mParamCount; i++)
+        {
+            if (Name(i) == name)
+                return i;
+        }
+
+        return mParamCount;
+    }
+
+    std::string_view ParseSnapshot::Name(std::size_t param) const
+    {
+        const unsigned char* entry = mParams + param * paramEntrySize;
+        return std::string_view{ mPool + Get(entry, 0), Get(entry, 1) };
+    }
+
+    bool ParseSnapshot::IsSpecified(std::size_t param) const
+    {
+        return (mFlags[param / 8] >> (param % 8)) & 1;
+    }
+
+    std::size_t ParseSnapshot::ValueCount(std::size_t param) const
+    {
+        return Get(mParams + param * paramEntrySize, 3);
+    }
+
+    std::string_view ParseSnapshot::Value(std::size_t param, std::size_t n) 
+        const
+    {
+        std::size_t first = Get(mParams + param * paramEntrySize, 2);
+        const unsigned char* entry = mValues + (first + n) * valueEntrySize;
+        return std::string_view{ mPool + Get(entry, 0), Get(entry, 1) };
+    }
+
+    bool ParseSnapshot::Validate(std::size_t size)
+    {
+        if (mData == nullptr || size < headerSize)
+            return false;
+
+        if (Get(mData, 0) != snapshotMagic || 
+            Get(mData, 1) != snapshotVersion || Get(mData, 2) != size)
+        {
+            return false;
+        }
+
+        mParamCount = Get(mData, 3);
+        mValueCount = Get(mData, 4);
+        std::size_t poolSize = Get(mData, 5);
+
+        // The counts are 32-bit, so adding up the parts can't overflow 64 
+        // bits, and they have to add up to the whole.
+        std::size_t flagsSize = FlagsSize(mParamCount);
+        std::uint64_t expected = std::uint64_t{ headerSize } + flagsSize + 
+            std::uint64_t{ mParamCount } * paramEntrySize + 
+            std::uint64_t{ mValueCount } * valueEntrySize + poolSize;
+        if (expected != size)
+            return false;
+
+        mFlags = mData + headerSize;
+        mParams = mFlags + flagsSize;
+        mValues = mParams + mParamCount * paramEntrySize;
+        mPool = reinterpret_cast<const char*>(mValues + 
+            mValueCount * valueEntrySize);
+
+        auto inPool = [poolSize](std::size_t offset, std::size_t length)
+        {
+            return offset <= poolSize && length <= poolSize - offset;
+        };
+
+        for (std::size_t i = 0; i < mParamCount; i++)
+        {
+            const unsigned char* entry = mParams + i * paramEntrySize;
+            std::size_t first = Get(entry, 2);
+            if (!inPool(Get(entry, 0), Get(entry, 1)) || 
+                first > mValueCount || Get(entry, 3) > mValueCount - first)
+            {
+                return false;
+            }
+        }
+
+        for (std::size_t i = 0; i < mValueCount; i++)
+        {
+            const unsigned char* entry = mValues + i * valueEntrySize;
+            if (!inPool(Get(entry, 0), Get(entry, 1)))
+                return false;
+        }
+
+        return true;
+    }
+
+    ParseSnapshot::Invalid::Invalid(const char* message)
+        : invalid_argument(message)
+    {
+    }
+}
@@ -0,0 +1,212 @@
+// ParseSnapshot.h - Declares the ParseSnapshot and SnapshotWriter classes.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_PARSE_SNAPSHOT_H
+#define CMD_LINE_PARSE_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ArgParam.h"
+#include "ArgView.h"
+#include "Constants.h"
+#include "Error.h"
+
+namespace CmdLine
+{
+    /// @brief Identifies the data of a ParseSnapshot, "CLPS" when read as
+    /// bytes on a little-endian machine.
+    constexpr std::uint32_t snapshotMagic = 0x53504C43;
+
+    /// @brief The version of the ParseSnapshot format.
+    ///
+    /// Must be incremented whenever the format changes.
+    constexpr std::uint32_t snapshotVersion = 1;
+
+    /// @brief Writes the result of a parse as a ParseSnapshot.
+    ///
+    /// Records whether each ArgParam added to it is specified and its 
+    /// values, by name. See Parser::Snapshot() for snapshotting everything
+    /// a Parser parsed.
+    class SnapshotWriter
+    {
+    public:
+        /// @brief Adds an ArgParam to the snapshot.
+        ///
+        /// The values of a MultiPosParam aren't copied, so it must still 
+        /// exist, unchanged, when the snapshot is written.
+        ///
+        /// @param p The ArgParam to add.
+        void Add(const ArgParam& p);
+
+        /// @brief Gets the size of the snapshot.
+        ///
+        /// @return The number of bytes Write() writes.
+        std::size_t Size() const;
+
+        /// @brief Writes the snapshot to memory, e.g. shared memory.
+        ///
+        /// @param out Where to write the snapshot.
+        /// @pre out has room for Size() bytes.
+        /// @pre The snapshot is smaller than 4 GiB.
+        void Write(void* out) const;
+
+        /// @brief Writes the snapshot to a buffer.
+        ///
+        /// @return The snapshot.
+        /// @pre The snapshot is smaller than 4 GiB.
+        std::vector<char> Write() const;
+    private:
+        struct Entry
+        {
+            std::string name;
+            bool isSpecified;
+            std::vector<std::string> values;
+            ArgView view;
+        };
+
+        std::vector<Entry> mEntries;
+    };
+
+    /// @brief A read-only view of the result of a parse.
+    ///
+    /// A supervisor that parses its arguments once and starts many workers
+    /// can hand each worker a snapshot instead of the arguments to parse 
+    /// again. The snapshot is a single block of memory with no pointers, so
+    /// it can be written to a pipe, a memfd or shared memory and read from
+    /// wherever it ends up. Attaching to it only checks that it's 
+    /// consistent; nothing is copied, and each name and value is a view 
+    /// into the snapshot, valid as long as its memory is. For example:
+    ///
+    ///     std::vector<char> data = parser.Snapshot();
+    ///     // ...hand data to a worker, which then:
+    ///     ParseSnapshot snapshot{ data.data(), data.size() };
+    ///     if (snapshot.IsSpecified("-v"))
+    ///         EnableLogging();
+    ///
+    /// The snapshot is laid out as a header of six 32-bit fields (magic,
+    /// version, size, ArgParam count, value count, string pool size), a 
+    /// bitset of which ArgParams are specified padded to 64-bit words, a 
+    /// (name offset, name length, first value, value count) entry per 
+    /// ArgParam, an (offset, length) entry per value and the string pool
+    /// the offsets refer to. Numbers are in the byte order of the machine
+    /// that wrote them, which the magic number checks.
+    class ParseSnapshot
+    {
+    public:
+        /// @brief An exception thrown for data that isn't a valid snapshot.
+        class Invalid : public std::invalid_argument
+        {
+        public:
+            /// @brief Constructs an Invalid exception.
+            ///
+            /// @param message The message to include with the exception.
+            Invalid(const char* message);
+        };
+
+        /// @brief Attaches to a snapshot.
+        ///
+        /// @param data The snapshot, which needn't be aligned.
+        /// @param size The size of the snapshot.
+        /// @exception Invalid The data isn't a valid snapshot.
+        ParseSnapshot(const void* data, std::size_t size);
+
+        /// @brief Gets the error that made the snapshot invalid.
+        ///
+        /// Only a library built without exceptions records an error here; 
+        /// otherwise the constructor throws it instead (see Error). An 
+        /// invalid snapshot has no ArgParams.
+        ///
+        /// @return The error, whose code is ErrorCode::None if the snapshot
+        /// is valid.
+        const Error& ConstructionError() const { return mConstructionError; }
+
+        /// @brief Gets the number of ArgParams in the snapshot.
+        ///
+        /// @return The number of ArgParams.
+        std::size_t ParamCount() const { return mParamCount; }
+
+        /// @brief Finds an ArgParam by name.
+        ///
+        /// @param name The name of the ArgParam, e.g. an Option's Name().
+        /// @return The index of the ArgParam, or ParamCount() if there is
+        /// none by that name.
+        std::size_t Find(std::string_view name) const;
+
+        /// @brief Gets the name of an ArgParam.
+        ///
+        /// @param param The index of the ArgParam.
+        /// @return The name.
+        /// @pre The index is less than ParamCount().
+        std::string_view Name(std::size_t param) const;
+
+        /// @brief Indicates whether an ArgParam is specified.
+        ///
+        /// @param param The index of the ArgParam.
+        /// @return True if it's specified, otherwise false.
+        /// @pre The index is less than ParamCount().
+        bool IsSpecified(std::size_t param) const;
+
+        /// @brief Indicates whether an ArgParam is specified.
+        ///
+        /// @param name The name of the ArgParam.
+        /// @return True if there is an ArgParam by that name and it's 
+        /// specified, otherwise false.
+        bool IsSpecified(std::string_view name) const
+        {
+            std::size_t param = Find(name);
+            return param < mParamCount && IsSpecified(param);
+        }
+
+        /// @brief Gets the number of values of an ArgParam.
+        ///
+        /// @param param The index of the ArgParam.
+        /// @return The number of values.
+        /// @pre The index is less than ParamCount().
+        std::size_t ValueCount(std::size_t param) const;
+
+        /// @brief Gets a value of an ArgParam.
+        ///
+        /// @param param The index of the ArgParam.
+        /// @param n The index of the value.
+        /// @return The value.
+        /// @pre The index is less than ParamCount().
+        /// @pre n is less than ValueCount().
+        std::string_view Value(std::size_t param, std::size_t n = 0) const;
+    private:
+        const unsigned char* mData;
+        std::size_t mParamCount;
+        std::size_t mValueCount;
+        const unsigned char* mFlags;
+        const unsigned char* mParams;
+        const unsigned char* mValues;
+        const char* mPool;
+        Error mConstructionError;
+
+        /// @brief Checks the snapshot is consistent.
+        ///
+        /// @param size The size of the snapshot.
+        /// @return True if it's valid, otherwise false.
+        /// @post The table pointers refer to the snapshot if it's valid.
+        bool Validate(std::size_t size);
+    };
+}
+
+#endif
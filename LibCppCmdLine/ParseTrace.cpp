@@ -0,0 +1,99 @@
+// ParseTrace.cpp - Defines the ParseTrace class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include <algorithm>
+#include <cstring>
+#include "ParseTrace.h"
+
+namespace CmdLine
+{
+    ParseTrace::ParseTrace(std::size_t capacity)
+        : mDecisions(std::max<std::size_t>(capacity, 1)), mNext{ 0 }, 
+        mSize{ 0 }, mDropped{ 0 }
+    {
+    }
+
+    void ParseTrace::Record(std::size_t argIndex, const std::string& argument,
+        const ArgParam* candidate, bool canPopulate, 
+        std::size_t consumes) noexcept
+    {
+        ParseDecision& d = mDecisions[mNext];
+        d.argIndex = argIndex;
+        d.candidate = candidate;
+        d.canPopulate = canPopulate;
+        d.consumes = consumes;
+
+        // Copying into the fixed size buffer keeps recording allocation free.
+        std::size_t length = std::min(argument.size(), 
+            ParseDecision::maxArgumentLength);
+        std::memcpy(d.argument, argument.data(), length);
+        d.argument[length] = '\0';
+        d.truncated = length < argument.size();
+
+        mNext = (mNext + 1) % mDecisions.size();
+        if (mSize < mDecisions.size())
+            mSize++;
+        else
+            mDropped++;
+    }
+
+    const ParseDecision& ParseTrace::At(std::size_t i) const
+    {
+        // Once the buffer has wrapped, the oldest decision is the one that
+        // will be overwritten next.
+        std::size_t oldest = mSize < mDecisions.size() ? 0 : mNext;
+        return mDecisions[(oldest + i) % mDecisions.size()];
+    }
+
+    void ParseTrace::Clear()
+    {
+        mNext = 0;
+        mSize = 0;
+        mDropped = 0;
+    }
+
+    void ParseTrace::Dump(std::ostream& out) const
+    {
+        if (mDropped > 0)
+            out << "(" << mDropped << " earlier decisions dropped)\n";
+
+        for (std::size_t i = 0; i < mSize; i++)
+        {
+            const ParseDecision& d = At(i);
+            std::string name = d.candidate != nullptr 
+                ? d.candidate->Name() : "(null)";
+
+            out << "arg " << d.argIndex << " \"" << d.argument << "\"";
+            if (d.truncated)
+                out << "...";
+            out << " -> " << name;
+
+            if (d.canPopulate)
+                out << ": can populate, consumes " << d.consumes << "\n";
+            else
+                out << ": cannot populate\n";
+        }
+    }
+
+    bool ParseTraceEnabled()
+    {
+#ifdef CMD_LINE_PARSE_TRACE
+        return true;
+#else
+        return false;
+#endif
+    }
+}
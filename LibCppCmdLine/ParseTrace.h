@@ -0,0 +1,145 @@
+// ParseTrace.h - Declares the ParseTrace class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_PARSE_TRACE_H
+#define CMD_LINE_PARSE_TRACE_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "ArgParam.h"
+
+// Decisions are only recorded in builds with assertions enabled, so the
+// recording compiles out of release builds entirely. Defining 
+// CMD_LINE_PARSE_TRACE when building the library records them regardless.
+#if !defined(NDEBUG) && !defined(CMD_LINE_PARSE_TRACE)
+#define CMD_LINE_PARSE_TRACE
+#endif
+
+namespace CmdLine
+{
+    /// @brief One decision the Parser made while populating ArgParams.
+    ///
+    /// Records asking one candidate ArgParam whether it can populate from 
+    /// the argument at the front of the argument queue.
+    struct ParseDecision
+    {
+        /// @brief The maximum number of characters of the argument kept.
+        static constexpr std::size_t maxArgumentLength = 31;
+
+        /// @brief The position of the argument on the command line, 0 being
+        /// the program name.
+        std::size_t argIndex{ 0 };
+
+        /// @brief The start of the argument, truncated if need be.
+        char argument[maxArgumentLength + 1]{};
+
+        /// @brief Whether the argument was too long to keep all of.
+        bool truncated{ false };
+
+        /// @brief The ArgParam asked whether it can populate.
+        const ArgParam* candidate{ nullptr };
+
+        /// @brief The result of ArgParam::CanPopulate().
+        bool canPopulate{ false };
+
+        /// @brief The result of ArgParam::Consumes(), or 0 if the candidate
+        /// can't populate.
+        std::size_t consumes{ 0 };
+    };
+
+    /// @brief Records the decisions a Parser makes in a ring buffer.
+    ///
+    /// Explains which ArgParam each argument went to and why: set a 
+    /// ParseTrace on a Parser (see Parser::Set()) and, when parsing fails or
+    /// an argument populates the wrong ArgParam, dump it. Memory for the 
+    /// decisions is allocated once, when the ParseTrace is constructed, so 
+    /// recording never allocates; once the buffer is full the oldest 
+    /// decisions are overwritten. Recording is compiled out of release
+    /// builds (see ParseTraceEnabled()). For example:
+    ///
+    ///     ParseTrace trace;
+    ///     parser.Set(&trace);
+    ///     if (parser.Parse() == Parser::Status::Failure)
+    ///         trace.Dump(std::cerr);
+    class ParseTrace
+    {
+    public:
+        /// @brief The number of decisions kept by default.
+        static constexpr std::size_t defaultCapacity = 256;
+
+        /// @brief Constructs a new, empty ParseTrace.
+        ///
+        /// @param capacity The number of most recent decisions to keep.
+        /// @pre The capacity is greater than 0.
+        ParseTrace(std::size_t capacity = defaultCapacity);
+
+        /// @brief Records a decision.
+        ///
+        /// Overwrites the oldest decision if the buffer is full.
+        ///
+        /// @param argIndex The position of the argument on the command line.
+        /// @param argument The argument.
+        /// @param candidate The ArgParam asked whether it can populate.
+        /// @param canPopulate The result of ArgParam::CanPopulate().
+        /// @param consumes The result of ArgParam::Consumes().
+        void Record(std::size_t argIndex, const std::string& argument,
+            const ArgParam* candidate, bool canPopulate, 
+            std::size_t consumes) noexcept;
+
+        /// @brief Gets the number of decisions kept.
+        ///
+        /// @return The number of decisions, at most the capacity.
+        std::size_t Size() const { return mSize; }
+
+        /// @brief Gets the number of decisions overwritten.
+        ///
+        /// @return The number of decisions recorded but no longer kept.
+        std::size_t Dropped() const { return mDropped; }
+
+        /// @brief Gets a decision that was kept.
+        ///
+        /// @param i The index of the decision, 0 being the oldest kept.
+        /// @return The decision.
+        /// @pre i < Size().
+        const ParseDecision& At(std::size_t i) const;
+
+        /// @brief Discards every decision.
+        void Clear();
+
+        /// @brief Writes each decision kept to a stream, oldest first.
+        ///
+        /// Gets the names of the candidate ArgParams, so they must still 
+        /// exist.
+        ///
+        /// @param out The stream to write to.
+        void Dump(std::ostream& out) const;
+    private:
+        std::vector<ParseDecision> mDecisions;
+        std::size_t mNext;
+        std::size_t mSize;
+        std::size_t mDropped;
+    };
+
+    /// @brief Determines if the library records ParseTrace decisions.
+    ///
+    /// @return True if the library was built with CMD_LINE_PARSE_TRACE
+    /// defined, which is the default unless NDEBUG is defined.
+    bool ParseTraceEnabled();
+}
+
+#endif
@@ -14,23 +14,40 @@
 // See the License for the specific language governing permissionsand
 // limitations under the License.
 
+#include <algorithm>
+#include <utility>
 #include "Parser.h"
 
 namespace CmdLine
 {
     Parser::Parser(ProgParam* p, std::vector<std::string> args)
-        : mProgParam{ p }, mArgs{ args }, mMultiPosParam{ nullptr }
+        : mArgs{ std::move(args) }, mEndOfOptions{ 0 },
+        mShortCircuit{ nullptr }, mShortCircuitOrigin{ 0 },
+        mShortCircuitArgs{ 0 }, mMultiPosParam{ nullptr }, mProgParam{ p },
+        mObserver{ nullptr }, mTrace{ nullptr }
     {
+        // Without exceptions the Parser is still fully constructed after an
+        // error, so that BuiltInHelpOptionIsSpecified() remains safe to call.
         if (mProgParam == nullptr)
-            throw NullParameter{ nullProgParamError };
+        {
+            mConstructionError = Raise<NullParameter>(
+                ErrorCode::NullParameter, nullProgParamError);
+        }
+        else if (mArgs.size() < 1)
+        {
+            mConstructionError = Raise<EmptyArguments>(
+                ErrorCode::EmptyArguments, emptyArgsError);
+        }
 
-        if (args.size() < 1)
-            throw EmptyArguments{ emptyArgsError };
+        // The arguments never change, so the origins recorded while parsing
+        // never need more room than this.
+        mArgOrigins.reserve(mArgs.size());
 
         Option::Definition builtInHelpOptionDef;
         builtInHelpOptionDef.shortName = helpOptionShortName;
         builtInHelpOptionDef.longName = helpOptionLongName;
         builtInHelpOptionDef.description = helpOptionDescription;
+        builtInHelpOptionDef.isShortCircuit = true;
 
         mBuiltInHelpOption = std::make_unique<Option>(builtInHelpOptionDef);
         Add(mBuiltInHelpOption.get());
@@ -38,17 +55,95 @@ namespace CmdLine
 
     Parser::Status Parser::Parse()
     {
-        if (FillArgQueue() == Status::Failure)
+        mLastError = ParseError{};
+
+        // Only a library built without exceptions can get this far with
+        // nothing to parse.
+        if (mConstructionError.code != ErrorCode::None)
             return Status::Failure;
 
+        NotifyPhaseStarted(ParsePhase::FillArgQueue);
+        Status status = FillArgQueue();
+        NotifyPhaseFinished(ParsePhase::FillArgQueue);
+        if (status == Status::Failure)
+            return Status::Failure;
+
+        // A short-circuit Option leaves nothing else to parse.
+        if (mShortCircuit != nullptr)
+        {
+            NotifyPhaseStarted(ParsePhase::PopulateArgParams);
+            status = PopulateShortCircuit();
+            NotifyPhaseFinished(ParsePhase::PopulateArgParams);
+            return status;
+        }
+
+        NotifyPhaseStarted(ParsePhase::FillArgParamVector);
         FillArgParamVector();
+        NotifyPhaseFinished(ParsePhase::FillArgParamVector);
 
-        if (PopulateArgParams() == Status::Failure)
+        NotifyPhaseStarted(ParsePhase::PopulateArgParams);
+        status = PopulateArgParams();
+        NotifyPhaseFinished(ParsePhase::PopulateArgParams);
+        if (status == Status::Failure)
             return Status::Failure;
 
         return Status::Success;
     }
 
+    Parser::Status Parser::Parse(ArgSource& source, ParseHandler& handler)
+    {
+        mLastError = ParseError{};
+
+        if (mConstructionError.code != ErrorCode::None)
+            return Status::Failure;
+
+        ParseCursor cursor = Cursor(source);
+        ParsedItem item;
+        while (cursor.Next(item))
+        {
+            bool keepParsing = true;
+            switch (item.kind)
+            {
+                case ParsedItem::Kind::Option:
+                    keepParsing = handler.OptionSeen(*item.option, 
+                        item.argIndex);
+                    break;
+                case ParsedItem::Kind::Value:
+                    keepParsing = handler.ValueSeen(*item.option, item.arg, 
+                        item.argIndex);
+                    break;
+                case ParsedItem::Kind::Positional:
+                    keepParsing = handler.PositionalSeen(item.arg, 
+                        item.argIndex);
+                    break;
+            }
+
+            if (!keepParsing)
+                return Status::Success;
+        }
+
+        mLastError = cursor.LastError();
+        if (mLastError.kind != ParseError::Kind::None)
+            return Status::Failure;
+
+        return Status::Success;
+    }
+
+    std::vector<char> Parser::Snapshot() const
+    {
+        SnapshotWriter writer;
+        if (mProgParam != nullptr)
+            writer.Add(*mProgParam);
+        for (auto* o : mOptions)
+            writer.Add(*o);
+        for (auto* p : mPosParams)
+            writer.Add(*p);
+        if (mMultiPosParam != nullptr)
+            writer.Add(*mMultiPosParam);
+
+        return writer.Write();
+    }
+
     std::string Parser::GenerateUsage() const
     {
         std::stringstream usage;
@@ -83,42 +178,96 @@ namespace CmdLine
         return usage.str();
     }
 
-    void Parser::Add(Option* o)
+    Error Parser::Add(Option* o)
     {
         if (o == nullptr)
-            throw NullParameter{ nullOptionError };
+        {
+            return Raise<NullParameter>(ErrorCode::NullParameter, 
+                nullOptionError);
+        }
 
-        for (const auto& option : mOptions)
+        // Only a library built without exceptions can have an invalid Option
+        // to add.
+        if (o->ConstructionError().code != ErrorCode::None)
+            return o->ConstructionError();
+
+        // Looking the names up in a set rather than comparing them against
+        // each Option already added keeps adding n Options O(n) overall. An
+        // Option without a long name has an empty LongName(), which must not
+        // count as a duplicate.
+        std::string name = o->Name();
+        std::string longName = o->LongName();
+        const bool nameTaken = mOptionNames.count(name) > 0;
+        const bool longNameTaken = longName != "" &&
+            mOptionNames.count(longName) > 0;
+        if (nameTaken || longNameTaken)
         {
-            const bool shortNamesMatch = option->Name() == o->Name();
-            const bool longNamesMatch = option->LongName() == o->LongName();
-            if (shortNamesMatch || longNamesMatch)
-                throw DuplicateOption{ duplicateOptionError };
+            return Raise<DuplicateOption>(ErrorCode::DuplicateOption, 
+                duplicateOptionError);
         }
 
         mOptions.push_back(o);
+        mOptionNames.insert(name);
+        if (longName != "")
+            mOptionNames.insert(longName);
+
+        return Error{};
     }
 
-    void Parser::Add(PosParam* p)
+    Error Parser::Add(PosParam* p)
     {
         if (p == nullptr)
-            throw NullParameter{ nullPosParamError };
+        {
+            return Raise<NullParameter>(ErrorCode::NullParameter, 
+                nullPosParamError);
+        }
+
+        // Only a library built without exceptions can have an invalid 
+        // PosParam to add.
+        if (p->ConstructionError().code != ErrorCode::None)
+            return p->ConstructionError();
 
         for (const auto& positional : mPosParams)
         {
             if (positional->Name() == p->Name())
-                throw DuplicatePosParam{ duplicatePosParamError };
+            {
+                return Raise<DuplicatePosParam>(ErrorCode::DuplicatePosParam, 
+                    duplicatePosParamError);
+            }
         }
 
         mPosParams.push_back(p);
+        return Error{};
+    }
+
+    Error Parser::Set(MultiPosParam* p)
+    {
+        // Only a library built without exceptions can have an invalid 
+        // MultiPosParam to set.
+        if (p != nullptr && p->ConstructionError().code != ErrorCode::None)
+            return p->ConstructionError();
+
+        mMultiPosParam = p;
+        return Error{};
     }
 
     Parser::Status Parser::FillArgQueue()
     {
         std::deque<std::string> workingArgQueue;
 
-        // Re-initialize the argument queue in case it has already been filled.
-        mArgQueue = std::deque<std::string>();
+        // Empty the argument queue in case it has already been filled. 
+        // Clearing it rather than replacing it keeps the storage it already
+        // has, so filling it allocates less.
+        mArgQueue.clear();
+
+        // Every argument ends up in mArgQueue exactly once, so the origins
+        // can be recorded in a vector of the same size as the arguments are
+        // moved instead of searching for them when parsing fails.
+        mArgOrigins.assign(mArgs.size(), 0);
+
+        // No argument is after the end-of-options marker unless one is found.
+        mEndOfOptions = mArgs.size();
+        mShortCircuit = nullptr;
 
         // Shorten the name of the argument list to reduce line length.
         std::vector<std::string>& a = mArgs;
@@ -133,12 +282,18 @@ namespace CmdLine
         std::string programArg = workingArgQueue.front();
         workingArgQueue.pop_front();
         mArgQueue.push_back(programArg);
+        mArgOrigins[0] = 0;
 
         // Options should be parsed second so move all option arguments into
         // mArgQueue next.
         if (MoveOptionsToArgQueue(workingArgQueue) == Status::Failure)
             return Status::Failure;
 
+        // The positional arguments won't be parsed after a short-circuit 
+        // Option, so there's no need to move them.
+        if (mShortCircuit != nullptr)
+            return Status::Success;
+
         // Positional arguments (both single-value and multi-value) should be
         // moved last. Which type moves first depends on the parsing order.
         if (mMultiPosParam != nullptr)
@@ -191,37 +346,208 @@ namespace CmdLine
         while (!mArgQueue.empty())
         {
             bool argumentPopulated = false;
+            ArgParam* candidate = nullptr;
 
             // Successful population should always reduce the queue size
             std::size_t previousQueueSize = mArgQueue.size();
 
+            // Where the argument at the front of the queue was on the 
+            // command line.
+            std::size_t argIndex = FrontOrigin();
+
+            // Everything from the first operand on is positional, so it
+            // doesn't need to be offered to each ArgParam in turn.
+            if (argIndex > mEndOfOptions)
+                return PopulateOperands();
+
             for (auto* p : mArgParams)
             {
-                if (p->CanPopulate(mArgQueue))
+                // The MultiPosParam would refuse positional arguments before
+                // the marker because of option-like operands after it, so it
+                // takes them all as operands instead.
+                if (p == mMultiPosParam && MultiPosParamTakesOperands())
+                    return PopulateOperands();
+
+                bool canPopulate = p->CanPopulate(mArgQueue);
+
+#ifdef CMD_LINE_PARSE_TRACE
+                if (mTrace != nullptr)
                 {
-                    argumentPopulated = p->Populate(mArgQueue);
+                    mTrace->Record(argIndex, mArgQueue.front(), p, 
+                        canPopulate, canPopulate ? p->Consumes(mArgQueue) : 0);
+                }
+#endif
+
+                if (canPopulate)
+                {
+                    candidate = p;
+                    argumentPopulated = p == mMultiPosParam && 
+                        CanPopulateView() ? PopulateView() : Populate(p);
                     break;
                 }
             }
 
+            if (candidate == nullptr)
+                return Fail(ParseError::Kind::UnexpectedArgument, argIndex);
+
+            if (!argumentPopulated)
+            {
+                return Fail(ParseError::Kind::PopulateFailed, argIndex, 
+                    candidate);
+            }
+
             // If the queue size was not reduced, we could have an endless
             // loop. We should return failure in this situation to break
             // out of the loop. 
-            bool endlessLoop = mArgQueue.size() == previousQueueSize;
+            if (mArgQueue.size() == previousQueueSize)
+                return Fail(ParseError::Kind::NoProgress, argIndex, candidate);
+        }
+
+        return Status::Success;
+    }
+
+    Parser::Status Parser::PopulateShortCircuit()
+    {
+        // Only the program argument and the short-circuit Option's own
+        // arguments are queued. Neither container needs to grow for this.
+        mArgQueue.clear();
+        mArgOrigins.clear();
+        mArgQueue.push_back(mArgs.front());
+        mArgOrigins.push_back(0);
+        for (std::size_t n = 0; n < mShortCircuitArgs; n++)
+        {
+            mArgQueue.push_back(mArgs[mShortCircuitOrigin + n]);
+            mArgOrigins.push_back(mShortCircuitOrigin + n);
+        }
 
-            if (!argumentPopulated || endlessLoop)
+        if (!Populate(mProgParam))
+            return Fail(ParseError::Kind::PopulateFailed, 0, mProgParam);
+
+        if (!Populate(mShortCircuit))
+        {
+            return Fail(ParseError::Kind::PopulateFailed, mShortCircuitOrigin,
+                mShortCircuit);
+        }
+
+        return Status::Success;
+    }
+
+    bool Parser::FindShortCircuit(std::deque<std::string>& source, 
+        std::deque<std::string>::iterator from)
+    {
+        // Arguments are only ever compacted behind the scan in 
+        // MoveOptionsToArgQueue(), so those from here on haven't moved.
+        for (auto i = from; i != source.end(); i++)
+        {
+            if (*i == endOfOptionsMarker)
+                return false;
+
+            if (!IsOption(*i))
+                continue;
+
+            for (auto* o : mOptions)
             {
-                return Status::Failure;
+                if (!o->IsShortCircuit() || !o->Matches(*i))
+                    continue;
+
+                std::size_t argsToConsume = o->Consumes(source);
+                if (argsToConsume > static_cast<std::size_t>(source.end() - i))
+                    return false;
+
+                mShortCircuit = o;
+                mShortCircuitOrigin = (i - source.begin()) + 1;
+                mShortCircuitArgs = argsToConsume;
+                return true;
             }
         }
 
+        return false;
+    }
+
+    bool Parser::MultiPosParamTakesOperands() const
+    {
+        if (mArgQueue.empty() || mArgOrigins.back() <= mEndOfOptions)
+            return false;
+
+        // Positional arguments are queued in order, so the operands are the
+        // arguments at the back of the queue.
+        std::size_t first = mArgOrigins.size() - mArgQueue.size();
+        for (std::size_t i = 0; i < mArgQueue.size(); i++)
+        {
+            if (mArgOrigins[first + i] > mEndOfOptions)
+                break;
+
+            if (IsOption(mArgQueue[i]))
+                return false;
+        }
+
+        return true;
+    }
+
+    Parser::Status Parser::PopulateOperands()
+    {
+        for (auto* p : mPosParams)
+        {
+            if (mArgQueue.empty())
+                break;
+
+            if (p->IsSpecified())
+                continue;
+
+            std::size_t argIndex = FrontOrigin();
+            bool populated = Observe(p, [this, p]
+            {
+                return p->PopulateOperand(mArgQueue);
+            });
+
+            if (!populated)
+                return Fail(ParseError::Kind::PopulateFailed, argIndex, p);
+        }
+
+        if (mArgQueue.empty())
+            return Status::Success;
+
+        std::size_t argIndex = FrontOrigin();
+        if (mMultiPosParam == nullptr)
+            return Fail(ParseError::Kind::UnexpectedArgument, argIndex);
+
+        MultiPosParam* m = mMultiPosParam;
+        bool populated = CanPopulateView() ? PopulateView() : 
+            Observe(m, [this, m] { return m->PopulateOperands(mArgQueue); });
+        if (!populated)
+            return Fail(ParseError::Kind::PopulateFailed, argIndex, m);
+
         return Status::Success;
     }
 
-    void Parser::Set(Option::Style s)
+    Error Parser::Set(Option::Style s)
     {
+        // Changing the style changes the prefixed names, so the names used
+        // to detect duplicates need to be rebuilt. An Option's own short and
+        // long names may become the same, which isn't a duplicate.
+        mOptionNames.clear();
+        bool duplicate = false;
         for (auto option : mOptions)
+        {
             option->Set(s);
+            std::string name = option->Name();
+            std::string longName = option->LongName();
+            if (!mOptionNames.insert(name).second)
+                duplicate = true;
+            if (longName != "" && longName != name && 
+                !mOptionNames.insert(longName).second)
+            {
+                duplicate = true;
+            }
+        }
+
+        if (duplicate)
+        {
+            return Raise<DuplicateOption>(ErrorCode::DuplicateOption, 
+                duplicateOptionError);
+        }
+
+        return Error{};
     }
 
     bool Parser::AllMandatoryParamsSpecified()
@@ -238,14 +564,53 @@ namespace CmdLine
     Parser::Status Parser::MoveOptionsToArgQueue(std::deque<std::string>& 
         source)
     {
+        // Erasing options from the middle of the source queue would make
+        // this O(n^2) when options are mixed in with positional arguments, 
+        // so positional arguments are instead compacted towards the front
+        // of the queue as it is scanned and the rest is erased at the end.
+        auto kept = source.begin();
         auto i = source.begin();
+
+        // The source queue doesn't contain the program argument, so an
+        // argument's index in the source is one less than its origin.
+        auto origin = [&source](auto it) -> std::size_t
+        {
+            return (it - source.begin()) + 1;
+        };
+
+        // Positional arguments stay in the source, so their origins are
+        // filled in from the back of mArgOrigins, after the options.
+        auto posOrigin = mArgOrigins.rbegin();
+
         while (i != source.end())
         {
-            std::string argument = *i;
+            // Every argument after the end-of-options marker is an operand,
+            // which is positional however it looks, so the rest of the 
+            // source is kept without being checked and the marker dropped.
+            if (*i == endOfOptionsMarker)
+            {
+                mEndOfOptions = origin(i);
+                for (i++; i != source.end(); i++)
+                {
+                    *posOrigin++ = origin(i);
+                    if (kept != i)
+                        *kept = std::move(*i);
+
+                    kept++;
+                }
+
+                break;
+            }
 
-            // Move onto the next argument if it's not an Option.
-            if (!IsOption(argument))
+            // Keep the argument if it's not an Option.
+            if (!IsOption(*i))
             {
+                *posOrigin++ = origin(i);
+
+                if (kept != i)
+                    *kept = std::move(*i);
+
+                kept++;
                 i++;
                 continue;
             }
@@ -256,12 +621,14 @@ namespace CmdLine
             // consume so we know how many arguments to push into the queue on
             // this current iteration.
             std::size_t argsToConsume = 0;
+            Option* option = nullptr;
 
             for (auto* o : mOptions)
             {
-                if (o->CanPopulate(source))
+                if (o->Matches(*i))
                 {
                     argsToConsume = o->Consumes(source);
+                    option = o;
                     break;
                 }
             }
@@ -270,41 +637,66 @@ namespace CmdLine
             // supplied a bogus option and parsing will fail. Also, if there 
             // are not enough arguments for the Option to consume, parsing will
             // also fail.
-            if (argsToConsume == 0 || argsToConsume > source.size())
+            std::size_t argsRemaining = source.end() - i;
+            if (argsToConsume == 0 || argsToConsume > argsRemaining)
             {
-                return Status::Failure;
+                if (argsToConsume == 0)
+                {
+                    Fail(ParseError::Kind::UnknownOption, origin(i));
+                }
+                else
+                {
+                    Fail(ParseError::Kind::MissingOptionValue, origin(i), 
+                        option);
+                }
+
+                // A short-circuit Option further on still takes effect.
+                if (!FindShortCircuit(source, i + 1))
+                    return Status::Failure;
+
+                mLastError = ParseError{};
+                return Status::Success;
             }
 
-            if (argsToConsume == 2)
+            // Nothing after a short-circuit Option needs to be looked at.
+            if (option->IsShortCircuit())
             {
-                // Must be a value option because it consumes two arguments. We
-                // need to obtain the second argument representing the value by
-                // dereferencing iterator + 1.
-                std::string argument2 = *(i + 1);
-
-                mArgQueue.push_back(argument);
-                mArgQueue.push_back(argument2);
-                i = source.erase(i);
-                i = source.erase(i);
+                mShortCircuit = option;
+                mShortCircuitOrigin = origin(i);
+                mShortCircuitArgs = argsToConsume;
+                return Status::Success;
             }
-            else
+
+            // A value option consumes two arguments, the option and its
+            // value, which must stay together.
+            for (std::size_t n = 0; n < argsToConsume; n++)
             {
-                mArgQueue.push_back(argument);
-                i = source.erase(i);
+                mArgOrigins[mArgQueue.size()] = origin(i);
+                mArgQueue.push_back(std::move(*i));
+                i++;
             }
         }
 
+        // The marker itself isn't queued, which leaves an unused origin 
+        // between those of the options and the positional arguments.
+        if (mEndOfOptions < mArgs.size())
+            mArgOrigins.erase(mArgOrigins.begin() + mArgQueue.size());
+
+        // The origins of the positional arguments were filled in from the
+        // back, so put them back in the order the arguments are in.
+        std::reverse(mArgOrigins.begin() + mArgQueue.size(), 
+            mArgOrigins.end());
+
+        source.erase(kept, source.end());
         return Status::Success;
     }
 
     void Parser::MovePosArgsToArgQueue(std::deque<std::string>& source)
     {
-        auto i = source.begin();
-        while (i != source.end())
+        while (!source.empty())
         {
-            std::string argument = *i;
-            mArgQueue.push_back(argument);
-            i = source.erase(i);
+            mArgQueue.push_back(std::move(source.front()));
+            source.pop_front();
         }
     }
 
@@ -350,6 +742,12 @@ namespace CmdLine
         // the end even if the program has the user specify them before
         // the single-value positional arguments.
         dest.insert(dest.end(), mulPosArgs.begin(), mulPosArgs.end());
+
+        // Keep the origins of the positional arguments in the same order.
+        auto posOrigins = mArgOrigins.end() - posArgs.size() - 
+            mulPosArgs.size();
+        std::rotate(posOrigins, posOrigins + mulPosArgs.size(), 
+            mArgOrigins.end());
     }
 
     std::string Parser::GenerateBracketedUsageLabel(ArgParam* p) const
@@ -408,6 +806,66 @@ namespace CmdLine
         return usage.str();
     }
 
+    void Parser::NotifyPhaseStarted(ParsePhase p)
+    {
+#ifndef CMD_LINE_NO_PARSE_OBSERVERS
+        if (mObserver != nullptr)
+            mObserver->PhaseStarted(p);
+#endif
+    }
+
+    void Parser::NotifyPhaseFinished(ParsePhase p)
+    {
+#ifndef CMD_LINE_NO_PARSE_OBSERVERS
+        if (mObserver != nullptr)
+            mObserver->PhaseFinished(p);
+#endif
+    }
+
+    bool Parser::Populate(ArgParam* p)
+    {
+        return Observe(p, [this, p] { return p->Populate(mArgQueue); });
+    }
+
+    bool Parser::CanPopulateView() const
+    {
+        if (mMultiPosParam == nullptr || !mMultiPosParam->IsLazy() ||
+            mMultiPosParam->Order() != MultiPosParam::ParsingOrder::End ||
+            mArgQueue.empty())
+        {
+            return false;
+        }
+
+        return mArgOrigins.back() - FrontOrigin() + 1 == mArgQueue.size();
+    }
+
+    bool Parser::PopulateView()
+    {
+        MultiPosParam* m = mMultiPosParam;
+        ArgView args{ mArgs.data() + FrontOrigin(), mArgQueue.size() };
+        bool populated = Observe(m, [m, args]
+        {
+            return m->PopulateView(args);
+        });
+
+        mArgQueue.clear();
+        return populated;
+    }
+
+    std::size_t Parser::FrontOrigin() const
+    {
+        return mArgOrigins[mArgOrigins.size() - mArgQueue.size()];
+    }
+
+    Parser::Status Parser::Fail(ParseError::Kind k, std::size_t argIndex,
+        const ArgParam* expected)
+    {
+        mLastError.kind = k;
+        mLastError.argIndex = argIndex;
+        mLastError.expected = expected;
+        return Status::Failure;
+    }
+
     Parser::DuplicateOption::DuplicateOption(const char* message)
         : invalid_argument(message)
     {
@@ -20,13 +20,23 @@
 #include <vector>
 #include <string>
 #include <deque>
+#include <unordered_set>
 #include <stdexcept>
 #include <memory>
+#include "ArgSource.h"
 #include "Constants.h"
+#include "Error.h"
 #include "ProgParam.h"
 #include "Option.h"
+#include "ValueOption.h"
 #include "PosParam.h"
 #include "MultiPosParam.h"
+#include "ParseCursor.h"
+#include "ParseError.h"
+#include "ParseHandler.h"
+#include "ParseObserver.h"
+#include "ParseSnapshot.h"
+#include "ParseTrace.h"
 
 namespace CmdLine
 {
@@ -131,16 +141,123 @@ namespace CmdLine
         /// @exception EmptyArguments The arguments were empty.
         Parser(ProgParam* p, std::vector<std::string> args);
 
+        /// @brief Constructs a new Parser from an ArgSource.
+        ///
+        /// Options may follow positional arguments, so parsing needs every
+        /// argument at once; they are read from the source here, with the
+        /// first taken as the program name.
+        ///
+        /// @param p The ProgParam to populate with the program name.
+        /// @param source The source of the command line arguments to parse.
+        /// @exception NullParamter The parameter is null.
+        /// @exception EmptyArguments The source had no arguments.
+        Parser(ProgParam* p, ArgSource& source)
+            : Parser{ p, CollectArgs(source) }
+        { }
+
+        /// @brief Gets the error that occurred constructing the Parser.
+        ///
+        /// Only a library built without exceptions records an error here; 
+        /// otherwise the constructor throws it instead (see Error). A Parser
+        /// with a construction error fails to parse and must not be used to
+        /// generate usage or help.
+        ///
+        /// @return The error, whose code is ErrorCode::None if the ProgParam
+        /// and arguments were valid.
+        const Error& ConstructionError() const { return mConstructionError; }
+
         /// @brief Parses the command line arguments.
         ///
         /// Parsing the command line arguments will populate any command line
         /// Param (ProgParam, Option, ValueOption, PosParam, and 
         /// MultiPosParam) that have been added or set on the Parser and
         /// that could be populated by one of the arguments.
+        ///
+        /// Every argument after the end-of-options marker ("--") is an 
+        /// operand, which populates a PosParam or the MultiPosParam even if
+        /// it looks like an Option, e.g. a file named "-v". Operands skip the
+        /// checks other arguments go through, so passing a long list of 
+        /// files after the marker also parses faster.
+        ///
+        /// Parsing stops as soon as a short-circuit Option (see
+        /// Option::IsShortCircuit()), such as the built-in help option, is
+        /// found. Only it and the ProgParam are populated.
         /// 
         /// @return Success upon successful parsing, otherwise failure.
+        /// @post LastError() describes the failure, if any.
         Status Parse();
 
+        /// @brief Parses arguments as they are read, calling a ParseHandler.
+        ///
+        /// Each argument is read from the source and handled before the
+        /// next is read, so parsing can start before the source has every 
+        /// argument and takes constant memory however many there are. The
+        /// Options added to the Parser are matched in the order they are 
+        /// specified, wherever they are, and the handler is called for each
+        /// Option, value and positional argument. Nothing is stored: no 
+        /// Param is populated, and PosParams and the MultiPosParam aren't 
+        /// consulted, so it is up to the handler to check whether enough 
+        /// positional arguments were given. For example:
+        ///
+        ///     class PathHandler : public ParseHandler
+        ///     {
+        ///         bool PositionalSeen(std::string_view path, 
+        ///             std::size_t argIndex) override
+        ///         {
+        ///             return Process(path);
+        ///         }
+        ///     };
+        ///
+        ///     DescriptorSource source{ 0, '\0' };
+        ///     PathHandler handler;
+        ///     parser.Parse(source, handler);
+        ///
+        /// The first argument is the program name, which is skipped. The 
+        /// arguments the Parser was constructed with aren't used. As with
+        /// Parse(), arguments after the end-of-options marker are always
+        /// positional, and parsing stops after a short-circuit Option, even
+        /// one after an invalid argument (see ParseCursor).
+        ///
+        /// @param source The source of the arguments, including the program
+        /// name.
+        /// @param handler The handler to call as each argument is parsed.
+        /// @return Success if every argument read was valid, even if the 
+        /// handler stopped parsing, otherwise failure.
+        /// @post LastError() describes the failure, if any.
+        Status Parse(ArgSource& source, ParseHandler& handler);
+
+        /// @brief Creates a ParseCursor for pulling parsed items from an 
+        /// ArgSource one at a time.
+        ///
+        /// The cursor matches the Options added to the Parser, so the 
+        /// Parser must outlive it. Like parsing with a ParseHandler, nothing
+        /// is stored and the arguments the Parser was constructed with 
+        /// aren't used.
+        ///
+        /// @param source The source of the arguments, including the program
+        /// name.
+        /// @return The cursor.
+        ParseCursor Cursor(ArgSource& source) const
+        {
+            return ParseCursor{ mOptions, source };
+        }
+
+        /// @brief Takes a snapshot of what the last Parse() populated.
+        ///
+        /// Records the ProgParam, each Option in the order added, each 
+        /// PosParam and the MultiPosParam, so a worker can attach a 
+        /// ParseSnapshot to the data instead of parsing the same arguments
+        /// again.
+        ///
+        /// @return The snapshot.
+        std::vector<char> Snapshot() const;
+
+        /// @brief Gets the error that made the last Parse() fail.
+        ///
+        /// @return The error, whose kind is ParseError::Kind::None if the
+        /// last Parse() succeeded or Parse() hasn't been called.
+        const ParseError& LastError() const { return mLastError; }
+
         /// @brief Generates program usage info.
         ///
         /// Generates program usage info from each command line Param 
@@ -181,12 +298,18 @@ namespace CmdLine
         /// This method will also accept pointers of the derived class 
         /// ValueOption.
         /// 
+        /// Duplicates are detected from the prefixed names the Option has
+        /// when it is added, so adding n Options takes O(n) time overall.
+        /// 
         /// @param o The Option pointer to add to the Parser.
         /// @pre The Option pointer must not be null.
         /// @pre The Option must not be a duplicate.
+        /// @return The error that prevented the Option being added, if the
+        /// library is built without exceptions (see Error).
         /// @post The Option is added to the Parser.
+        /// @exception NullParameter The Option is null.
         /// @exception DuplicateOption Tried to add a duplicate Option.
-        void Add(Option* o);
+        Error Add(Option* o);
 
         /// @brief Adds a PosParam to the Parser.
         ///
@@ -197,9 +320,12 @@ namespace CmdLine
         /// @param p The PosParam pointer to add to the Parser.
         /// @pre The PosParam pointer must not be null.
         /// @pre The PosParam must not be a duplicate.
+        /// @return The error that prevented the PosParam being added, if the
+        /// library is built without exceptions (see Error).
         /// @post The PosParam is added to the Parser.
+        /// @exception NullParameter The PosParam is null.
         /// @exception DuplicatePosParam Tried to add duplicate PosParam.
-        void Add(PosParam* p);
+        Error Add(PosParam* p);
 
         /// @brief Sets a MultiPosParam on the Parser.
         ///
@@ -209,8 +335,33 @@ namespace CmdLine
         /// MultiPosParam. 
         /// 
         /// @param p The pointer to the MultiPosParam to set on the Parser.
+        /// @return The error that prevented the MultiPosParam being set, if
+        /// the library is built without exceptions (see Error).
         /// @post Parser MultiPosParam is either set or cleared (nulltpr).
-        void Set(MultiPosParam* p) { mMultiPosParam = p; }
+        Error Set(MultiPosParam* p);
+
+        /// @brief Sets the ParseObserver to notify while parsing.
+        ///
+        /// The observer is notified as each ParsePhase starts and finishes
+        /// and around each call to ArgParam::Populate(), e.g. so that a
+        /// ParseProfiler can work out where the time spent parsing goes.
+        /// Observers are ignored when the library is built with 
+        /// CMD_LINE_NO_PARSE_OBSERVERS defined.
+        /// 
+        /// @param o The ParseObserver to notify, or nullptr for none.
+        /// @post The ParseObserver is notified of any subsequent parsing.
+        void Set(ParseObserver* o) { mObserver = o; }
+
+        /// @brief Sets the ParseTrace to record parsing decisions in.
+        ///
+        /// Each time the Parser asks an ArgParam whether it can populate
+        /// from the next argument, the decision is recorded in the trace.
+        /// Nothing is recorded unless the library is built with 
+        /// CMD_LINE_PARSE_TRACE defined (see ParseTraceEnabled()).
+        /// 
+        /// @param t The ParseTrace to record in, or nullptr for none.
+        /// @post Decisions made by any subsequent parsing are recorded.
+        void Set(ParseTrace* t) { mTrace = t; }
 
         /// @brief Sets the Option::Style on all options added to the Parser.
         ///
@@ -220,10 +371,20 @@ namespace CmdLine
         /// have been added to the Parser for the sake of consistency. That
         /// is the purpose of this method.
         /// 
+        /// Options that had different names in their old styles can share
+        /// one in the new Style, e.g. a short name and another Option's one
+        /// letter long name are both prefixed with '/' in the Windows style.
+        /// Such duplicates are reported like they are by Add().
+        /// 
         /// @param s The Option::Style to set on each Option.
         /// @pre All Options must already be added to the Parser
+        /// @return The error reporting duplicate names in the new Style, if
+        /// the library is built without exceptions (see Error).
         /// @post All Options have their Option::Style changed.
-        void Set(Option::Style s);
+        /// @post Duplicates are checked against the newly prefixed names.
+        /// @exception DuplicateOption Two Options have the same name in the
+        /// new Style.
+        Error Set(Option::Style s);
 
         /// @brief Checks that all mandatory Param were specified.
         /// 
@@ -270,6 +431,49 @@ namespace CmdLine
         /// @post The argument queue is emptied.
         Status PopulateArgParams();
 
+        /// @brief Populates only the ProgParam and short-circuit Option.
+        ///
+        /// @return Status::Success if successful, otherwise Status::Failure.
+        /// @pre A short-circuit Option was found by FillArgQueue().
+        Status PopulateShortCircuit();
+
+        /// @brief Looks for a short-circuit Option after a bad argument.
+        ///
+        /// Only called once parsing is already going to fail, so that a
+        /// short-circuit Option still takes effect, e.g. help is still shown
+        /// for a command line with a mistake in it. Stops at the 
+        /// end-of-options marker.
+        ///
+        /// @param source The argument queue being scanned for options.
+        /// @param from Where in the source to start looking.
+        /// @return True if a short-circuit Option was found, otherwise false.
+        bool FindShortCircuit(std::deque<std::string>& source, 
+            std::deque<std::string>::iterator from);
+
+        /// @brief Populates the positional ArgParams from the rest of the
+        /// arguments without checking them.
+        ///
+        /// Called once the front of the argument queue is an operand, i.e.
+        /// an argument after the end-of-options marker. Options are queued
+        /// before positional arguments, so every argument left is positional
+        /// and fills the remaining PosParams in order, then the 
+        /// MultiPosParam, with no prefix checks or CanPopulate() probing.
+        ///
+        /// @return Status::Success if successful, otherwise Status::Failure.
+        /// @post The argument queue is emptied.
+        Status PopulateOperands();
+
+        /// @brief Determines if the MultiPosParam should take the rest of 
+        /// the arguments as operands.
+        ///
+        /// True when the arguments left include operands and none of those
+        /// before the end-of-options marker are options, so that positional
+        /// arguments on both sides of the marker go to the MultiPosParam.
+        ///
+        /// @return True if PopulateOperands() should populate the 
+        /// MultiPosParam, otherwise false.
+        bool MultiPosParamTakesOperands() const;
+
         /// @brief Moves all options from the source queue to mArgQueue.
         ///
         /// Moves all option arguments from the source argument queue
@@ -277,12 +481,17 @@ namespace CmdLine
         /// take a working copy of the original argument list as a queue
         /// and move all the options from the working queue to the
         /// internal argument queue so that all the options are together
-        /// in the internal argument queue.
+        /// in the internal argument queue. Options may appear anywhere in
+        /// the source queue, including after positional arguments. Each
+        /// argument is visited once, so this takes O(n) time. Scanning stops
+        /// at the end-of-options marker, which is dropped; every argument
+        /// after it stays in the source unchecked, as an operand.
         ///
         /// @param source The arugment queue to move options from.
         /// @return Status::Success if successful, otherwise Status::Failure.
         /// @pre The elements of source queue are copied from mArgs.
         /// @post The option arguments are moved from source to mArgQueue.
+        /// @post The source queue keeps its positional args in order.
         Status MoveOptionsToArgQueue(std::deque<std::string>& source);
 
         /// @brief Moves positional args from the source queue to mArgQueue.
@@ -340,14 +549,93 @@ namespace CmdLine
         /// @return A string with the plain usage text.
         std::string GeneratePlainUsage() const;
 
+        /// @brief Notifies the ParseObserver, if any, that a phase started.
+        ///
+        /// @param p The ParsePhase that started.
+        void NotifyPhaseStarted(ParsePhase p);
+
+        /// @brief Notifies the ParseObserver, if any, that a phase finished.
+        ///
+        /// @param p The ParsePhase that finished.
+        void NotifyPhaseFinished(ParsePhase p);
+
+        /// @brief Populates an ArgParam, notifying the ParseObserver if any.
+        ///
+        /// @param p The ArgParam to populate from mArgQueue.
+        /// @return The result of ArgParam::Populate().
+        bool Populate(ArgParam* p);
+
+        /// @brief Determines if mMultiPosParam can view the arguments left.
+        ///
+        /// The arguments left in mArgQueue are copies of a run of mArgs 
+        /// when they came from consecutive positions on the command line. 
+        /// With a ParsingOrder of End, positional arguments are queued in 
+        /// order, so checking where the first and last came from is enough.
+        ///
+        /// @return True if mMultiPosParam IsLazy() and can be populated
+        /// with a view of mArgs, otherwise false.
+        bool CanPopulateView() const;
+
+        /// @brief Populates mMultiPosParam with a view of the arguments left.
+        ///
+        /// @return The result of MultiPosParam::PopulateView().
+        /// @pre CanPopulateView() is true.
+        /// @post mArgQueue is emptied.
+        bool PopulateView();
+
+        /// @brief Notifies the ParseObserver, if any, around populating.
+        ///
+        /// @param p The ArgParam being populated.
+        /// @param populate Populates p, returning whether it succeeded.
+        /// @return The result of populate.
+        template<typename F>
+        bool Observe(ArgParam* p, F populate)
+        {
+#ifndef CMD_LINE_NO_PARSE_OBSERVERS
+            if (mObserver != nullptr)
+            {
+                mObserver->PopulateStarted(*p);
+                bool populated = populate();
+                mObserver->PopulateFinished(*p, populated);
+                return populated;
+            }
+#endif
+            return populate();
+        }
+
+        /// @brief Gets the command line position of the next argument.
+        ///
+        /// @return The position of the argument at the front of mArgQueue.
+        /// @pre mArgQueue isn't empty.
+        std::size_t FrontOrigin() const;
+
+        /// @brief Records why parsing failed.
+        ///
+        /// @param k The kind of failure.
+        /// @param argIndex The position of the argument on the command line.
+        /// @param expected The ArgParam expected to populate, if any.
+        /// @return Status::Failure, so the caller can return the result.
+        Status Fail(ParseError::Kind k, std::size_t argIndex, 
+            const ArgParam* expected = nullptr);
+
         std::vector<std::string> mArgs;
+        std::vector<std::size_t> mArgOrigins;
+        std::size_t mEndOfOptions;
+        Option* mShortCircuit;
+        std::size_t mShortCircuitOrigin;
+        std::size_t mShortCircuitArgs;
         std::vector<ArgParam*> mArgParams;
         std::vector<Option*> mOptions;
         std::vector<PosParam*> mPosParams;
+        std::unordered_set<std::string> mOptionNames;
         std::deque<std::string> mArgQueue;
         MultiPosParam* mMultiPosParam;
         ProgParam* mProgParam;
         std::unique_ptr<Option> mBuiltInHelpOption;
+        ParseObserver* mObserver;
+        ParseTrace* mTrace;
+        ParseError mLastError;
+        Error mConstructionError;
     };
 }
 
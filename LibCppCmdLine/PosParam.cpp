@@ -22,7 +22,10 @@ namespace CmdLine
         : mDefinition{ d }, mIsSpecified{ false }
     {
         if (!IsValidNonOptionName(mDefinition.name))
-            throw InvalidDefinition(nameError);
+        {
+            mConstructionError = Raise<InvalidDefinition>(
+                ErrorCode::InvalidDefinition, nameError);
+        }
     }
 
     std::string PosParam::HelpInfo() const
@@ -45,6 +48,17 @@ namespace CmdLine
         }    
     }
 
+    bool PosParam::PopulateOperand(std::deque<std::string>& args)
+    {
+        if (mIsSpecified || args.empty())
+            return false;
+
+        mValue = std::move(args.front());
+        args.pop_front();
+        mIsSpecified = true;
+        return true;
+    }
+
     bool PosParam::CanPopulate(const std::deque<std::string>& args) const
     {
         if (mIsSpecified)
@@ -18,6 +18,7 @@
 #define CMD_LINE_POS_PARAM_H
 
 #include <string>
+#include <utility>
 #include "ArgParam.h"
 #include "Validation.h"
 #include "Help.h"
@@ -152,6 +153,21 @@ namespace CmdLine
         /// @return True if the arguments can populate, otherwise false.
         bool CanPopulate(const std::deque<std::string>& args) const override;
 
+        /// @brief Populates this PosParam from an operand.
+        ///
+        /// An operand is an argument after the end-of-options marker, which
+        /// is positional even if it looks like an Option, e.g. a file named
+        /// "-v". Unlike Populate(), the argument isn't checked at all, but a
+        /// derived class may still refuse it, which fails the parse.
+        /// 
+        /// @param args The arguments to populate the PosParam with.
+        /// @return True if population is successful, otherwise false.
+        /// @pre Size of arguments >= 1.
+        /// @pre The PosParam isn't already specified.
+        /// @post The PosParam is marked specified.
+        /// @post The the next argument in the argument queue is removed.
+        virtual bool PopulateOperand(std::deque<std::string>& args);
+
         /// @brief Gets the number of arguments the PosParam consumes.
         ///
         /// Each Positional consumes exactly 1 argument.
@@ -0,0 +1,83 @@
+// Probe.cpp - Defines the functions for probing arguments for an Option.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include "Probe.h"
+
+namespace
+{
+    // Scans the arguments after the program name for the last occurrence of
+    // an Option, taking the argument after it as its value if it has one.
+    template<typename Args>
+    CmdLine::ProbeResult ProbeArgs(const Args& args, std::size_t count, 
+        const CmdLine::Option::Definition& d, bool hasValue)
+    {
+        CmdLine::ProbeResult result;
+        for (std::size_t i = 1; i < count; i++)
+        {
+            std::string_view arg{ args[i] };
+            if (arg == CmdLine::endOfOptionsMarker)
+                break;
+
+            if (!CmdLine::MatchesOption(arg, d))
+                continue;
+
+            if (!hasValue)
+            {
+                result.isSpecified = true;
+                result.argIndex = i;
+                continue;
+            }
+
+            if (i + 1 == count)
+                break;
+
+            result.isSpecified = true;
+            result.argIndex = i;
+            result.value = args[++i];
+        }
+
+        return result;
+    }
+}
+
+namespace CmdLine
+{
+    ProbeResult Probe(int argc, const char* const* argv, 
+        const Option::Definition& d)
+    {
+        return ProbeArgs(argv, static_cast<std::size_t>(argc > 0 ? argc : 0), 
+            d, false);
+    }
+
+    ProbeResult Probe(int argc, const char* const* argv, 
+        const ValueOption::Definition& d)
+    {
+        return ProbeArgs(argv, static_cast<std::size_t>(argc > 0 ? argc : 0), 
+            d, true);
+    }
+
+    ProbeResult Probe(const std::vector<std::string>& args, 
+        const Option::Definition& d)
+    {
+        return ProbeArgs(args, args.size(), d, false);
+    }
+
+    ProbeResult Probe(const std::vector<std::string>& args, 
+        const ValueOption::Definition& d)
+    {
+        return ProbeArgs(args, args.size(), d, true);
+    }
+}
@@ -0,0 +1,103 @@
+// Probe.h - Declares the functions for probing arguments for an Option.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_PROBE_H
+#define CMD_LINE_PROBE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Option.h"
+#include "ValueOption.h"
+
+namespace CmdLine
+{
+    /// @brief What probing the arguments found out about an Option.
+    struct ProbeResult
+    {
+        /// @brief Whether the Option was specified.
+        bool isSpecified{ false };
+
+        /// @brief The value of a ValueOption, from its last occurrence.
+        ///
+        /// Refers to the probed arguments, so it's only valid as long as 
+        /// they are. Always empty for an Option.
+        std::string_view value;
+
+        /// @brief The index of the Option's last occurrence in the 
+        /// arguments, 0 if it wasn't specified.
+        std::size_t argIndex{ 0 };
+    };
+
+    /// @brief Probes the arguments for an Option without parsing them.
+    ///
+    /// Some settings, such as verbosity or the log level, are needed before 
+    /// the rest of a program's Params are even defined. Probing scans the
+    /// arguments once for a single Option, without a Parser or ProgParam
+    /// and without allocating. For example:
+    ///
+    ///     int main(int argc, char** argv)
+    ///     {
+    ///         ValueOption::Definition logLevelDef;
+    ///         logLevelDef.longName = "log-level";
+    ///         ProbeResult logLevel = Probe(argc, argv, logLevelDef);
+    ///         if (logLevel.isSpecified)
+    ///             SetUpLogging(logLevel.value);
+    ///
+    /// Scanning stops at the end-of-options marker. Probing can't know 
+    /// which other arguments are values of other ValueOptions, so an
+    /// argument that is really another option's value is still taken as 
+    /// the Option.
+    ///
+    /// @param argc The number of arguments, including the program name.
+    /// @param argv The arguments, as passed to main().
+    /// @param d The definition of the Option to probe for.
+    /// @return What was found.
+    ProbeResult Probe(int argc, const char* const* argv, 
+        const Option::Definition& d);
+
+    /// @brief Probes the arguments for a ValueOption without parsing them.
+    ///
+    /// Like probing for an Option, but the argument after each occurrence
+    /// is taken as its value. An occurrence without a value, i.e. as the
+    /// last argument, isn't counted, just as it would fail to parse.
+    ///
+    /// @param argc The number of arguments, including the program name.
+    /// @param argv The arguments, as passed to main().
+    /// @param d The definition of the ValueOption to probe for.
+    /// @return What was found, including the value.
+    ProbeResult Probe(int argc, const char* const* argv, 
+        const ValueOption::Definition& d);
+
+    /// @brief Probes the arguments for an Option without parsing them.
+    ///
+    /// @param args The arguments, including the program name.
+    /// @param d The definition of the Option to probe for.
+    /// @return What was found.
+    ProbeResult Probe(const std::vector<std::string>& args, 
+        const Option::Definition& d);
+
+    /// @brief Probes the arguments for a ValueOption without parsing them.
+    ///
+    /// @param args The arguments, including the program name.
+    /// @param d The definition of the ValueOption to probe for.
+    /// @return What was found, including the value.
+    ProbeResult Probe(const std::vector<std::string>& args, 
+        const ValueOption::Definition& d);
+}
+
+#endif
@@ -0,0 +1,120 @@
+// RecordReader.cpp - Defines the RecordReader class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#include "RecordReader.h"
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace CmdLine
+{
+    RecordReader::RecordReader(int fd, char delimiter, std::size_t chunkSize,
+        bool keepEmpty)
+        : mFd{ fd }, mDelimiter{ delimiter }, 
+        mBuffer(chunkSize > 0 ? chunkSize : defaultRecordChunkSize), 
+        mBegin{ 0 }, mScanned{ 0 }, mEnd{ 0 }, mIsAtEnd{ false }, 
+        mFailed{ false }, mKeepsEmpty{ keepEmpty }
+    {
+    }
+
+    bool RecordReader::Next(std::string_view& record)
+    {
+        while (true)
+        {
+            // Only the bytes read since the last search are searched, so a
+            // record spanning many chunks is still only scanned once.
+            const char* data = mBuffer.data();
+            const void* found = std::memchr(data + mScanned, mDelimiter, 
+                mEnd - mScanned);
+
+            if (found != nullptr)
+            {
+                std::size_t end = static_cast<const char*>(found) - data;
+                record = MakeRecord(mBegin, end);
+                mBegin = end + 1;
+                mScanned = mBegin;
+                if (record.empty() && !mKeepsEmpty)
+                    continue;
+
+                return true;
+            }
+
+            mScanned = mEnd;
+            if (mIsAtEnd)
+            {
+                record = MakeRecord(mBegin, mEnd);
+                mBegin = mEnd;
+                return !record.empty();
+            }
+
+            ReadChunk();
+        }
+    }
+
+    void RecordReader::ReadChunk()
+    {
+        if (mBegin > 0)
+        {
+            std::memmove(mBuffer.data(), mBuffer.data() + mBegin, 
+                mEnd - mBegin);
+            mEnd -= mBegin;
+            mScanned -= mBegin;
+            mBegin = 0;
+        }
+
+        if (mEnd == mBuffer.size())
+            mBuffer.resize(mBuffer.size() * 2);
+
+        while (true)
+        {
+#ifdef _WIN32
+            int count = _read(mFd, mBuffer.data() + mEnd, 
+                static_cast<unsigned int>(mBuffer.size() - mEnd));
+#else
+            ssize_t count = read(mFd, mBuffer.data() + mEnd, 
+                mBuffer.size() - mEnd);
+#endif
+            if (count < 0 && errno == EINTR)
+                continue;
+
+            if (count < 0)
+                mFailed = true;
+
+            if (count <= 0)
+                mIsAtEnd = true;
+            else
+                mEnd += static_cast<std::size_t>(count);
+
+            return;
+        }
+    }
+
+    std::string_view RecordReader::MakeRecord(std::size_t begin, 
+        std::size_t end) const
+    {
+        if (mDelimiter == '\n' && end > begin && mBuffer[end - 1] == '\r')
+            end--;
+
+        return std::string_view{ mBuffer.data() + begin, end - begin };
+    }
+}
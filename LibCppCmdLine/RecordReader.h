@@ -0,0 +1,108 @@
+// RecordReader.h - Declares the RecordReader class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_RECORD_READER_H
+#define CMD_LINE_RECORD_READER_H
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace CmdLine
+{
+    /// @brief The size of the chunks a RecordReader reads by default.
+    constexpr std::size_t defaultRecordChunkSize = 64 * 1024;
+
+    /// @brief Reads delimited records from a file descriptor.
+    ///
+    /// Programs fed arguments by a pipeline, e.g. "find -print0 | tool -",
+    /// read them as records separated by a delimiter, usually a NUL or a 
+    /// newline. A RecordReader reads the descriptor in large chunks and
+    /// hands out each record as a view into its buffer as soon as the 
+    /// record is complete, so memory use is bounded by the longest record
+    /// rather than the input, and the first record can be processed before
+    /// the input ends. For example:
+    ///
+    ///     RecordReader reader{ 0, '\0' };
+    ///     std::string_view path;
+    ///     while (reader.Next(path))
+    ///         Process(path);
+    ///
+    /// Empty records are skipped unless the RecordReader is asked to keep 
+    /// them, as it must be when each record is an argument that may be 
+    /// empty. Either way the input ending after a delimiter doesn't add an
+    /// empty record. When records are separated by newlines, a carriage 
+    /// return before the newline isn't part of the record.
+    class RecordReader
+    {
+    public:
+        /// @brief Constructs a new RecordReader.
+        ///
+        /// The descriptor isn't closed by the RecordReader.
+        ///
+        /// @param fd The file descriptor to read, e.g. 0 for stdin.
+        /// @param delimiter The character that ends each record.
+        /// @param chunkSize How many bytes to read at a time.
+        /// @param keepEmpty Whether empty records are handed out.
+        RecordReader(int fd, char delimiter, 
+            std::size_t chunkSize = defaultRecordChunkSize, 
+            bool keepEmpty = false);
+
+        /// @brief Gets the next record.
+        ///
+        /// Blocks until a whole record has been read or the input ends. The
+        /// last record doesn't need a delimiter after it.
+        ///
+        /// @param record Set to the record, which is only valid until the
+        /// next call.
+        /// @return True if there was a record, false at the end of the input
+        /// or if reading failed.
+        bool Next(std::string_view& record);
+
+        /// @brief Determines if reading the descriptor failed.
+        ///
+        /// @return True if a read failed, otherwise false.
+        bool Failed() const { return mFailed; }
+    private:
+        int mFd;
+        char mDelimiter;
+        std::vector<char> mBuffer;
+        std::size_t mBegin;
+        std::size_t mScanned;
+        std::size_t mEnd;
+        bool mIsAtEnd;
+        bool mFailed;
+        bool mKeepsEmpty;
+
+        /// @brief Reads the next chunk into the buffer.
+        ///
+        /// Moves the incomplete record at the end of the buffer to the
+        /// front first, and grows the buffer if that record fills it.
+        ///
+        /// @post mIsAtEnd is set if there was nothing left to read.
+        void ReadChunk();
+
+        /// @brief Makes a record from part of the buffer.
+        ///
+        /// @param begin Where the record starts in the buffer.
+        /// @param end Where the record ends in the buffer.
+        /// @return The record.
+        std::string_view MakeRecord(std::size_t begin, std::size_t end) const;
+    };
+}
+
+#endif
@@ -0,0 +1,186 @@
+// ResponseFile.cpp - Defines the ResponseFile class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#include "ResponseFile.h"
+
+#include <cstring>
+#include <memory>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CMD_LINE_MAPPED_RESPONSE_FILES
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <sstream>
+#endif
+
+namespace CmdLine
+{
+    ResponseFile::ResponseFile(const std::string& path)
+        : mData{ nullptr }, mSize{ 0 }, mIsMapped{ false }
+    {
+        if (!Load(path))
+        {
+            mConstructionError = Raise<Unreadable>(
+                ErrorCode::UnreadableResponseFile, unreadableResponseFileError);
+            return;
+        }
+
+        Tokenize();
+    }
+
+    ResponseFile::~ResponseFile()
+    {
+#ifdef CMD_LINE_MAPPED_RESPONSE_FILES
+        if (mIsMapped)
+            munmap(const_cast<char*>(mData), mSize);
+#endif
+    }
+
+    bool ResponseFile::Load(const std::string& path)
+    {
+#ifdef CMD_LINE_MAPPED_RESPONSE_FILES
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat status;
+        if (fstat(fd, &status) != 0 || !S_ISREG(status.st_mode))
+        {
+            close(fd);
+            return false;
+        }
+
+        // An empty file can't be mapped, but it has no arguments anyway.
+        mSize = static_cast<std::size_t>(status.st_size);
+        if (mSize == 0)
+        {
+            close(fd);
+            return true;
+        }
+
+        void* data = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED)
+            return false;
+
+        // The file is scanned once from start to end.
+        madvise(data, mSize, MADV_SEQUENTIAL);
+
+        mData = static_cast<const char*>(data);
+        mIsMapped = true;
+        return true;
+#else
+        std::ifstream file{ path, std::ios::binary };
+        if (!file)
+            return false;
+
+        std::stringstream contents;
+        contents << file.rdbuf();
+        mContents = contents.str();
+        mData = mContents.data();
+        mSize = mContents.size();
+        return true;
+#endif
+    }
+
+    void ResponseFile::Tokenize()
+    {
+        const char* line = mData;
+        const char* end = mData + mSize;
+
+        while (line < end)
+        {
+            // memchr() is usually vectorized, so finding each line break 
+            // costs far less than comparing the characters one at a time.
+            const void* found = std::memchr(line, '\n', end - line);
+            const char* lineEnd = found != nullptr 
+                ? static_cast<const char*>(found) : end;
+
+            std::size_t length = lineEnd - line;
+            if (length > 0 && line[length - 1] == '\r')
+                length--;
+
+            if (length > 0)
+                mArgs.emplace_back(line, length);
+
+            line = lineEnd + 1;
+        }
+    }
+
+    Error ExpandResponseFiles(std::vector<std::string>& args)
+    {
+        // Every file is read before any argument is replaced, so that the
+        // expanded arguments can be allocated at once and the arguments are
+        // left as they were if a file can't be read.
+        std::vector<std::unique_ptr<ResponseFile>> files;
+        std::size_t expandedSize = args.size();
+        for (std::size_t i = 1; i < args.size(); i++)
+        {
+            if (args[i] == endOfOptionsMarker)
+                break;
+
+            if (args[i].size() < 2 || args[i][0] != responseFilePrefix)
+                continue;
+
+            files.push_back(std::make_unique<ResponseFile>(args[i].substr(1)));
+            if (files.back()->ConstructionError().code != ErrorCode::None)
+                return files.back()->ConstructionError();
+
+            expandedSize += files.back()->Args().size();
+            expandedSize--;
+        }
+
+        if (files.empty())
+            return Error{};
+
+        std::vector<std::string> expanded;
+        expanded.reserve(expandedSize);
+        expanded.push_back(std::move(args.front()));
+
+        auto file = files.begin();
+        bool afterMarker = false;
+        for (std::size_t i = 1; i < args.size(); i++)
+        {
+            afterMarker = afterMarker || args[i] == endOfOptionsMarker;
+
+            const bool isResponseFile = !afterMarker && args[i].size() >= 2 && 
+                args[i][0] == responseFilePrefix;
+            if (!isResponseFile)
+            {
+                expanded.push_back(std::move(args[i]));
+                continue;
+            }
+
+            for (std::string_view arg : (*file)->Args())
+                expanded.emplace_back(arg);
+
+            file++;
+        }
+
+        args = std::move(expanded);
+        return Error{};
+    }
+
+    ResponseFile::Unreadable::Unreadable(const char* message)
+        : runtime_error(message)
+    {
+    }
+}
@@ -0,0 +1,132 @@
+// ResponseFile.h - Declares the ResponseFile class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_RESPONSE_FILE_H
+#define CMD_LINE_RESPONSE_FILE_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Constants.h"
+#include "Error.h"
+
+namespace CmdLine
+{
+    /// @brief The arguments stored in a response file.
+    ///
+    /// A program passed more arguments than the system allows on a command
+    /// line, e.g. hundreds of thousands of paths for a MultiPosParam, can
+    /// instead be passed "@path", where the file at path holds the 
+    /// arguments one per line. Empty lines are ignored and a trailing 
+    /// carriage return is removed from each line, so files written on 
+    /// Windows read the same.
+    ///
+    /// Where the system supports it the file is memory mapped rather than
+    /// read, and each argument is a view of its line in the mapping, so
+    /// reading a response file costs one mapping and one scan for line
+    /// breaks no matter how many arguments it holds. The views are only
+    /// valid as long as the ResponseFile is, which is why it can't be 
+    /// copied or moved. See ExpandResponseFiles() for passing the 
+    /// arguments to a Parser.
+    class ResponseFile
+    {
+    public:
+        /// @brief An exception thrown for a response file that can't be 
+        /// read.
+        class Unreadable : public std::runtime_error
+        {
+        public:
+            /// @brief Constructs an Unreadable exception.
+            ///
+            /// @param message The message to include with the exception.
+            Unreadable(const char* message);
+        };
+
+        /// @brief Constructs a new ResponseFile.
+        ///
+        /// @param path The path of the file, without the "@" prefix.
+        /// @exception Unreadable The file couldn't be opened or read.
+        ResponseFile(const std::string& path);
+
+        /// @brief Unmaps the file.
+        ~ResponseFile();
+
+        ResponseFile(const ResponseFile&) = delete;
+        ResponseFile& operator=(const ResponseFile&) = delete;
+
+        /// @brief Gets the error that occurred reading the file.
+        ///
+        /// Only a library built without exceptions records an error here; 
+        /// otherwise the constructor throws it instead (see Error).
+        ///
+        /// @return The error, whose code is ErrorCode::None if the file was
+        /// read.
+        const Error& ConstructionError() const { return mConstructionError; }
+
+        /// @brief Gets the arguments in the file.
+        ///
+        /// @return A view of each argument, in the order they are in.
+        const std::vector<std::string_view>& Args() const { return mArgs; }
+    private:
+        const char* mData;
+        std::size_t mSize;
+        bool mIsMapped;
+        std::string mContents;
+        std::vector<std::string_view> mArgs;
+        Error mConstructionError;
+
+        /// @brief Maps the file into memory, or reads it where mapping isn't
+        /// supported.
+        ///
+        /// @param path The path of the file.
+        /// @return True if successful, otherwise false.
+        /// @post mData and mSize refer to the contents of the file.
+        bool Load(const std::string& path);
+
+        /// @brief Splits the contents of the file into arguments.
+        ///
+        /// @post mArgs has a view of each non-empty line.
+        void Tokenize();
+    };
+
+    /// @brief Replaces each response file argument with the arguments in 
+    /// the file.
+    ///
+    /// Every argument after the program name that starts with "@", up to 
+    /// the end-of-options marker, is replaced in place with the arguments
+    /// in the ResponseFile it names. Arguments read from a response file
+    /// are not expanded again. Expansion is opt-in so that programs with 
+    /// arguments that really do start with "@" are unaffected. For example:
+    ///
+    ///     std::vector<std::string> args{ argv, argv + argc };
+    ///     ExpandResponseFiles(args);
+    ///     Parser parser{ &program, args };
+    ///
+    /// Each file is only scanned once, and the expanded arguments are 
+    /// allocated all at once.
+    ///
+    /// @param args The arguments to expand, including the program name.
+    /// @return The error that prevented expansion, if the library is built
+    /// without exceptions (see Error).
+    /// @post The arguments are unchanged if any file couldn't be read.
+    /// @exception ResponseFile::Unreadable A file couldn't be read.
+    Error ExpandResponseFiles(std::vector<std::string>& args);
+}
+
+#endif
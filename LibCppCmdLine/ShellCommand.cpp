@@ -0,0 +1,257 @@
+// ShellCommand.cpp - Defines the ShellCommand class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#include "ShellCommand.h"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CMD_LINE_SSE2_SCAN
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace
+{
+    // The bytes that end or quote an argument outside quotes.
+    constexpr char unquotedSpecials[]{ " \t\n'\"\\" };
+
+    // The bytes that end or quote part of an argument inside double quotes.
+    constexpr char doubleQuotedSpecials[]{ "\"\\" };
+
+    /// @brief Determines if a character separates arguments.
+    ///
+    /// @param c The character.
+    /// @return True if the character is a space, tab or newline.
+    bool IsBlank(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n';
+    }
+
+    /// @brief Finds the first of a set of bytes in a range.
+    ///
+    /// Compares 16 bytes at a time where SSE2 is available, then the bytes
+    /// left one at a time.
+    ///
+    /// @tparam N The size of the set, including its null terminator.
+    /// @param first The start of the range.
+    /// @param last The end of the range.
+    /// @param bytes The set of bytes to find.
+    /// @return The first byte in the set, or last if there isn't one.
+    template<std::size_t N>
+    const char* FindFirstOf(const char* first, const char* last,
+        const char (&bytes)[N])
+    {
+#ifdef CMD_LINE_SSE2_SCAN
+        __m128i patterns[N - 1];
+        for (std::size_t i = 0; i < N - 1; i++)
+            patterns[i] = _mm_set1_epi8(bytes[i]);
+
+        while (last - first >= 16)
+        {
+            __m128i block = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(first));
+            __m128i matches = _mm_cmpeq_epi8(block, patterns[0]);
+            for (std::size_t i = 1; i < N - 1; i++)
+                matches = _mm_or_si128(matches, 
+                    _mm_cmpeq_epi8(block, patterns[i]));
+
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(matches));
+            if (mask != 0)
+            {
+#ifdef _MSC_VER
+                unsigned long index;
+                _BitScanForward(&index, mask);
+                return first + index;
+#else
+                return first + __builtin_ctz(mask);
+#endif
+            }
+
+            first += 16;
+        }
+#endif
+        for (; first < last; first++)
+        {
+            for (std::size_t i = 0; i < N - 1; i++)
+            {
+                if (*first == bytes[i])
+                    return first;
+            }
+        }
+
+        return last;
+    }
+}
+
+namespace CmdLine
+{
+    ShellCommand::ShellCommand(std::string_view command)
+        : mCommand{ command }
+    {
+        if (!Tokenize())
+        {
+            mArgs.clear();
+            mConstructionError = Raise<UnterminatedQuote>(
+                ErrorCode::UnterminatedQuote, unterminatedQuoteError);
+        }
+    }
+
+    bool ShellCommand::Tokenize()
+    {
+        const char* next = mCommand.data();
+        const char* end = next + mCommand.size();
+
+        // The argument being split out stays a view of the command until a 
+        // second piece is added to it; only then is it copied.
+        std::string_view view;
+        std::size_t copyOffset{ 0 };
+        bool isCopied{ false };
+        bool isArg{ false };
+
+        auto append = [&](const char* first, const char* last)
+        {
+            if (first == last)
+                return;
+
+            isArg = true;
+            if (!isCopied && view.empty())
+            {
+                view = std::string_view{ first, 
+                    static_cast<std::size_t>(last - first) };
+                return;
+            }
+
+            if (!isCopied)
+            {
+                // Unescaping never makes the command longer, so with its 
+                // size reserved the buffer is never reallocated and the 
+                // views of it stay valid.
+                if (mUnescaped.capacity() < mCommand.size())
+                    mUnescaped.reserve(mCommand.size());
+
+                copyOffset = mUnescaped.size();
+                mUnescaped.append(view);
+                isCopied = true;
+            }
+
+            mUnescaped.append(first, last);
+        };
+
+        while (true)
+        {
+            while (next < end && IsBlank(*next))
+                next++;
+
+            if (next == end)
+                return true;
+
+            view = std::string_view{};
+            isCopied = false;
+            isArg = false;
+
+            while (next < end && !IsBlank(*next))
+            {
+                const char* special = 
+                    FindFirstOf(next, end, unquotedSpecials);
+                append(next, special);
+                next = special;
+
+                if (next == end || IsBlank(*next))
+                    break;
+
+                if (*next == '\'')
+                {
+                    const void* close = 
+                        std::memchr(next + 1, '\'', end - next - 1);
+                    if (close == nullptr)
+                        return false;
+
+                    isArg = true;
+                    append(next + 1, static_cast<const char*>(close));
+                    next = static_cast<const char*>(close) + 1;
+                }
+                else if (*next == '"')
+                {
+                    isArg = true;
+                    next++;
+                    while (true)
+                    {
+                        special = 
+                            FindFirstOf(next, end, doubleQuotedSpecials);
+                        if (special == end)
+                            return false;
+
+                        append(next, special);
+                        next = special + 1;
+                        if (*special == '"')
+                            break;
+
+                        if (next == end)
+                            return false;
+
+                        // A backslash only quotes the characters that are 
+                        // special inside double quotes; before any other 
+                        // character it is kept.
+                        char quoted = *next;
+                        if (quoted == '$' || quoted == '`' || 
+                            quoted == '"' || quoted == '\\')
+                            append(next, next + 1);
+                        else if (quoted != '\n')
+                            append(special, next + 1);
+
+                        next++;
+                    }
+                }
+                else if (next + 1 == end)
+                {
+                    // As in the shell, a backslash ending the command is 
+                    // kept.
+                    append(next, end);
+                    next = end;
+                }
+                else if (next[1] == '\n')
+                {
+                    next += 2;
+                }
+                else
+                {
+                    append(next + 1, next + 2);
+                    next += 2;
+                }
+            }
+
+            if (isCopied)
+            {
+                mArgs.emplace_back(mUnescaped.data() + copyOffset, 
+                    mUnescaped.size() - copyOffset);
+            }
+            else if (isArg)
+            {
+                mArgs.push_back(view);
+            }
+        }
+    }
+
+    ShellCommand::UnterminatedQuote::UnterminatedQuote(const char* message)
+        : invalid_argument(message)
+    {
+    }
+}
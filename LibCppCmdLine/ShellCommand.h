@@ -0,0 +1,105 @@
+// ShellCommand.h - Declares the ShellCommand class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_SHELL_COMMAND_H
+#define CMD_LINE_SHELL_COMMAND_H
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Constants.h"
+#include "Error.h"
+
+namespace CmdLine
+{
+    /// @brief The arguments of a command line stored as a single string.
+    ///
+    /// Splits a command line, e.g. one a scheduler stores for a job, into 
+    /// arguments the way a POSIX shell does: unquoted blanks (spaces, tabs 
+    /// and newlines) separate arguments, a backslash quotes the character 
+    /// after it, everything between single quotes is literal, and between 
+    /// double quotes a backslash only quotes $, `, ", \ and a newline. A 
+    /// backslash followed by a newline outside single quotes is removed. 
+    /// Nothing is expanded: $, `, *, ~, # and operators such as ; and | are 
+    /// kept as they are. For example:
+    ///
+    ///     ShellCommand command{ "cp -v 'My Song.mp3' \"$HOME\"/music" };
+    ///     ShellCommandSource source{ command };
+    ///     Parser parser{ &program, source };
+    ///
+    /// gives cp the arguments -v, My Song.mp3 and $HOME/music.
+    ///
+    /// The command is scanned for the bytes that end or quote an argument 
+    /// 16 at a time where SSE2 is available. An argument that needs no 
+    /// unescaping, including one that is entirely inside a single pair of 
+    /// quotes, is a view of the command itself; only arguments that do are 
+    /// copied, into a buffer allocated once. The command must therefore 
+    /// outlive the ShellCommand, and the ShellCommand can't be copied or 
+    /// moved.
+    class ShellCommand
+    {
+    public:
+        /// @brief An exception thrown for a command with a quote that isn't
+        /// closed.
+        class UnterminatedQuote : public std::invalid_argument
+        {
+        public:
+            /// @brief Constructs an UnterminatedQuote exception.
+            ///
+            /// @param message The message to include with the exception.
+            UnterminatedQuote(const char* message);
+        };
+
+        /// @brief Constructs a new ShellCommand.
+        ///
+        /// @param command The command line to split into arguments.
+        /// @post Args() is empty if a quote isn't closed.
+        /// @exception UnterminatedQuote A quote in the command isn't closed.
+        ShellCommand(std::string_view command);
+
+        ShellCommand(const ShellCommand&) = delete;
+        ShellCommand& operator=(const ShellCommand&) = delete;
+
+        /// @brief Gets the error that occurred splitting the command.
+        ///
+        /// Only a library built without exceptions records an error here; 
+        /// otherwise the constructor throws it instead (see Error).
+        ///
+        /// @return The error, whose code is ErrorCode::None if the command 
+        /// was split.
+        const Error& ConstructionError() const { return mConstructionError; }
+
+        /// @brief Gets the arguments in the command.
+        ///
+        /// @return A view of each argument, in the order they are in.
+        const std::vector<std::string_view>& Args() const { return mArgs; }
+    private:
+        std::string_view mCommand;
+        std::string mUnescaped;
+        std::vector<std::string_view> mArgs;
+        Error mConstructionError;
+
+        /// @brief Splits the command into arguments.
+        ///
+        /// @return True if successful, false if a quote isn't closed.
+        /// @post mArgs has a view of each argument.
+        bool Tokenize();
+    };
+}
+
+#endif
@@ -16,7 +16,7 @@
 
 #include "Validation.h"
 
-bool CmdLine::IsValidNonOptionName(std::string name)
+bool CmdLine::IsValidNonOptionName(std::string_view name)
 {
     if (name.size() > maxNameSize || name.size() < minNameSize)
         return false;
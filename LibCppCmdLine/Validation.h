@@ -18,6 +18,7 @@
 #define CMD_LINE_VALIDATION_H
 
 #include <string>
+#include <string_view>
 #include "Constants.h"
 
 namespace CmdLine
@@ -33,7 +34,7 @@ namespace CmdLine
     /// 
     /// @param name The name to evaluate.
     /// @return True if the name is valid, otherwise false.
-    bool IsValidNonOptionName(std::string name);
+    bool IsValidNonOptionName(std::string_view name);
 }
 
 #endif
\ No newline at end of file
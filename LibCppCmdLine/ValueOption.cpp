@@ -32,35 +32,33 @@ namespace CmdLine
             args.pop_front();
             mValues.push_back(value);
 
-            try
+            // Even if the option's value does not represent a 
+            // NameValuePair, we can still return true because the 
+            // ValueOption was successfully populated with the value. Checking
+            // first rather than catching NameValuePair::InvalidPair keeps
+            // this working when the library is built without exceptions.
+            if (!IsNameValuePair(value))
+                return true;
+
+            // We know the ValueOption has populated successfully at this
+            // point, so now we try to parse the value as a name-value
+            // pair. 
+            auto pair = std::make_unique<NameValuePair>(value);
+            for (auto p : mParams)
             {
-                // We know the ValueOption has populated successfully at this
-                // point, so now we try to parse the value as a name-value
-                // pair. 
-                auto pair = std::make_unique<NameValuePair>(value);
-                for (auto p : mParams)
+                if (p->CanPopulate(*pair))
                 {
-                    if (p->CanPopulate(*pair))
-                    {
-                        p->Populate(*pair);
-
-                        // Once we've found an OptionParam to populate, we can
-                        // return true to end the loop early to save cycles. 
-                        return true;
-                    }
-                }
+                    p->Populate(*pair);
 
-                // Even if no OptionParams were populated, the ValueOption
-                // itself was so we can still return true. 
-                return true;
-            }
-            catch (NameValuePair::InvalidPair& e)
-            {
-                // Even if the option's value does not represent a 
-                // NameValuePair, we can still return true because the 
-                // ValueOption was successfully populated with the value.
-                return true;
+                    // Once we've found an OptionParam to populate, we can
+                    // return true to end the loop early to save cycles. 
+                    return true;
+                }
             }
+
+            // Even if no OptionParams were populated, the ValueOption
+            // itself was so we can still return true. 
+            return true;
         }
         else
         {
@@ -94,18 +92,31 @@ namespace CmdLine
         return help.str();
     }
 
-    void ValueOption::Add(OptionParam* p)
+    Error ValueOption::Add(OptionParam* p)
     {
         if (p == nullptr)
-            throw NullOptionParam{ nullOptionParamError };
+        {
+            return Raise<NullOptionParam>(ErrorCode::NullOptionParam, 
+                nullOptionParamError);
+        }
+
+        // Only a library built without exceptions can have an invalid 
+        // OptionParam to add.
+        if (p->ConstructionError().code != ErrorCode::None)
+            return p->ConstructionError();
 
         for (auto param : mParams)
         {
             if (param->Name() == p->Name())
-                throw DuplicateOptionParam{ duplicateOptionParamError };
+            {
+                return Raise<DuplicateOptionParam>(
+                    ErrorCode::DuplicateOptionParam, 
+                    duplicateOptionParamError);
+            }
         }
 
         mParams.push_back(p);
+        return Error{};
     }
 
     ValueOption::DuplicateOptionParam::DuplicateOptionParam(
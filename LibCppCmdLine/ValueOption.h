@@ -165,12 +165,14 @@ namespace CmdLine
         /// specified. 
         /// 
         /// @param p The OptionParam pointer to add
-        /// @return True if the add operation was successful, otherwise false.
+        /// @return The error that prevented the OptionParam being added, if
+        /// the library is built without exceptions (see Error).
         /// @pre The OptionParam pointer must not be null.
         /// @pre A duplicate OptionParam must not have already been added.
         /// @post The OptionParam is added to the ValueOption.
+        /// @exception NullOptionParam The OptionParam is null.
         /// @exception DuplicateOptionParam Tried to add duplicate OptionParam.
-        void Add(OptionParam* p);
+        Error Add(OptionParam* p);
     private:
         std::vector<std::string> mValues;
         std::vector<OptionParam*> mParams;
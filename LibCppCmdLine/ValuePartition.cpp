@@ -0,0 +1,38 @@
+// ValuePartition.cpp - Defines the ValuePartition class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#include "ValuePartition.h"
+
+#include <thread>
+
+namespace CmdLine
+{
+    ValuePartition::ValuePartition(ArgView values, std::size_t chunkSize)
+        : mValues{ values }, mChunkSize{ chunkSize }
+    {
+        if (mChunkSize != 0)
+            return;
+
+        // hardware_concurrency() is 0 when it can't be determined.
+        std::size_t threads = std::thread::hardware_concurrency();
+        std::size_t chunks = (threads == 0 ? 1 : threads) * 
+            defaultChunksPerThread;
+        mChunkSize = (mValues.Size() + chunks - 1) / chunks;
+        if (mChunkSize == 0)
+            mChunkSize = 1;
+    }
+}
@@ -0,0 +1,210 @@
+// ValuePartition.h - Declares the ValuePartition class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_VALUE_PARTITION_H
+#define CMD_LINE_VALUE_PARTITION_H
+
+#include <cstddef>
+#include <iterator>
+#include "ArgView.h"
+
+namespace CmdLine
+{
+    /// @brief The number of chunks per hardware thread a ValuePartition
+    /// splits values into by default.
+    ///
+    /// More chunks than threads lets threads that finish early take work
+    /// from those that don't, e.g. when some files take longer to process.
+    constexpr std::size_t defaultChunksPerThread = 16;
+
+    /// @brief A view of values split into chunks for parallel processing.
+    ///
+    /// Splits an ArgView, e.g. MultiPosParam::ValueView(), into chunks of
+    /// consecutive values. Each chunk is itself an ArgView, so the values
+    /// are never copied. Iterating the chunks of a partition works with 
+    /// the parallel algorithms, and a WorkerPool shares them between its 
+    /// threads. For example:
+    ///
+    ///     ValuePartition chunks{ files.ValueView() };
+    ///     std::for_each(std::execution::par, chunks.begin(), chunks.end(),
+    ///         [](ArgView chunk) 
+    ///         { 
+    ///             for (std::string_view path : chunk) 
+    ///                 Process(path); 
+    ///         });
+    ///
+    /// The values themselves are an ArgView too, so they can also be 
+    /// handed to a parallel algorithm one at a time.
+    class ValuePartition
+    {
+    public:
+        /// @brief An iterator over the chunks of a ValuePartition.
+        class Iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = ArgView;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = ArgView;
+
+            Iterator() : mPartition{ nullptr }, mChunk{ 0 } { }
+
+            Iterator(const ValuePartition* partition, std::size_t chunk)
+                : mPartition{ partition }, mChunk{ chunk }
+            { }
+
+            reference operator*() const { return (*mPartition)[mChunk]; }
+
+            reference operator[](difference_type n) const 
+            { 
+                return (*mPartition)[mChunk + n]; 
+            }
+
+            Iterator& operator++() { ++mChunk; return *this; }
+
+            Iterator operator++(int) 
+            { 
+                return Iterator{ mPartition, mChunk++ }; 
+            }
+
+            Iterator& operator--() { --mChunk; return *this; }
+
+            Iterator operator--(int) 
+            { 
+                return Iterator{ mPartition, mChunk-- }; 
+            }
+
+            Iterator& operator+=(difference_type n) 
+            { 
+                mChunk += n; 
+                return *this; 
+            }
+
+            Iterator& operator-=(difference_type n) 
+            { 
+                mChunk -= n; 
+                return *this; 
+            }
+
+            Iterator operator+(difference_type n) const 
+            { 
+                return Iterator{ mPartition, mChunk + n }; 
+            }
+
+            friend Iterator operator+(difference_type n, Iterator i)
+            {
+                return i + n;
+            }
+
+            Iterator operator-(difference_type n) const 
+            { 
+                return Iterator{ mPartition, mChunk - n }; 
+            }
+
+            difference_type operator-(Iterator other) const 
+            { 
+                return static_cast<difference_type>(mChunk - other.mChunk); 
+            }
+
+            bool operator==(Iterator other) const 
+            { 
+                return mChunk == other.mChunk; 
+            }
+
+            bool operator!=(Iterator other) const 
+            { 
+                return mChunk != other.mChunk; 
+            }
+
+            bool operator<(Iterator other) const 
+            { 
+                return mChunk < other.mChunk; 
+            }
+
+            bool operator>(Iterator other) const 
+            { 
+                return mChunk > other.mChunk; 
+            }
+
+            bool operator<=(Iterator other) const 
+            { 
+                return mChunk <= other.mChunk; 
+            }
+
+            bool operator>=(Iterator other) const 
+            { 
+                return mChunk >= other.mChunk; 
+            }
+        private:
+            const ValuePartition* mPartition;
+            std::size_t mChunk;
+        };
+
+        /// @brief Constructs a new ValuePartition.
+        ///
+        /// @param values The values to split into chunks.
+        /// @param chunkSize The largest number of values in a chunk, or 0
+        /// for defaultChunksPerThread chunks per hardware thread.
+        ValuePartition(ArgView values, std::size_t chunkSize = 0);
+
+        /// @brief Gets the values that are split into chunks.
+        ///
+        /// @return The values.
+        ArgView Values() const { return mValues; }
+
+        /// @brief Gets the largest number of values in a chunk.
+        ///
+        /// Every chunk but the last has this many values.
+        ///
+        /// @return The chunk size, which is at least 1.
+        std::size_t ChunkSize() const { return mChunkSize; }
+
+        /// @brief Gets the number of chunks.
+        ///
+        /// @return The number of chunks, which is 0 if there are no values.
+        std::size_t Size() const 
+        { 
+            return (mValues.Size() + mChunkSize - 1) / mChunkSize; 
+        }
+
+        /// @brief Gets a chunk.
+        ///
+        /// @param i The index of the chunk.
+        /// @return The values in the chunk.
+        /// @pre The index is less than Size().
+        ArgView operator[](std::size_t i) const
+        {
+            return mValues.Subview(i * mChunkSize, mChunkSize);
+        }
+
+        /// @brief Gets an iterator to the first chunk.
+        ///
+        /// @return The iterator.
+        Iterator begin() const { return Iterator{ this, 0 }; }
+
+        /// @brief Gets an iterator past the last chunk.
+        ///
+        /// @return The iterator.
+        Iterator end() const { return Iterator{ this, Size() }; }
+    private:
+        ArgView mValues;
+        std::size_t mChunkSize;
+    };
+}
+
+#endif
@@ -0,0 +1,233 @@
+// WorkerPool.cpp - Defines the WorkerPool class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#include "WorkerPool.h"
+
+#include <utility>
+
+namespace
+{
+    /// @brief Packs a range of chunks into a WorkerPool share.
+    ///
+    /// @param begin The index of the first chunk.
+    /// @param end The index past the last chunk.
+    /// @return The packed range.
+    std::uint64_t Pack(std::uint64_t begin, std::uint64_t end)
+    {
+        return (begin << 32) | end;
+    }
+
+    /// @brief Gets the index of the first chunk of a packed range.
+    std::uint64_t Begin(std::uint64_t share) { return share >> 32; }
+
+    /// @brief Gets the index past the last chunk of a packed range.
+    std::uint64_t End(std::uint64_t share) { return share & 0xFFFFFFFF; }
+}
+
+namespace CmdLine
+{
+    WorkerPool::WorkerPool(std::size_t threadCount)
+        : mThreadCount{ threadCount }, mGeneration{ 0 }, mRunning{ 0 }, 
+          mStopping{ false }, mPartition{ nullptr }, mFunction{ nullptr }, 
+          mCancelled{ false }
+    {
+        // hardware_concurrency() is 0 when it can't be determined.
+        if (mThreadCount == 0)
+            mThreadCount = std::thread::hardware_concurrency();
+        if (mThreadCount == 0)
+            mThreadCount = 1;
+
+        mShares = std::make_unique<Share[]>(mThreadCount);
+        for (std::size_t i = 0; i < mThreadCount; i++)
+            mShares[i].store(0);
+
+        // The calling thread works on the first share.
+        mThreads.reserve(mThreadCount - 1);
+        for (std::size_t i = 1; i < mThreadCount; i++)
+            mThreads.emplace_back([this, i] { Work(i); });
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{ mMutex };
+            mStopping = true;
+        }
+
+        mStart.notify_all();
+        for (auto& t : mThreads)
+            t.join();
+    }
+
+    void WorkerPool::ForEachChunk(const ValuePartition& partition,
+        const std::function<void(ArgView)>& f)
+    {
+        std::size_t chunks = partition.Size();
+        if (chunks == 0)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock{ mMutex };
+            for (std::size_t i = 0; i < mThreadCount; i++)
+            {
+                mShares[i].store(Pack(chunks * i / mThreadCount, 
+                    chunks * (i + 1) / mThreadCount));
+            }
+
+            mPartition = &partition;
+            mFunction = &f;
+            mCancelled.store(false);
+            mError = nullptr;
+            mRunning = mThreads.size();
+            mGeneration++;
+        }
+
+        mStart.notify_all();
+        ProcessChunks(0);
+
+        {
+            std::unique_lock<std::mutex> lock{ mMutex };
+            mDone.wait(lock, [this] { return mRunning == 0; });
+            mPartition = nullptr;
+            mFunction = nullptr;
+        }
+
+#ifndef CMD_LINE_NO_EXCEPTIONS
+        if (mError)
+            std::rethrow_exception(std::exchange(mError, nullptr));
+#endif
+    }
+
+    void WorkerPool::ForEach(const ValuePartition& partition,
+        const std::function<void(std::string_view)>& f)
+    {
+        ForEachChunk(partition, [&f](ArgView chunk)
+        {
+            for (std::string_view value : chunk)
+                f(value);
+        });
+    }
+
+    void WorkerPool::Work(std::size_t index)
+    {
+        std::size_t generation = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock{ mMutex };
+                mStart.wait(lock, [this, generation] 
+                { 
+                    return mStopping || mGeneration != generation; 
+                });
+
+                if (mStopping)
+                    return;
+
+                generation = mGeneration;
+            }
+
+            ProcessChunks(index);
+
+            std::lock_guard<std::mutex> lock{ mMutex };
+            if (--mRunning == 0)
+                mDone.notify_one();
+        }
+    }
+
+    void WorkerPool::ProcessChunks(std::size_t index)
+    {
+        std::size_t chunk = 0;
+        while (!mCancelled.load(std::memory_order_relaxed))
+        {
+            if (!TakeChunk(index, chunk))
+            {
+                if (!StealChunks(index))
+                    return;
+
+                continue;
+            }
+
+#ifdef CMD_LINE_NO_EXCEPTIONS
+            (*mFunction)((*mPartition)[chunk]);
+#else
+            try
+            {
+                (*mFunction)((*mPartition)[chunk]);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock{ mMutex };
+                if (!mError)
+                    mError = std::current_exception();
+                mCancelled.store(true);
+            }
+#endif
+        }
+    }
+
+    bool WorkerPool::TakeChunk(std::size_t index, std::size_t& chunk)
+    {
+        Share& share = mShares[index];
+        std::uint64_t range = share.load();
+        while (Begin(range) < End(range))
+        {
+            if (share.compare_exchange_weak(range, 
+                Pack(Begin(range) + 1, End(range))))
+            {
+                chunk = static_cast<std::size_t>(Begin(range));
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool WorkerPool::StealChunks(std::size_t index)
+    {
+        for (;;)
+        {
+            Share* victim = nullptr;
+            std::uint64_t range = 0;
+            std::uint64_t largest = 0;
+            for (std::size_t i = 0; i < mThreadCount; i++)
+            {
+                std::uint64_t r = mShares[i].load();
+                if (i != index && End(r) > Begin(r) && 
+                    End(r) - Begin(r) > largest)
+                {
+                    victim = &mShares[i];
+                    range = r;
+                    largest = End(r) - Begin(r);
+                }
+            }
+
+            if (victim == nullptr)
+                return false;
+
+            // The victim keeps the front half, which it's working through,
+            // and a single chunk left is taken whole. Our own share is empty,
+            // so no other thread changes it while it's being replaced.
+            std::uint64_t middle = Begin(range) + largest / 2;
+            if (victim->compare_exchange_strong(range, 
+                Pack(Begin(range), middle)))
+            {
+                mShares[index].store(Pack(middle, End(range)));
+                return true;
+            }
+        }
+    }
+}
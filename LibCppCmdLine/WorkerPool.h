@@ -0,0 +1,141 @@
+// WorkerPool.h - Declares the WorkerPool class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_WORKER_POOL_H
+#define CMD_LINE_WORKER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "ArgView.h"
+#include "ValuePartition.h"
+
+namespace CmdLine
+{
+    /// @brief A pool of threads that process the chunks of a ValuePartition.
+    ///
+    /// Each thread starts with an equal share of the chunks and takes them
+    /// from the front of its share. A thread that runs out steals the back
+    /// half of the largest share left, so threads stay busy until every 
+    /// chunk is done even when some chunks take much longer than others.
+    /// The values are never copied. The threads are started once and reused
+    /// by every call, and the calling thread works too. For example:
+    ///
+    ///     WorkerPool pool;
+    ///     pool.ForEach(ValuePartition{ files.ValueView() }, 
+    ///         [](std::string_view path) { Process(path); });
+    ///
+    /// Only one call may run at a time. If the function throws, no more
+    /// chunks are started and the first exception is rethrown once the 
+    /// chunks already started have finished, unless the library is built 
+    /// without exceptions.
+    class WorkerPool
+    {
+    public:
+        /// @brief Constructs a new WorkerPool.
+        ///
+        /// @param threadCount The number of threads that process chunks,
+        /// including the calling thread, or 0 for one per hardware thread.
+        WorkerPool(std::size_t threadCount = 0);
+
+        /// @brief Stops the threads of the WorkerPool.
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        /// @brief Gets the number of threads that process chunks.
+        ///
+        /// @return The number of threads, including the calling thread.
+        std::size_t ThreadCount() const { return mThreadCount; }
+
+        /// @brief Calls a function with each chunk of a partition.
+        ///
+        /// Returns once every chunk has been processed. Chunks are processed
+        /// concurrently, in no particular order.
+        ///
+        /// @param partition The chunks to process.
+        /// @param f The function to call with each chunk.
+        /// @pre The partition has fewer than 2^32 chunks.
+        void ForEachChunk(const ValuePartition& partition, 
+            const std::function<void(ArgView)>& f);
+
+        /// @brief Calls a function with each value of a partition.
+        ///
+        /// Returns once every value has been processed. Values are processed
+        /// concurrently, but those in the same chunk are processed in order
+        /// by the same thread.
+        ///
+        /// @param partition The values to process.
+        /// @param f The function to call with each value.
+        /// @pre The partition has fewer than 2^32 chunks.
+        void ForEach(const ValuePartition& partition,
+            const std::function<void(std::string_view)>& f);
+    private:
+        /// @brief The range of chunks a thread has left, packed as the index
+        /// of the first in the high half and the end in the low half, so 
+        /// both change together.
+        using Share = std::atomic<std::uint64_t>;
+
+        std::size_t mThreadCount;
+        std::vector<std::thread> mThreads;
+        std::unique_ptr<Share[]> mShares;
+        std::mutex mMutex;
+        std::condition_variable mStart;
+        std::condition_variable mDone;
+        std::size_t mGeneration;
+        std::size_t mRunning;
+        bool mStopping;
+        const ValuePartition* mPartition;
+        const std::function<void(ArgView)>* mFunction;
+        std::atomic<bool> mCancelled;
+        std::exception_ptr mError;
+
+        /// @brief Waits for and works on each call until the pool stops.
+        ///
+        /// @param index The index of the thread's share.
+        void Work(std::size_t index);
+
+        /// @brief Processes chunks until none are left.
+        ///
+        /// @param index The index of the thread's share.
+        void ProcessChunks(std::size_t index);
+
+        /// @brief Takes the next chunk of a thread's own share.
+        ///
+        /// @param index The index of the thread's share.
+        /// @param chunk Set to the index of the chunk taken.
+        /// @return True if a chunk was taken, otherwise false.
+        bool TakeChunk(std::size_t index, std::size_t& chunk);
+
+        /// @brief Moves half of the largest share left to a thread's share.
+        ///
+        /// @param index The index of the thread's share.
+        /// @return True if any chunks were stolen, otherwise false.
+        bool StealChunks(std::size_t index);
+    };
+}
+
+#endif
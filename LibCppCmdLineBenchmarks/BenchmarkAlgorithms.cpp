@@ -0,0 +1,107 @@
+// BenchmarkAlgorithms.cpp - Defines algorithms shared by the benchmarks.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include "BenchmarkAlgorithms.h"
+
+namespace CmdLine
+{
+    std::vector<ArgumentShape> GenerateArgumentShapes()
+    {
+        const std::size_t longSize = 4096;
+        const std::string longName(longSize, 'a');
+
+        return std::vector<ArgumentShape>
+        {
+            { "unix_short_option", "-v" },
+            { "unix_long_option", "--verbose" },
+            { "windows_option", "/verbose" },
+            { "value", "album" },
+            { "name_value_pair", "artist=The Testers" },
+            { "relative_path", "data/media/Test1.mp3" },
+            { "windows_path", "/tmp/test/file" },
+            { "windows_drive_path", "C:/Users/test/file.txt" },
+            { "long_value", longName },
+            { "long_option", "--" + longName },
+            { "long_windows_path", "/" + longName + "/file" },
+            { "long_name_value_pair", longName + "=" + longName },
+            { "non_ascii_value", "\xc3\xa9t\xc3\xa9" },
+            { "non_ascii_option", "--\xc3\xa9t\xc3\xa9" },
+            { "non_ascii_high_bytes", "\xff\xfe\x80\x81" }
+        };
+    }
+
+    void SetArgumentCounters(benchmark::State& state,
+        std::size_t argsPerIteration, std::chrono::duration<double> elapsed)
+    {
+        const double args = static_cast<double>(argsPerIteration) *
+            static_cast<double>(state.iterations());
+        const double seconds = elapsed.count();
+
+        state.SetItemsProcessed(state.iterations() * argsPerIteration);
+
+        if (args == 0 || seconds == 0)
+            return;
+
+        state.counters["args/sec"] = args / seconds;
+        state.counters["ns/arg"] = seconds * 1e9 / args;
+    }
+
+    void SetAllocationCounters(benchmark::State& state,
+        const AllocationStats& stats)
+    {
+        if (!AllocationTrackingEnabled())
+            return;
+
+        state.counters["allocs"] = benchmark::Counter(
+            static_cast<double>(stats.allocations),
+            benchmark::Counter::kAvgIterations);
+
+        state.counters["alloc_bytes"] = benchmark::Counter(
+            static_cast<double>(stats.bytes),
+            benchmark::Counter::kAvgIterations);
+    }
+
+    void SetPerfCounters(benchmark::State& state, const PerfCounts& counts,
+        const std::string& unit, std::size_t unitsPerIteration)
+    {
+        if (state.iterations() == 0 || unitsPerIteration == 0)
+            return;
+
+        double units = static_cast<double>(state.iterations()) *
+            static_cast<double>(unitsPerIteration);
+
+        for (std::size_t i = 0; i < perfEventCount; i++)
+        {
+            if (!counts.available[i])
+                continue;
+
+            std::string name = PerfEventName(static_cast<PerfEvent>(i));
+            state.counters[name + "/" + unit] = 
+                static_cast<double>(counts.values[i]) / units;
+        }
+
+        std::size_t instructions = 
+            static_cast<std::size_t>(PerfEvent::Instructions);
+        std::size_t cycles = static_cast<std::size_t>(PerfEvent::Cycles);
+        if (counts.available[instructions] && counts.available[cycles] &&
+            counts.values[cycles] > 0)
+        {
+            state.counters["IPC"] = 
+                static_cast<double>(counts.values[instructions]) / 
+                static_cast<double>(counts.values[cycles]);
+        }
+    }
+}
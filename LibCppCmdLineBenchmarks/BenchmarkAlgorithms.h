@@ -0,0 +1,78 @@
+// BenchmarkAlgorithms.h - Declares algorithms shared by the benchmarks.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_BENCHMARK_ALGORITHMS_H
+#define CMD_LINE_BENCHMARK_ALGORITHMS_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include "benchmark/benchmark.h"
+#include "AllocationTracker.h"
+#include "BenchmarkDataStructures.h"
+#include "PerfCounters.h"
+
+namespace CmdLine
+{
+    /// @brief Generates example arguments of each shape worth benchmarking.
+    ///
+    /// Covers the typical shapes (short and long Unix options, Windows
+    /// options, plain values, name-value pairs and file paths) as well as
+    /// Windows-style / paths, pathologically long arguments and arguments
+    /// containing non-ASCII bytes.
+    ///
+    /// @return The argument shapes.
+    std::vector<ArgumentShape> GenerateArgumentShapes();
+
+    /// @brief Sets the throughput counters on a benchmark.
+    ///
+    /// Reports how many arguments were processed per second (args/sec) and
+    /// how long it took to process each argument in nanoseconds (ns/arg),
+    /// based on the total time measured across all iterations.
+    ///
+    /// @param state The benchmark state to set the counters on.
+    /// @param argsPerIteration The number of arguments in each iteration.
+    /// @param elapsed The total time measured across all iterations.
+    void SetArgumentCounters(benchmark::State& state,
+        std::size_t argsPerIteration, std::chrono::duration<double> elapsed);
+
+    /// @brief Sets the allocation counters on a benchmark.
+    ///
+    /// Reports the average number of heap allocations (allocs) and bytes
+    /// allocated (alloc_bytes) per iteration. Nothing is reported when
+    /// allocation tracking is not compiled in.
+    ///
+    /// @param state The benchmark state to set the counters on.
+    /// @param stats The heap allocations made across all iterations.
+    void SetAllocationCounters(benchmark::State& state,
+        const AllocationStats& stats);
+
+    /// @brief Sets the hardware performance counters on a benchmark.
+    ///
+    /// Reports each available PerfEvent per unit of work, e.g. 
+    /// instructions/arg, along with instructions per cycle (IPC) when both
+    /// are available. Nothing is reported for events that weren't counted.
+    ///
+    /// @param state The benchmark state to set the counters on.
+    /// @param counts The events counted across all iterations.
+    /// @param unit The name of the unit of work, e.g. "arg".
+    /// @param unitsPerIteration The units of work done in each iteration.
+    void SetPerfCounters(benchmark::State& state, const PerfCounts& counts,
+        const std::string& unit, std::size_t unitsPerIteration);
+}
+
+#endif
@@ -0,0 +1,420 @@
+// BenchmarkBaseline.cpp - Defines the benchmark baseline and comparator.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include <cmath>
+#include <limits>
+#include "BenchmarkBaseline.h"
+
+namespace
+{
+    using namespace CmdLine;
+
+    double NanosecondsPer(const std::string& timeUnit)
+    {
+        if (timeUnit == "ns")
+            return 1;
+        if (timeUnit == "us")
+            return 1e3;
+        if (timeUnit == "ms")
+            return 1e6;
+        if (timeUnit == "s")
+            return 1e9;
+
+        throw BenchmarkBaseline::InvalidBaseline{
+            "unknown time unit: " + timeUnit };
+    }
+
+    bool IsTracked(const TrackedMetric& m, const std::string& benchmark)
+    {
+        return benchmark.compare(0, m.benchmarkPrefix.size(),
+            m.benchmarkPrefix) == 0;
+    }
+
+    BenchmarkSamples& FindOrAdd(std::vector<BenchmarkSamples>& benchmarks,
+        const std::string& name)
+    {
+        for (auto& b : benchmarks)
+        {
+            if (b.name == name)
+                return b;
+        }
+
+        benchmarks.push_back(BenchmarkSamples{ name, {} });
+        return benchmarks.back();
+    }
+
+    const BenchmarkSamples* Find(
+        const std::vector<BenchmarkSamples>& benchmarks,
+        const std::string& name)
+    {
+        for (auto& b : benchmarks)
+        {
+            if (b.name == name)
+                return &b;
+        }
+
+        return nullptr;
+    }
+
+    double Mean(const std::vector<double>& values)
+    {
+        double sum = 0;
+        for (double v : values)
+            sum += v;
+        return sum / static_cast<double>(values.size());
+    }
+
+    double Variance(const std::vector<double>& values, double mean)
+    {
+        double sum = 0;
+        for (double v : values)
+            sum += (v - mean) * (v - mean);
+        return sum / static_cast<double>(values.size() - 1);
+    }
+
+    // Evaluates the continued fraction of the regularized incomplete beta
+    // function with the modified Lentz's method.
+    double IncompleteBetaFraction(double a, double b, double x)
+    {
+        const int maxIterations = 300;
+        const double epsilon = 1e-15;
+        const double tiny = 1e-300;
+
+        double c = 1;
+        double d = 1 - (a + b) * x / (a + 1);
+        if (std::fabs(d) < tiny)
+            d = tiny;
+        d = 1 / d;
+        double result = d;
+
+        for (int m = 1; m <= maxIterations; m++)
+        {
+            for (int step = 0; step < 2; step++)
+            {
+                double numerator = step == 0
+                    ? m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m))
+                    : -(a + m) * (a + b + m) * x /
+                        ((a + 2 * m) * (a + 2 * m + 1));
+
+                d = 1 + numerator * d;
+                if (std::fabs(d) < tiny)
+                    d = tiny;
+                c = 1 + numerator / c;
+                if (std::fabs(c) < tiny)
+                    c = tiny;
+                d = 1 / d;
+                result *= d * c;
+            }
+
+            if (std::fabs(d * c - 1) < epsilon)
+                break;
+        }
+
+        return result;
+    }
+
+    double RegularizedIncompleteBeta(double a, double b, double x)
+    {
+        if (x <= 0)
+            return 0;
+        if (x >= 1)
+            return 1;
+
+        double logFront = std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b)
+            + a * std::log(x) + b * std::log(1 - x);
+        double front = std::exp(logFront);
+
+        // The continued fraction converges quickly on only one side of the
+        // mean, so use the symmetry of the function on the other side.
+        if (x < (a + 1) / (a + b + 2))
+            return front * IncompleteBetaFraction(a, b, x) / a;
+        else
+            return 1 - front * IncompleteBetaFraction(b, a, 1 - x) / b;
+    }
+}
+
+namespace CmdLine
+{
+    std::vector<TrackedMetric> DefaultTrackedMetrics()
+    {
+        return std::vector<TrackedMetric>
+        {
+            { "BM_Parse/", "args/sec", MetricDirection::HigherIsBetter },
+            { "BM_Parse/", "allocs", MetricDirection::LowerIsBetter },
+            {
+                "BM_GenerateHelp/", "real_time", MetricDirection::LowerIsBetter
+            }
+        };
+    }
+
+    BenchmarkBaseline ReadBenchmarkResults(const JsonValue& results,
+        const std::vector<TrackedMetric>& tracked,
+        const std::string& libraryVersion)
+    {
+        if (!results.Contains("context") || !results.Contains("benchmarks"))
+        {
+            throw BenchmarkBaseline::InvalidBaseline{
+                "not a Google Benchmark JSON results file" };
+        }
+
+        BenchmarkBaseline baseline;
+        baseline.libraryVersion = libraryVersion;
+
+        try
+        {
+            const JsonValue& context = results["context"];
+            baseline.date = context["date"].AsString();
+            baseline.hostName = context["host_name"].AsString();
+            baseline.cpuCount = static_cast<int>(
+                context["num_cpus"].AsNumber());
+
+            // Google Benchmark only records its own build type, so the
+            // benchmarks add the build type of LibCppCmdLine itself.
+            baseline.buildType = context.Contains("libcppcmdline_build_type")
+                ? context["libcppcmdline_build_type"].AsString()
+                : context["library_build_type"].AsString();
+
+            for (const JsonValue& run : results["benchmarks"].Items())
+            {
+                if (run["run_type"].AsString() != "iteration")
+                    continue;
+                if (run.Contains("error_occurred") &&
+                    run["error_occurred"].AsBoolean())
+                {
+                    continue;
+                }
+
+                const std::string& name = run["run_name"].AsString();
+                for (const TrackedMetric& m : tracked)
+                {
+                    if (!IsTracked(m, name) || !run.Contains(m.metric))
+                        continue;
+
+                    double value = run[m.metric].AsNumber();
+                    if (m.metric == "real_time")
+                        value *= NanosecondsPer(run["time_unit"].AsString());
+
+                    FindOrAdd(baseline.benchmarks, name)
+                        .metrics[m.metric].push_back(value);
+                }
+            }
+        }
+        catch (JsonValue::TypeError& e)
+        {
+            throw BenchmarkBaseline::InvalidBaseline{
+                std::string{ "malformed benchmark results: " } + e.what() };
+        }
+
+        return baseline;
+    }
+
+    JsonValue ToJson(const BenchmarkBaseline& baseline)
+    {
+        JsonValue context = JsonValue::Object();
+        context.Set("date", baseline.date);
+        context.Set("host_name", baseline.hostName);
+        context.Set("num_cpus", static_cast<double>(baseline.cpuCount));
+        context.Set("build_type", baseline.buildType);
+
+        JsonValue benchmarks = JsonValue::Array();
+        for (const BenchmarkSamples& b : baseline.benchmarks)
+        {
+            JsonValue metrics = JsonValue::Object();
+            for (auto& m : b.metrics)
+            {
+                JsonValue samples = JsonValue::Array();
+                for (double value : m.second)
+                    samples.Append(value);
+                metrics.Set(m.first, std::move(samples));
+            }
+
+            JsonValue benchmark = JsonValue::Object();
+            benchmark.Set("name", b.name);
+            benchmark.Set("metrics", std::move(metrics));
+            benchmarks.Append(std::move(benchmark));
+        }
+
+        JsonValue json = JsonValue::Object();
+        json.Set("format_version",
+            static_cast<double>(baseline.formatVersion));
+        json.Set("library_version", baseline.libraryVersion);
+        json.Set("context", std::move(context));
+        json.Set("benchmarks", std::move(benchmarks));
+        return json;
+    }
+
+    BenchmarkBaseline BaselineFromJson(const JsonValue& json)
+    {
+        if (!json.Contains("format_version"))
+        {
+            throw BenchmarkBaseline::InvalidBaseline{
+                "not a benchmark baseline" };
+        }
+
+        BenchmarkBaseline baseline;
+
+        try
+        {
+            baseline.formatVersion = static_cast<int>(
+                json["format_version"].AsNumber());
+            if (baseline.formatVersion != baselineFormatVersion)
+            {
+                throw BenchmarkBaseline::InvalidBaseline{
+                    "unsupported baseline format version " +
+                    std::to_string(baseline.formatVersion) };
+            }
+
+            baseline.libraryVersion = json["library_version"].AsString();
+
+            const JsonValue& context = json["context"];
+            baseline.date = context["date"].AsString();
+            baseline.hostName = context["host_name"].AsString();
+            baseline.cpuCount = static_cast<int>(
+                context["num_cpus"].AsNumber());
+            baseline.buildType = context["build_type"].AsString();
+
+            for (const JsonValue& b : json["benchmarks"].Items())
+            {
+                BenchmarkSamples samples;
+                samples.name = b["name"].AsString();
+
+                for (auto& m : b["metrics"].GetMembers())
+                {
+                    for (const JsonValue& value : m.second.Items())
+                        samples.metrics[m.first].push_back(value.AsNumber());
+                }
+
+                baseline.benchmarks.push_back(std::move(samples));
+            }
+        }
+        catch (JsonValue::TypeError& e)
+        {
+            throw BenchmarkBaseline::InvalidBaseline{
+                std::string{ "malformed baseline: " } + e.what() };
+        }
+
+        return baseline;
+    }
+
+    WelchResult WelchTTest(const std::vector<double>& first,
+        const std::vector<double>& second)
+    {
+        WelchResult result;
+        if (first.size() < 2 || second.size() < 2)
+        {
+            result.pValue = std::numeric_limits<double>::quiet_NaN();
+            return result;
+        }
+
+        double n1 = static_cast<double>(first.size());
+        double n2 = static_cast<double>(second.size());
+        double mean1 = Mean(first);
+        double mean2 = Mean(second);
+        double error1 = Variance(first, mean1) / n1;
+        double error2 = Variance(second, mean2) / n2;
+        double standardError = std::sqrt(error1 + error2);
+
+        if (standardError == 0)
+        {
+            result.t = mean2 > mean1
+                ? std::numeric_limits<double>::infinity()
+                : mean2 < mean1 ? -std::numeric_limits<double>::infinity() : 0;
+            result.degreesOfFreedom = n1 + n2 - 2;
+            result.pValue = mean2 > mean1 ? 0 : 1;
+            return result;
+        }
+
+        result.t = (mean2 - mean1) / standardError;
+        result.degreesOfFreedom = (error1 + error2) * (error1 + error2) /
+            (error1 * error1 / (n1 - 1) + error2 * error2 / (n2 - 1));
+        result.pValue = StudentTUpperTail(result.t, result.degreesOfFreedom);
+        return result;
+    }
+
+    double StudentTUpperTail(double t, double degreesOfFreedom)
+    {
+        double x = degreesOfFreedom / (degreesOfFreedom + t * t);
+        double tail = 0.5 * RegularizedIncompleteBeta(
+            degreesOfFreedom / 2, 0.5, x);
+        return t >= 0 ? tail : 1 - tail;
+    }
+
+    std::vector<MetricComparison> CompareToBaseline(
+        const BenchmarkBaseline& baseline, const BenchmarkBaseline& current,
+        const std::vector<TrackedMetric>& tracked,
+        const ComparisonThresholds& thresholds)
+    {
+        std::vector<MetricComparison> comparisons;
+
+        for (const BenchmarkSamples& run : current.benchmarks)
+        {
+            const BenchmarkSamples* base = Find(baseline.benchmarks, run.name);
+            if (base == nullptr)
+                continue;
+
+            for (const TrackedMetric& m : tracked)
+            {
+                if (!IsTracked(m, run.name))
+                    continue;
+
+                auto before = base->metrics.find(m.metric);
+                auto after = run.metrics.find(m.metric);
+                if (before == base->metrics.end() ||
+                    after == run.metrics.end() || before->second.empty() ||
+                    after->second.empty())
+                {
+                    continue;
+                }
+
+                MetricComparison c;
+                c.benchmark = run.name;
+                c.metric = m.metric;
+                c.baselineMean = Mean(before->second);
+                c.currentMean = Mean(after->second);
+
+                // Orient both the change and the test so that worse is
+                // always positive.
+                bool lowerIsBetter = 
+                    m.direction == MetricDirection::LowerIsBetter;
+                double sign = lowerIsBetter ? 1 : -1;
+                double difference = c.currentMean - c.baselineMean;
+                if (c.baselineMean != 0)
+                    c.change = sign * difference / std::fabs(c.baselineMean);
+                else if (difference != 0)
+                    c.change = std::copysign(
+                        std::numeric_limits<double>::infinity(),
+                        sign * difference);
+
+                WelchResult worse = lowerIsBetter
+                    ? WelchTTest(before->second, after->second)
+                    : WelchTTest(after->second, before->second);
+                WelchResult better = lowerIsBetter
+                    ? WelchTTest(after->second, before->second)
+                    : WelchTTest(before->second, after->second);
+                c.pValue = worse.pValue;
+
+                c.regression = worse.pValue <= thresholds.significance &&
+                    c.change >= thresholds.minimumChange;
+                c.improvement = better.pValue <= thresholds.significance &&
+                    -c.change >= thresholds.minimumChange;
+
+                comparisons.push_back(c);
+            }
+        }
+
+        return comparisons;
+    }
+}
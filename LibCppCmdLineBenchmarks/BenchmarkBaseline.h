@@ -0,0 +1,246 @@
+// BenchmarkBaseline.h - Declares the benchmark baseline and comparator.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_BENCHMARK_BASELINE_H
+#define CMD_LINE_BENCHMARK_BASELINE_H
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Json.h"
+
+namespace CmdLine
+{
+    /// @brief The version of the baseline file format.
+    ///
+    /// Must be incremented whenever the format changes in a way older
+    /// versions of libcppcmdcompare can't read.
+    constexpr int baselineFormatVersion = 1;
+
+    /// @brief Determines which direction of change is a regression.
+    enum class MetricDirection
+    {
+        /// @brief Lower values are better, e.g. time or allocations.
+        LowerIsBetter,
+
+        /// @brief Higher values are better, e.g. throughput.
+        HigherIsBetter
+    };
+
+    /// @brief A benchmark metric whose regressions are tracked.
+    struct TrackedMetric
+    {
+        /// @brief The prefix of the names of the benchmarks to track.
+        std::string benchmarkPrefix;
+
+        /// @brief The name of the metric.
+        ///
+        /// Either "real_time", the wall clock time per iteration in
+        /// nanoseconds, or the name of a benchmark counter, e.g. "allocs".
+        std::string metric;
+
+        /// @brief Which direction of change is a regression.
+        MetricDirection direction{ MetricDirection::LowerIsBetter };
+    };
+
+    /// @brief Gets the metrics tracked by default.
+    ///
+    /// Tracks the parse throughput and allocations per parse of BM_Parse and
+    /// the help rendering time of BM_GenerateHelp.
+    ///
+    /// @return The tracked metrics.
+    std::vector<TrackedMetric> DefaultTrackedMetrics();
+
+    /// @brief The samples of the tracked metrics of one benchmark.
+    struct BenchmarkSamples
+    {
+        /// @brief The name of the benchmark, e.g. "BM_GenerateHelp/10".
+        std::string name;
+
+        /// @brief The value of each metric in each repetition, by metric.
+        std::map<std::string, std::vector<double>> metrics;
+    };
+
+    /// @brief The tracked metrics of a benchmark run.
+    ///
+    /// Baselines are stored in version control as JSON (see ToJson()), so
+    /// each one records the library version and the machine it was
+    /// measured on; comparing results measured on different machines or
+    /// build types isn't meaningful.
+    struct BenchmarkBaseline
+    {
+        /// @brief Exception thrown when a baseline or results are invalid.
+        class InvalidBaseline : public std::invalid_argument
+        {
+        public:
+            /// @brief Constructs a new InvalidBaseline.
+            ///
+            /// @param message Describes what is invalid.
+            InvalidBaseline(const std::string& message)
+                : std::invalid_argument{ message }
+            { }
+        };
+
+        /// @brief The version of the baseline file format.
+        int formatVersion{ baselineFormatVersion };
+
+        /// @brief The version of LibCppCmdLine that was measured.
+        std::string libraryVersion;
+
+        /// @brief When the benchmarks were run.
+        std::string date;
+
+        /// @brief The name of the machine the benchmarks ran on.
+        std::string hostName;
+
+        /// @brief The number of CPUs the machine has.
+        int cpuCount{ 0 };
+
+        /// @brief The build type of the benchmarked code, e.g. "release".
+        std::string buildType;
+
+        /// @brief The samples of each benchmark, in the order they ran.
+        std::vector<BenchmarkSamples> benchmarks;
+    };
+
+    /// @brief Reads the tracked metrics from Google Benchmark results.
+    ///
+    /// Reads a --benchmark_out JSON file, ideally produced with
+    /// --benchmark_repetitions so there are enough samples to test for
+    /// significance. Only iterations of benchmarks matching a tracked metric
+    /// are kept; aggregates and runs that failed are ignored. Times are
+    /// converted to nanoseconds.
+    ///
+    /// @param results The parsed results file.
+    /// @param tracked The metrics to read.
+    /// @param libraryVersion The version of LibCppCmdLine benchmarked.
+    /// @return The baseline of the run.
+    /// @exception InvalidBaseline Thrown if the results are malformed.
+    BenchmarkBaseline ReadBenchmarkResults(const JsonValue& results,
+        const std::vector<TrackedMetric>& tracked,
+        const std::string& libraryVersion);
+
+    /// @brief Converts a baseline to JSON.
+    ///
+    /// @param baseline The baseline to convert.
+    /// @return The JSON representation of the baseline.
+    JsonValue ToJson(const BenchmarkBaseline& baseline);
+
+    /// @brief Converts JSON written by ToJson() back to a baseline.
+    ///
+    /// @param json The JSON to convert.
+    /// @return The baseline.
+    /// @exception InvalidBaseline Thrown if the JSON isn't a baseline or its
+    /// format version isn't supported.
+    BenchmarkBaseline BaselineFromJson(const JsonValue& json);
+
+    /// @brief The result of Welch's unequal variances t-test.
+    struct WelchResult
+    {
+        /// @brief The t statistic.
+        double t{ 0 };
+
+        /// @brief The Welch-Satterthwaite degrees of freedom.
+        double degreesOfFreedom{ 0 };
+
+        /// @brief The one-sided p-value.
+        ///
+        /// The probability of a difference at least this large in favour of
+        /// the second sample having the greater mean if both really had the
+        /// same mean. NaN when either sample has fewer than two values.
+        double pValue{ 0 };
+    };
+
+    /// @brief Tests whether one sample's mean is greater than another's.
+    ///
+    /// Uses Welch's t-test, which doesn't assume both samples have the same
+    /// variance. When neither sample varies at all, as with allocation
+    /// counts, the p-value is 0 if the second mean is greater, otherwise 1.
+    ///
+    /// @param first The first sample.
+    /// @param second The sample tested for having the greater mean.
+    /// @return The result of the test.
+    WelchResult WelchTTest(const std::vector<double>& first,
+        const std::vector<double>& second);
+
+    /// @brief Gets the upper tail probability of Student's t-distribution.
+    ///
+    /// @param t The t statistic.
+    /// @param degreesOfFreedom The degrees of freedom, which must be positive.
+    /// @return The probability of a value greater than t.
+    double StudentTUpperTail(double t, double degreesOfFreedom);
+
+    /// @brief The thresholds a change must exceed to be a regression.
+    struct ComparisonThresholds
+    {
+        /// @brief The largest p-value that is statistically significant.
+        double significance{ 0.05 };
+
+        /// @brief The smallest relative change worth reporting, e.g. 0.05
+        /// for a 5% change.
+        ///
+        /// Keeps significant but negligible changes from being reported.
+        double minimumChange{ 0.05 };
+    };
+
+    /// @brief The comparison of one metric of one benchmark.
+    struct MetricComparison
+    {
+        /// @brief The name of the benchmark.
+        std::string benchmark;
+
+        /// @brief The name of the metric.
+        std::string metric;
+
+        /// @brief The mean of the metric in the baseline.
+        double baselineMean{ 0 };
+
+        /// @brief The mean of the metric in the current run.
+        double currentMean{ 0 };
+
+        /// @brief The relative change of the mean, positive when worse.
+        double change{ 0 };
+
+        /// @brief The one-sided p-value of the change being a regression.
+        double pValue{ 0 };
+
+        /// @brief Whether the change is a significant regression.
+        bool regression{ false };
+
+        /// @brief Whether the change is a significant improvement.
+        bool improvement{ false };
+    };
+
+    /// @brief Compares a benchmark run to a baseline.
+    ///
+    /// Compares every tracked metric of every benchmark that appears in
+    /// both. A change is a regression (or improvement) when it is at least
+    /// the minimum change in the worse (or better) direction and its
+    /// p-value is significant.
+    ///
+    /// @param baseline The baseline to compare to.
+    /// @param current The run to compare.
+    /// @param tracked The metrics to compare.
+    /// @param thresholds The thresholds for regressions and improvements.
+    /// @return The comparison of each metric, in the order of the run.
+    std::vector<MetricComparison> CompareToBaseline(
+        const BenchmarkBaseline& baseline, const BenchmarkBaseline& current,
+        const std::vector<TrackedMetric>& tracked,
+        const ComparisonThresholds& thresholds);
+}
+
+#endif
@@ -0,0 +1,211 @@
+// BenchmarkCompare.cpp - Defines the libcppcmdcompare program.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "CmdLine.h"
+#include "BenchmarkBaseline.h"
+#include "Json.h"
+
+// The exit codes of libcppcmdcompare.
+constexpr int noRegressions = 0;
+constexpr int regressionsFound = 1;
+constexpr int invalidInput = 2;
+
+/// @brief Reads and parses a JSON file.
+///
+/// @param path The path of the file.
+/// @return The parsed JSON.
+/// @exception std::runtime_error Thrown if the file can't be read.
+/// @exception CmdLine::JsonValue::ParseError Thrown if it isn't JSON.
+CmdLine::JsonValue ReadJsonFile(const std::string& path)
+{
+    std::ifstream file{ path, std::ios::binary };
+    if (!file)
+        throw std::runtime_error{ "cannot open " + path };
+
+    std::stringstream text;
+    text << file.rdbuf();
+    return CmdLine::JsonValue::Parse(text.str());
+}
+
+/// @brief Writes the comparison of a run to its baseline as a table.
+///
+/// @param comparisons The comparison of each metric.
+void PrintComparisons(
+    const std::vector<CmdLine::MetricComparison>& comparisons)
+{
+    int width = static_cast<int>(std::string{ "Benchmark" }.size());
+    for (auto& m : comparisons)
+        width = std::max(width, static_cast<int>(m.benchmark.size()));
+
+    std::printf("%-*s %-10s %14s %14s %9s %8s\n", width, "Benchmark",
+        "Metric", "Baseline", "Current", "Change", "p");
+
+    for (auto& m : comparisons)
+    {
+        const char* verdict = m.regression
+            ? "  REGRESSION" : m.improvement ? "  improved" : "";
+
+        std::printf("%-*s %-10s %14.6g %14.6g %+8.1f%% %8.3g%s\n", width,
+            m.benchmark.c_str(), m.metric.c_str(), m.baselineMean,
+            m.currentMean, m.change * 100, m.pValue, verdict);
+    }
+}
+
+/// @brief Warns about differences that make a comparison unreliable.
+///
+/// @param baseline The baseline.
+/// @param current The run compared to the baseline.
+void WarnIfNotComparable(const CmdLine::BenchmarkBaseline& baseline,
+    const CmdLine::BenchmarkBaseline& current)
+{
+    if (baseline.hostName != current.hostName ||
+        baseline.cpuCount != current.cpuCount)
+    {
+        std::cerr << "warning: the baseline was measured on "
+            << baseline.hostName << " (" << baseline.cpuCount
+            << " CPUs), not " << current.hostName << " ("
+            << current.cpuCount << " CPUs)" << std::endl;
+    }
+
+    if (baseline.buildType != current.buildType)
+    {
+        std::cerr << "warning: the baseline was measured in a "
+            << baseline.buildType << " build, not a " << current.buildType
+            << " build" << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace CmdLine;
+
+    ProgParam::Definition programDef;
+    programDef.name = "libcppcmdcompare";
+    programDef.description = "Records LibCppCmdLine benchmark results as a "
+        "baseline, or compares them to one and reports regressions.";
+    ProgParam program{ programDef };
+
+    Option::Definition recordDef;
+    recordDef.shortName = 'r';
+    recordDef.longName = "record";
+    recordDef.description = "writes the results to the baseline instead of "
+        "comparing them";
+    Option record{ recordDef };
+
+    ValueOption::Definition significanceDef;
+    significanceDef.shortName = 's';
+    significanceDef.longName = "significance";
+    significanceDef.description = "the largest p-value that is significant "
+        "(default 0.05)";
+    ValueOption significance{ significanceDef };
+
+    ValueOption::Definition minimumChangeDef;
+    minimumChangeDef.shortName = 'm';
+    minimumChangeDef.longName = "min-change";
+    minimumChangeDef.description = "the smallest relative change that is a "
+        "regression (default 0.05)";
+    ValueOption minimumChange{ minimumChangeDef };
+
+    PosParam::Definition resultsDef;
+    resultsDef.name = "RESULTS";
+    resultsDef.description = "the --benchmark_out JSON file of a "
+        "libcppcmdbench run";
+    resultsDef.isMandatory = true;
+    PosParam results{ resultsDef };
+
+    PosParam::Definition baselineDef;
+    baselineDef.name = "BASELINE";
+    baselineDef.description = "the baseline JSON file";
+    baselineDef.isMandatory = true;
+    PosParam baseline{ baselineDef };
+
+    Parser parser{ &program, std::vector<std::string>{ argv, argv + argc } };
+    parser.Add(&record);
+    parser.Add(&significance);
+    parser.Add(&minimumChange);
+    parser.Add(&results);
+    parser.Add(&baseline);
+
+    Parser::Status status = parser.Parse();
+    if (parser.BuiltInHelpOptionIsSpecified())
+    {
+        std::cout << parser.GenerateHelp();
+        return noRegressions;
+    }
+
+    if (status != Parser::Status::Success)
+    {
+        std::cerr << parser.GenerateUsage();
+        return invalidInput;
+    }
+
+    try
+    {
+        std::vector<TrackedMetric> tracked = DefaultTrackedMetrics();
+        BenchmarkBaseline current = ReadBenchmarkResults(
+            ReadJsonFile(results.Value()), tracked, CMD_LINE_VERSION);
+
+        if (record.IsSpecified())
+        {
+            std::ofstream file{ baseline.Value(), std::ios::binary };
+            file << ToJson(current).Serialize();
+            if (!file)
+                throw std::runtime_error{ "cannot write " + baseline.Value() };
+
+            std::cout << "Recorded " << current.benchmarks.size()
+                << " benchmarks to " << baseline.Value() << std::endl;
+            return noRegressions;
+        }
+
+        ComparisonThresholds thresholds;
+        if (significance.IsSpecified())
+            thresholds.significance = std::stod(significance.Values().back());
+        if (minimumChange.IsSpecified())
+            thresholds.minimumChange = std::stod(minimumChange.Values().back());
+
+        BenchmarkBaseline previous = BaselineFromJson(
+            ReadJsonFile(baseline.Value()));
+        WarnIfNotComparable(previous, current);
+
+        std::vector<MetricComparison> comparisons = CompareToBaseline(
+            previous, current, tracked, thresholds);
+        PrintComparisons(comparisons);
+
+        std::size_t regressions = 0;
+        for (auto& c : comparisons)
+            regressions += c.regression ? 1 : 0;
+
+        std::cout << std::endl << regressions << " regressions in "
+            << comparisons.size() << " metrics compared to the "
+            << previous.libraryVersion << " baseline from " << previous.date
+            << std::endl;
+
+        return regressions == 0 ? noRegressions : regressionsFound;
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "libcppcmdcompare: " << e.what() << std::endl;
+        return invalidInput;
+    }
+}
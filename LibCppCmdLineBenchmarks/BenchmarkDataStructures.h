@@ -0,0 +1,38 @@
+// BenchmarkDataStructures.h - Declares data structures for benchmarks.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_BENCHMARK_DATA_STRUCTURES_H
+#define CMD_LINE_BENCHMARK_DATA_STRUCTURES_H
+
+#include <string>
+
+namespace CmdLine
+{
+    /// @brief A named example of a command line argument shape.
+    ///
+    /// Used to benchmark the per-argument classification functions against
+    /// each kind of argument they are likely to be called with.
+    struct ArgumentShape
+    {
+        /// @brief The name used to label the benchmark for this shape.
+        std::string name;
+
+        /// @brief The example argument.
+        std::string arg;
+    };
+}
+
+#endif
@@ -0,0 +1,487 @@
+// Json.cpp - Defines the JsonValue class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include "Json.h"
+#include "JsonString.h"
+
+namespace
+{
+    using CmdLine::JsonValue;
+
+    /// @brief A recursive descent parser for a single JSON document.
+    class JsonParser
+    {
+    public:
+        JsonParser(const std::string& text) : mText{ text } { }
+
+        JsonValue ParseDocument()
+        {
+            JsonValue value = ParseValue();
+            SkipWhitespace();
+            if (mPos != mText.size())
+                throw JsonValue::ParseError{ "unexpected trailing text", mPos };
+            return value;
+        }
+    private:
+        const std::string& mText;
+        std::size_t mPos{ 0 };
+
+        void SkipWhitespace()
+        {
+            while (mPos < mText.size() && (mText[mPos] == ' ' ||
+                mText[mPos] == '\t' || mText[mPos] == '\n' ||
+                mText[mPos] == '\r'))
+            {
+                mPos++;
+            }
+        }
+
+        void Expect(char c)
+        {
+            if (mPos >= mText.size() || mText[mPos] != c)
+            {
+                throw JsonValue::ParseError{
+                    std::string{ "expected '" } + c + "'", mPos };
+            }
+            mPos++;
+        }
+
+        bool Consume(const char* literal)
+        {
+            std::string expected{ literal };
+            if (mText.compare(mPos, expected.size(), expected) != 0)
+                return false;
+            mPos += expected.size();
+            return true;
+        }
+
+        JsonValue ParseValue()
+        {
+            SkipWhitespace();
+            if (mPos >= mText.size())
+                throw JsonValue::ParseError{ "unexpected end of text", mPos };
+
+            char c = mText[mPos];
+            if (c == '{')
+                return ParseObject();
+            if (c == '[')
+                return ParseArray();
+            if (c == '"')
+                return JsonValue{ ParseString() };
+            if (c == '-' || (c >= '0' && c <= '9'))
+                return ParseNumber();
+            if (Consume("true"))
+                return JsonValue{ true };
+            if (Consume("false"))
+                return JsonValue{ false };
+            if (Consume("null"))
+                return JsonValue{};
+
+            throw JsonValue::ParseError{ "unexpected character", mPos };
+        }
+
+        JsonValue ParseObject()
+        {
+            JsonValue object = JsonValue::Object();
+            Expect('{');
+            SkipWhitespace();
+            if (mPos < mText.size() && mText[mPos] == '}')
+            {
+                mPos++;
+                return object;
+            }
+
+            while (true)
+            {
+                SkipWhitespace();
+                std::string name = ParseString();
+                SkipWhitespace();
+                Expect(':');
+                object.Set(name, ParseValue());
+                SkipWhitespace();
+
+                if (mPos < mText.size() && mText[mPos] == ',')
+                {
+                    mPos++;
+                    continue;
+                }
+
+                Expect('}');
+                return object;
+            }
+        }
+
+        JsonValue ParseArray()
+        {
+            JsonValue array = JsonValue::Array();
+            Expect('[');
+            SkipWhitespace();
+            if (mPos < mText.size() && mText[mPos] == ']')
+            {
+                mPos++;
+                return array;
+            }
+
+            while (true)
+            {
+                array.Append(ParseValue());
+                SkipWhitespace();
+
+                if (mPos < mText.size() && mText[mPos] == ',')
+                {
+                    mPos++;
+                    continue;
+                }
+
+                Expect(']');
+                return array;
+            }
+        }
+
+        JsonValue ParseNumber()
+        {
+            const char* start = mText.c_str() + mPos;
+            char* end = nullptr;
+            double value = std::strtod(start, &end);
+            if (end == start)
+                throw JsonValue::ParseError{ "invalid number", mPos };
+
+            mPos += static_cast<std::size_t>(end - start);
+            return JsonValue{ value };
+        }
+
+        unsigned ParseHex4()
+        {
+            if (mPos + 4 > mText.size())
+                throw JsonValue::ParseError{ "truncated \\u escape", mPos };
+
+            unsigned value = 0;
+            for (int i = 0; i < 4; i++)
+            {
+                char c = mText[mPos++];
+                value <<= 4;
+                if (c >= '0' && c <= '9')
+                    value |= static_cast<unsigned>(c - '0');
+                else if (c >= 'a' && c <= 'f')
+                    value |= static_cast<unsigned>(c - 'a' + 10);
+                else if (c >= 'A' && c <= 'F')
+                    value |= static_cast<unsigned>(c - 'A' + 10);
+                else
+                    throw JsonValue::ParseError{ "invalid \\u escape", mPos };
+            }
+
+            return value;
+        }
+
+        static void AppendUtf8(std::string& out, unsigned codePoint)
+        {
+            if (codePoint < 0x80)
+            {
+                out += static_cast<char>(codePoint);
+            }
+            else if (codePoint < 0x800)
+            {
+                out += static_cast<char>(0xc0 | (codePoint >> 6));
+                out += static_cast<char>(0x80 | (codePoint & 0x3f));
+            }
+            else if (codePoint < 0x10000)
+            {
+                out += static_cast<char>(0xe0 | (codePoint >> 12));
+                out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+                out += static_cast<char>(0x80 | (codePoint & 0x3f));
+            }
+            else
+            {
+                out += static_cast<char>(0xf0 | (codePoint >> 18));
+                out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f));
+                out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+                out += static_cast<char>(0x80 | (codePoint & 0x3f));
+            }
+        }
+
+        std::string ParseString()
+        {
+            Expect('"');
+            std::string value;
+
+            while (true)
+            {
+                if (mPos >= mText.size())
+                    throw JsonValue::ParseError{ "unterminated string", mPos };
+
+                char c = mText[mPos++];
+                if (c == '"')
+                    return value;
+
+                if (c != '\\')
+                {
+                    value += c;
+                    continue;
+                }
+
+                if (mPos >= mText.size())
+                    throw JsonValue::ParseError{ "unterminated string", mPos };
+
+                char escape = mText[mPos++];
+                switch (escape)
+                {
+                    case '"': value += '"'; break;
+                    case '\\': value += '\\'; break;
+                    case '/': value += '/'; break;
+                    case 'b': value += '\b'; break;
+                    case 'f': value += '\f'; break;
+                    case 'n': value += '\n'; break;
+                    case 'r': value += '\r'; break;
+                    case 't': value += '\t'; break;
+                    case 'u':
+                    {
+                        unsigned codePoint = ParseHex4();
+
+                        // Characters outside the basic multilingual plane
+                        // are escaped as a UTF-16 surrogate pair.
+                        if (codePoint >= 0xd800 && codePoint < 0xdc00 &&
+                            Consume("\\u"))
+                        {
+                            unsigned low = ParseHex4();
+                            codePoint = 0x10000 + ((codePoint - 0xd800) << 10)
+                                + (low - 0xdc00);
+                        }
+
+                        AppendUtf8(value, codePoint);
+                        break;
+                    }
+                    default:
+                        throw JsonValue::ParseError{ "invalid escape", mPos };
+                }
+            }
+        }
+    };
+
+    void AppendNumber(std::string& out, double value)
+    {
+        // JSON has no representation of infinity or NaN.
+        if (!std::isfinite(value))
+        {
+            out += "null";
+            return;
+        }
+
+        // Write whole numbers, e.g. allocation counts, without an exponent.
+        if (std::fabs(value) < 1e15 && value == std::floor(value))
+        {
+            out += std::to_string(static_cast<long long>(value));
+            return;
+        }
+
+        // 17 significant digits are enough to read back the exact double.
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.17g", value);
+
+        // Prefer the shortest text that still reads back exactly.
+        for (int precision = 1; precision < 17; precision++)
+        {
+            char shorter[32];
+            std::snprintf(shorter, sizeof(shorter), "%.*g", precision, value);
+            if (std::strtod(shorter, nullptr) == value)
+            {
+                out += shorter;
+                return;
+            }
+        }
+
+        out += text;
+    }
+}
+
+namespace CmdLine
+{
+    JsonValue JsonValue::Array()
+    {
+        JsonValue value;
+        value.mType = Type::Array;
+        return value;
+    }
+
+    JsonValue JsonValue::Object()
+    {
+        JsonValue value;
+        value.mType = Type::Object;
+        return value;
+    }
+
+    JsonValue JsonValue::Parse(const std::string& text)
+    {
+        JsonParser parser{ text };
+        return parser.ParseDocument();
+    }
+
+    bool JsonValue::AsBoolean() const
+    {
+        if (mType != Type::Boolean)
+            throw TypeError{ "expected a boolean" };
+        return mBoolean;
+    }
+
+    double JsonValue::AsNumber() const
+    {
+        if (mType != Type::Number)
+            throw TypeError{ "expected a number" };
+        return mNumber;
+    }
+
+    const std::string& JsonValue::AsString() const
+    {
+        if (mType != Type::String)
+            throw TypeError{ "expected a string" };
+        return mString;
+    }
+
+    const std::vector<JsonValue>& JsonValue::Items() const
+    {
+        if (mType != Type::Array)
+            throw TypeError{ "expected an array" };
+        return mItems;
+    }
+
+    const JsonValue::Members& JsonValue::GetMembers() const
+    {
+        if (mType != Type::Object)
+            throw TypeError{ "expected an object" };
+        return mMembers;
+    }
+
+    bool JsonValue::Contains(const std::string& name) const
+    {
+        if (mType != Type::Object)
+            return false;
+
+        for (auto& m : mMembers)
+        {
+            if (m.first == name)
+                return true;
+        }
+
+        return false;
+    }
+
+    const JsonValue& JsonValue::operator[](const std::string& name) const
+    {
+        static const JsonValue null;
+
+        for (auto& m : GetMembers())
+        {
+            if (m.first == name)
+                return m.second;
+        }
+
+        return null;
+    }
+
+    void JsonValue::Append(JsonValue item)
+    {
+        if (mType != Type::Array)
+            throw TypeError{ "expected an array" };
+        mItems.push_back(std::move(item));
+    }
+
+    void JsonValue::Set(const std::string& name, JsonValue value)
+    {
+        if (mType != Type::Object)
+            throw TypeError{ "expected an object" };
+
+        for (auto& m : mMembers)
+        {
+            if (m.first == name)
+            {
+                m.second = std::move(value);
+                return;
+            }
+        }
+
+        mMembers.emplace_back(name, std::move(value));
+    }
+
+    std::string JsonValue::Serialize(std::size_t indent) const
+    {
+        std::string out;
+        Serialize(out, indent, 0);
+        out += '\n';
+        return out;
+    }
+
+    void JsonValue::Serialize(std::string& out, std::size_t indent,
+        std::size_t depth) const
+    {
+        const std::string inner((depth + 1) * indent, ' ');
+        const std::string outer(depth * indent, ' ');
+
+        switch (mType)
+        {
+            case Type::Null:
+                out += "null";
+                break;
+            case Type::Boolean:
+                out += mBoolean ? "true" : "false";
+                break;
+            case Type::Number:
+                AppendNumber(out, mNumber);
+                break;
+            case Type::String:
+                AppendJsonString(out, mString);
+                break;
+            case Type::Array:
+            {
+                bool numbers = true;
+                for (auto& item : mItems)
+                    numbers = numbers && item.mType == Type::Number;
+
+                out += '[';
+                for (std::size_t i = 0; i < mItems.size(); i++)
+                {
+                    if (i > 0)
+                        out += numbers ? ", " : ",";
+                    if (!numbers)
+                        out += '\n' + inner;
+                    mItems[i].Serialize(out, indent, depth + 1);
+                }
+                if (!numbers && !mItems.empty())
+                    out += '\n' + outer;
+                out += ']';
+                break;
+            }
+            case Type::Object:
+            {
+                out += '{';
+                for (std::size_t i = 0; i < mMembers.size(); i++)
+                {
+                    if (i > 0)
+                        out += ',';
+                    out += '\n' + inner;
+                    AppendJsonString(out, mMembers[i].first);
+                    out += ": ";
+                    mMembers[i].second.Serialize(out, indent, depth + 1);
+                }
+                if (!mMembers.empty())
+                    out += '\n' + outer;
+                out += '}';
+                break;
+            }
+        }
+    }
+}
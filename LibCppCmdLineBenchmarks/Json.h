@@ -0,0 +1,216 @@
+// Json.h - Declares the JsonValue class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_JSON_H
+#define CMD_LINE_JSON_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace CmdLine
+{
+    /// @brief A minimal JSON document model.
+    ///
+    /// Just enough JSON for the benchmark tools to read Google Benchmark's
+    /// --benchmark_out files and to read and write benchmark baselines.
+    /// Object members keep the order they were parsed or added in, so a
+    /// baseline written back out diffs cleanly under version control. For
+    /// example:
+    ///
+    ///     JsonValue results = JsonValue::Parse(text);
+    ///     for (const JsonValue& b : results["benchmarks"].Items())
+    ///         std::cout << b["name"].AsString() << "\n";
+    class JsonValue
+    {
+    public:
+        /// @brief The types of value JSON can represent.
+        enum class Type
+        {
+            Null,
+            Boolean,
+            Number,
+            String,
+            Array,
+            Object
+        };
+
+        /// @brief The members of an object, in order.
+        using Members = std::vector<std::pair<std::string, JsonValue>>;
+
+        /// @brief Exception thrown when text is not valid JSON.
+        class ParseError : public std::invalid_argument
+        {
+        public:
+            /// @brief Constructs a new ParseError.
+            ///
+            /// @param message Describes what is wrong with the text.
+            /// @param offset The offset in the text the problem was found at.
+            ParseError(const std::string& message, std::size_t offset)
+                : std::invalid_argument{ message + " at offset " +
+                    std::to_string(offset) }
+            { }
+        };
+
+        /// @brief Exception thrown when a value is accessed as a type it
+        /// isn't.
+        class TypeError : public std::invalid_argument
+        {
+        public:
+            /// @brief Constructs a new TypeError.
+            ///
+            /// @param message Describes the expected type.
+            TypeError(const std::string& message)
+                : std::invalid_argument{ message }
+            { }
+        };
+
+        /// @brief Constructs a null value.
+        JsonValue() : mType{ Type::Null } { }
+
+        /// @brief Constructs a boolean value.
+        ///
+        /// @param value The value.
+        JsonValue(bool value) : mType{ Type::Boolean }, mBoolean{ value } { }
+
+        /// @brief Constructs a number value.
+        ///
+        /// @param value The value.
+        JsonValue(double value) : mType{ Type::Number }, mNumber{ value } { }
+
+        /// @brief Constructs a string value.
+        ///
+        /// @param value The value.
+        JsonValue(std::string value)
+            : mType{ Type::String }, mString{ std::move(value) }
+        { }
+
+        /// @brief Constructs a string value.
+        ///
+        /// @param value The value.
+        JsonValue(const char* value) : JsonValue{ std::string{ value } } { }
+
+        /// @brief Constructs an empty array.
+        ///
+        /// @return The array.
+        static JsonValue Array();
+
+        /// @brief Constructs an empty object.
+        ///
+        /// @return The object.
+        static JsonValue Object();
+
+        /// @brief Parses a JSON document.
+        ///
+        /// @param text The text of the document.
+        /// @return The value the document contains.
+        /// @exception ParseError Thrown if the text is not valid JSON.
+        static JsonValue Parse(const std::string& text);
+
+        /// @brief Gets the type of the value.
+        ///
+        /// @return The type.
+        Type GetType() const { return mType; }
+
+        /// @brief Gets the value of a boolean.
+        ///
+        /// @return The value.
+        /// @exception TypeError Thrown if the value isn't a boolean.
+        bool AsBoolean() const;
+
+        /// @brief Gets the value of a number.
+        ///
+        /// @return The value.
+        /// @exception TypeError Thrown if the value isn't a number.
+        double AsNumber() const;
+
+        /// @brief Gets the value of a string.
+        ///
+        /// @return The value.
+        /// @exception TypeError Thrown if the value isn't a string.
+        const std::string& AsString() const;
+
+        /// @brief Gets the items of an array.
+        ///
+        /// @return The items, in order.
+        /// @exception TypeError Thrown if the value isn't an array.
+        const std::vector<JsonValue>& Items() const;
+
+        /// @brief Gets the members of an object.
+        ///
+        /// @return The members, in order.
+        /// @exception TypeError Thrown if the value isn't an object.
+        const Members& GetMembers() const;
+
+        /// @brief Determines if an object has a member.
+        ///
+        /// @param name The name of the member.
+        /// @return True if the value is an object with the member, otherwise
+        /// false.
+        bool Contains(const std::string& name) const;
+
+        /// @brief Gets a member of an object.
+        ///
+        /// @param name The name of the member.
+        /// @return The member's value, or a null value if there isn't one.
+        /// @exception TypeError Thrown if the value isn't an object.
+        const JsonValue& operator[](const std::string& name) const;
+
+        /// @brief Appends an item to an array.
+        ///
+        /// @param item The item to append.
+        /// @exception TypeError Thrown if the value isn't an array.
+        void Append(JsonValue item);
+
+        /// @brief Sets a member of an object.
+        ///
+        /// Replaces the value of an existing member in place, otherwise adds
+        /// the member to the end.
+        ///
+        /// @param name The name of the member.
+        /// @param value The value of the member.
+        /// @exception TypeError Thrown if the value isn't an object.
+        void Set(const std::string& name, JsonValue value);
+
+        /// @brief Writes the value as JSON text.
+        ///
+        /// Arrays of numbers are written on a single line, everything else
+        /// one item or member per line.
+        ///
+        /// @param indent The number of spaces to indent each level by.
+        /// @return The JSON text.
+        std::string Serialize(std::size_t indent = 2) const;
+    private:
+        Type mType;
+        bool mBoolean{ false };
+        double mNumber{ 0 };
+        std::string mString;
+        std::vector<JsonValue> mItems;
+        Members mMembers;
+
+        /// @brief Writes the value as JSON text.
+        ///
+        /// @param out The text to append to.
+        /// @param indent The number of spaces to indent each level by.
+        /// @param depth The nesting depth of the value.
+        void Serialize(std::string& out, std::size_t indent,
+            std::size_t depth) const;
+    };
+}
+
+#endif
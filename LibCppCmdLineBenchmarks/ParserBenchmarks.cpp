@@ -0,0 +1,503 @@
+// ParserBenchmarks.cpp - Defines benchmarks for the Parser class.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "AllocationTracker.h"
+#include "BenchmarkAlgorithms.h"
+#include "SyntheticCli.h"
+#include "PerfCounters.h"
+#include "ResponseFile.h"
+#include "ShellCommand.h"
+#include "WorkerPool.h"
+
+namespace CmdLine
+{
+    /// @brief Records whether hardware performance counters are available.
+    ///
+    /// Adds a perf_counters entry to the context printed before the results
+    /// so that missing counters aren't mistaken for a bug.
+    ///
+    /// @return Always true.
+    static bool AddPerfCounterContext()
+    {
+        PerfCounters counters;
+        if (counters.Available())
+        {
+            benchmark::AddCustomContext("perf_counters", "available");
+        }
+        else
+        {
+            benchmark::AddCustomContext("perf_counters",
+                "unavailable (" + counters.UnavailableReason() + ")");
+        }
+
+        return true;
+    }
+
+    static bool perfCounterContextAdded = AddPerfCounterContext();
+
+    /// @brief Records the build type of LibCppCmdLine.
+    ///
+    /// The library_build_type Google Benchmark reports is its own, which
+    /// says nothing about how the code being benchmarked was built.
+    ///
+    /// @return Always true.
+    static bool AddBuildTypeContext()
+    {
+#ifdef NDEBUG
+        benchmark::AddCustomContext("libcppcmdline_build_type", "release");
+#else
+        benchmark::AddCustomContext("libcppcmdline_build_type", "debug");
+#endif
+        return true;
+    }
+
+    static bool buildTypeContextAdded = AddBuildTypeContext();
+
+    /// @brief Benchmarks Parser::Parse() end-to-end on a synthetic program.
+    ///
+    /// The benchmark arguments are, in order: the argument count (not
+    /// including the program name), the number of defined Options, the
+    /// percentage of those Options that are ValueOptions and the
+    /// MultiPosParam::ParsingOrder (0 for End, 1 for AfterOptions). The
+    /// arguments come from the synthetic CLI generator (see SyntheticCli.h)
+    /// with its default mix of options, values and paths. A Parser can only
+    /// be parsed once, so a fresh synthetic schema is generated for every
+    /// iteration and only the call to Parse() is timed and counted by the
+    /// hardware performance counters.
+    ///
+    /// @param state The benchmark state.
+    static void BM_Parse(benchmark::State& state)
+    {
+        SyntheticSchemaSpec schemaSpec;
+        schemaSpec.optionCount = static_cast<std::size_t>(state.range(1));
+        schemaSpec.valueOptionPercent = 
+            static_cast<std::size_t>(state.range(2));
+        schemaSpec.order = 
+            static_cast<MultiPosParam::ParsingOrder>(state.range(3));
+
+        SyntheticArgsSpec argsSpec;
+        argsSpec.argCount = static_cast<std::size_t>(state.range(0));
+
+        std::chrono::duration<double> elapsed{ 0 };
+        AllocationStats total;
+        PerfCounters counters;
+        for (auto _ : state)
+        {
+            SyntheticSchema schema = GenerateSyntheticSchema(schemaSpec);
+            auto parser = CreateSyntheticParser(schema, 
+                GenerateSyntheticArgs(schema, argsSpec));
+
+            counters.Start();
+            auto start = std::chrono::steady_clock::now();
+            AllocationScope scope;
+            Parser::Status status = parser->Parse();
+            benchmark::DoNotOptimize(status);
+            total.allocations += scope.Stats().allocations;
+            total.bytes += scope.Stats().bytes;
+            auto end = std::chrono::steady_clock::now();
+            counters.Stop();
+
+            std::chrono::duration<double> iterationTime = end - start;
+            state.SetIterationTime(iterationTime.count());
+            elapsed += iterationTime;
+
+            if (status != Parser::Status::Success)
+            {
+                state.SkipWithError("synthetic arguments failed to parse");
+                break;
+            }
+        }
+
+        SetArgumentCounters(state, argsSpec.argCount, elapsed);
+        SetAllocationCounters(state, total);
+        SetPerfCounters(state, counters.Counts(), "arg", argsSpec.argCount);
+    }
+
+    /// @brief Benchmarks Parser::GenerateHelp() on a synthetic program.
+    ///
+    /// The only benchmark argument is the number of defined Options, each of
+    /// which adds a line to the generated help, so hardware performance
+    /// counters are reported per Option.
+    ///
+    /// @param state The benchmark state.
+    static void BM_GenerateHelp(benchmark::State& state)
+    {
+        SyntheticSchemaSpec spec;
+        spec.optionCount = static_cast<std::size_t>(state.range(0));
+        SyntheticSchema schema = GenerateSyntheticSchema(spec);
+        auto parser = CreateSyntheticParser(schema, { "synthetic" });
+
+        PerfCounters counters;
+        AllocationScope scope;
+        counters.Start();
+        for (auto _ : state)
+        {
+            std::string help = parser->GenerateHelp();
+            benchmark::DoNotOptimize(help);
+        }
+        counters.Stop();
+
+        SetAllocationCounters(state, scope.Stats());
+        SetPerfCounters(state, counters.Counts(), "option", spec.optionCount);
+    }
+
+    /// @brief Benchmarks parsing a long list of files.
+    ///
+    /// The benchmark arguments are the number of files, whether they
+    /// follow the end-of-options marker (1) or not (0), which shows what
+    /// skipping the checks on operands saves, and whether the 
+    /// MultiPosParam for the files is lazy (1) or not (0), which shows what
+    /// not copying them saves. The program only has the MultiPosParam.
+    ///
+    /// @param state The benchmark state.
+    static void BM_ParseFileList(benchmark::State& state)
+    {
+        const std::size_t fileCount = static_cast<std::size_t>(state.range(0));
+
+        std::vector<std::string> args{ "synthetic" };
+        if (state.range(1) != 0)
+            args.push_back(endOfOptionsMarker);
+        for (std::size_t i = 0; i < fileCount; i++)
+            args.push_back("src/file" + std::to_string(i) + ".cpp");
+
+        ProgParam::Definition programDef;
+        programDef.name = "synthetic";
+        MultiPosParam::Definition filesDef;
+        filesDef.name = "FILES";
+        filesDef.isLazy = state.range(2) != 0;
+
+        std::chrono::duration<double> elapsed{ 0 };
+        for (auto _ : state)
+        {
+            ProgParam program{ programDef };
+            MultiPosParam files{ filesDef };
+            Parser parser{ &program, args };
+            parser.Set(&files);
+
+            auto start = std::chrono::steady_clock::now();
+            Parser::Status status = parser.Parse();
+            benchmark::DoNotOptimize(status);
+            auto end = std::chrono::steady_clock::now();
+
+            std::chrono::duration<double> iterationTime = end - start;
+            state.SetIterationTime(iterationTime.count());
+            elapsed += iterationTime;
+
+            if (status != Parser::Status::Success)
+            {
+                state.SkipWithError("the file list failed to parse");
+                break;
+            }
+        }
+
+        SetArgumentCounters(state, fileCount, elapsed);
+    }
+
+    /// @brief Benchmarks processing a long list of files on a WorkerPool.
+    ///
+    /// The benchmark arguments are the number of files and the number of
+    /// threads. Processing a file hashes its path a number of times that 
+    /// varies with the file, so some chunks take longer than others and
+    /// idle threads have to steal work to stay busy.
+    ///
+    /// @param state The benchmark state.
+    static void BM_ProcessFileList(benchmark::State& state)
+    {
+        const std::size_t fileCount = static_cast<std::size_t>(state.range(0));
+
+        std::vector<std::string> args;
+        for (std::size_t i = 0; i < fileCount; i++)
+            args.push_back("src/file" + std::to_string(i) + ".cpp");
+
+        WorkerPool pool{ static_cast<std::size_t>(state.range(1)) };
+        ValuePartition partition{ ArgView{ args } };
+        std::hash<std::string_view> hash;
+
+        std::chrono::duration<double> elapsed{ 0 };
+        for (auto _ : state)
+        {
+            auto start = std::chrono::steady_clock::now();
+            pool.ForEach(partition, [&hash](std::string_view path)
+            {
+                std::size_t h = hash(path);
+                for (std::size_t n = h % 64; n > 0; n--)
+                    h = hash(std::string_view{ path.data(), path.size() - 
+                        (h & 3) });
+                benchmark::DoNotOptimize(h);
+            });
+            auto end = std::chrono::steady_clock::now();
+
+            std::chrono::duration<double> iterationTime = end - start;
+            state.SetIterationTime(iterationTime.count());
+            elapsed += iterationTime;
+        }
+
+        SetArgumentCounters(state, fileCount, elapsed);
+    }
+
+    /// @brief Counts the positional arguments of a streaming parse.
+    class CountingHandler : public ParseHandler
+    {
+    public:
+        bool PositionalSeen(std::string_view, std::size_t) override
+        {
+            count++;
+            return true;
+        }
+
+        std::size_t count{ 0 };
+    };
+
+    /// @brief Benchmarks streaming a long list of files through a 
+    /// ParseHandler.
+    ///
+    /// The only benchmark argument is the number of files. Uses the same
+    /// arguments as BM_ParseFileList without the end-of-options marker, so
+    /// the two show what not storing the files saves.
+    ///
+    /// @param state The benchmark state.
+    static void BM_StreamFileList(benchmark::State& state)
+    {
+        const std::size_t fileCount = static_cast<std::size_t>(state.range(0));
+
+        std::vector<std::string> args{ "synthetic" };
+        for (std::size_t i = 0; i < fileCount; i++)
+            args.push_back("src/file" + std::to_string(i) + ".cpp");
+
+        ProgParam::Definition programDef;
+        programDef.name = "synthetic";
+        ProgParam program{ programDef };
+        Parser parser{ &program, { "synthetic" } };
+
+        std::chrono::duration<double> elapsed{ 0 };
+        AllocationStats total;
+        for (auto _ : state)
+        {
+            ContainerSource source{ args };
+            CountingHandler handler;
+
+            auto start = std::chrono::steady_clock::now();
+            AllocationScope scope;
+            Parser::Status status = parser.Parse(source, handler);
+            benchmark::DoNotOptimize(status);
+            total.allocations += scope.Stats().allocations;
+            total.bytes += scope.Stats().bytes;
+            auto end = std::chrono::steady_clock::now();
+
+            std::chrono::duration<double> iterationTime = end - start;
+            state.SetIterationTime(iterationTime.count());
+            elapsed += iterationTime;
+
+            if (status != Parser::Status::Success || 
+                handler.count != fileCount)
+            {
+                state.SkipWithError("the file list failed to stream");
+                break;
+            }
+        }
+
+        SetArgumentCounters(state, fileCount, elapsed);
+        SetAllocationCounters(state, total);
+    }
+
+    /// @brief Benchmarks expanding a response file of paths.
+    ///
+    /// The only benchmark argument is the number of paths in the file,
+    /// which is written once before timing starts. Each iteration maps, 
+    /// scans and expands the file into the arguments a Parser is given.
+    ///
+    /// @param state The benchmark state.
+    static void BM_ExpandResponseFile(benchmark::State& state)
+    {
+        const std::size_t fileCount = static_cast<std::size_t>(state.range(0));
+        std::string path = (std::filesystem::temp_directory_path() / 
+            "libcppcmdbench_files.rsp").string();
+
+        {
+            std::ofstream file{ path, std::ios::binary };
+            for (std::size_t i = 0; i < fileCount; i++)
+                file << "src/file" << i << ".cpp\n";
+        }
+
+        std::chrono::duration<double> elapsed{ 0 };
+        AllocationStats total;
+        for (auto _ : state)
+        {
+            std::vector<std::string> args{ "synthetic", "@" + path };
+
+            auto start = std::chrono::steady_clock::now();
+            AllocationScope scope;
+            Error error = ExpandResponseFiles(args);
+            benchmark::DoNotOptimize(args);
+            total.allocations += scope.Stats().allocations;
+            total.bytes += scope.Stats().bytes;
+            auto end = std::chrono::steady_clock::now();
+
+            std::chrono::duration<double> iterationTime = end - start;
+            state.SetIterationTime(iterationTime.count());
+            elapsed += iterationTime;
+
+            if (error.code != ErrorCode::None || args.size() != fileCount + 1)
+            {
+                state.SkipWithError("the response file failed to expand");
+                break;
+            }
+        }
+
+        std::remove(path.c_str());
+        SetArgumentCounters(state, fileCount, elapsed);
+        SetAllocationCounters(state, total);
+    }
+
+    /// @brief Benchmarks splitting a command line string into arguments.
+    ///
+    /// The first benchmark argument is the number of paths in the command,
+    /// the second is whether every other path is written with a space that
+    /// must be quoted, alternating between quotes and a backslash. Each 
+    /// iteration splits the command into the arguments a Parser is given.
+    ///
+    /// @param state The benchmark state.
+    static void BM_SplitShellCommand(benchmark::State& state)
+    {
+        const std::size_t fileCount = static_cast<std::size_t>(state.range(0));
+        const bool isQuoted = state.range(1) != 0;
+
+        std::string command{ "synthetic" };
+        for (std::size_t i = 0; i < fileCount; i++)
+        {
+            std::string path = "src/file" + std::to_string(i) + ".cpp";
+            if (isQuoted && i % 4 == 1)
+                path = "'src/my file" + std::to_string(i) + ".cpp'";
+            else if (isQuoted && i % 4 == 3)
+                path = "src/my\\ file" + std::to_string(i) + ".cpp";
+
+            command += " " + path;
+        }
+
+        std::chrono::duration<double> elapsed{ 0 };
+        AllocationStats total;
+        for (auto _ : state)
+        {
+            auto start = std::chrono::steady_clock::now();
+            AllocationScope scope;
+            ShellCommand shellCommand{ command };
+            benchmark::DoNotOptimize(shellCommand.Args().data());
+            total.allocations += scope.Stats().allocations;
+            total.bytes += scope.Stats().bytes;
+            auto end = std::chrono::steady_clock::now();
+
+            std::chrono::duration<double> iterationTime = end - start;
+            state.SetIterationTime(iterationTime.count());
+            elapsed += iterationTime;
+
+            if (shellCommand.Args().size() != fileCount + 1)
+            {
+                state.SkipWithError("the command failed to split");
+                break;
+            }
+        }
+
+        SetArgumentCounters(state, fileCount, elapsed);
+        SetAllocationCounters(state, total);
+    }
+
+    // Sweeps the argument count with a small schema to expose per-argument
+    // costs, e.g. in PopulateArgParams() and MoveOptionsToArgQueue().
+    BENCHMARK(BM_Parse)
+        ->ArgNames({ "args", "options", "value%", "order" })
+        ->ArgsProduct({
+            benchmark::CreateRange(10, 1000000, 10), { 10 }, { 25 }, { 0 }
+        })
+        ->UseManualTime()
+        ->Unit(benchmark::kMicrosecond);
+
+    // Sweeps the option count with a fixed argument count to expose the cost
+    // of matching each option argument against every defined Option. The 
+    // first sweep already has 10 options with 1000 arguments.
+    BENCHMARK(BM_Parse)
+        ->ArgNames({ "args", "options", "value%", "order" })
+        ->ArgsProduct({
+            { 1000 }, benchmark::CreateRange(100, 10000, 10), { 25 }, { 0 }
+        })
+        ->UseManualTime()
+        ->Unit(benchmark::kMicrosecond);
+
+    // Sweeps the ratio of ValueOptions to plain Options.
+    BENCHMARK(BM_Parse)
+        ->ArgNames({ "args", "options", "value%", "order" })
+        ->ArgsProduct({
+            { 10000 }, { 100 }, { 0, 25, 50, 75, 100 }, { 0 }
+        })
+        ->UseManualTime()
+        ->Unit(benchmark::kMicrosecond);
+
+    // Compares both MultiPosParam::ParsingOrder values. The End order 
+    // points for the same arguments are in the first sweep, so only the 
+    // AfterOptions order is added here.
+    BENCHMARK(BM_Parse)
+        ->ArgNames({ "args", "options", "value%", "order" })
+        ->ArgsProduct({
+            { 1000, 100000 }, { 10 }, { 25 }, { 1 }
+        })
+        ->UseManualTime()
+        ->Unit(benchmark::kMicrosecond);
+
+    // Compares a file list with and without the end-of-options marker.
+    BENCHMARK(BM_ParseFileList)
+        ->ArgNames({ "files", "marker", "lazy" })
+        ->ArgsProduct({ { 1000, 100000 }, { 0, 1 }, { 0, 1 } })
+        ->UseManualTime()
+        ->Unit(benchmark::kMicrosecond);
+
+    BENCHMARK(BM_ProcessFileList)
+        ->ArgNames({ "files", "threads" })
+        ->ArgsProduct({ { 100000 }, { 1, 2, 4 } })
+        ->UseManualTime()
+        ->Unit(benchmark::kMicrosecond);
+
+    BENCHMARK(BM_StreamFileList)
+        ->ArgName("files")
+        ->Arg(1000)
+        ->Arg(100000)
+        ->UseManualTime()
+        ->Unit(benchmark::kMicrosecond);
+
+    BENCHMARK(BM_ExpandResponseFile)
+        ->ArgName("files")
+        ->Arg(1000)
+        ->Arg(100000)
+        ->UseManualTime()
+        ->Unit(benchmark::kMicrosecond);
+
+    BENCHMARK(BM_SplitShellCommand)
+        ->ArgNames({ "files", "quoted" })
+        ->ArgsProduct({ { 1000, 100000 }, { 0, 1 } })
+        ->UseManualTime()
+        ->Unit(benchmark::kMicrosecond);
+
+    BENCHMARK(BM_GenerateHelp)
+        ->ArgName("options")
+        ->RangeMultiplier(10)
+        ->Range(10, 1000)
+        ->Unit(benchmark::kMicrosecond);
+}
@@ -0,0 +1,187 @@
+// PerfCounters.cpp - Defines the hardware performance counter collector.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include "PerfCounters.h"
+
+#ifdef CMD_LINE_PERF_COUNTERS
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace CmdLine
+{
+#ifdef CMD_LINE_PERF_COUNTERS
+    namespace
+    {
+        // Describes how to ask the kernel for each PerfEvent, in the same
+        // order as the PerfEvent enum.
+        struct PerfEventConfig
+        {
+            std::uint32_t type;
+            std::uint64_t config;
+        };
+
+        constexpr std::uint64_t CacheConfig(std::uint64_t cache)
+        {
+            return cache |
+                (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        }
+
+        const PerfEventConfig eventConfigs[perfEventCount]
+        {
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+            { PERF_TYPE_HW_CACHE, CacheConfig(PERF_COUNT_HW_CACHE_L1D) },
+            { PERF_TYPE_HW_CACHE, CacheConfig(PERF_COUNT_HW_CACHE_LL) },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+        };
+
+        int OpenCounter(const PerfEventConfig& c)
+        {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = c.type;
+            attr.config = c.config;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+                PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            // Count the calling thread on whichever CPU it runs on. 
+            long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+            return static_cast<int>(fd);
+        }
+    }
+#endif
+
+    PerfCounters::PerfCounters()
+    {
+        mFds.fill(-1);
+        mStartValues.fill(0);
+
+#ifdef CMD_LINE_PERF_COUNTERS
+        int lastError = 0;
+        for (std::size_t i = 0; i < perfEventCount; i++)
+        {
+            mFds[i] = OpenCounter(eventConfigs[i]);
+            mCounts.available[i] = mFds[i] != -1;
+            if (mFds[i] == -1)
+                lastError = errno;
+        }
+
+        if (!Available())
+        {
+            mUnavailableReason = "perf_event_open failed: ";
+            mUnavailableReason += std::strerror(lastError);
+        }
+#else
+        mUnavailableReason = "not compiled in";
+#endif
+    }
+
+    PerfCounters::~PerfCounters()
+    {
+#ifdef CMD_LINE_PERF_COUNTERS
+        for (int fd : mFds)
+        {
+            if (fd != -1)
+                close(fd);
+        }
+#endif
+    }
+
+    bool PerfCounters::Available() const
+    {
+        for (bool a : mCounts.available)
+        {
+            if (a)
+                return true;
+        }
+
+        return false;
+    }
+
+    void PerfCounters::Start()
+    {
+        for (std::size_t i = 0; i < perfEventCount; i++)
+        {
+            if (mFds[i] != -1)
+                mStartValues[i] = Read(mFds[i]);
+        }
+    }
+
+    void PerfCounters::Stop()
+    {
+        for (std::size_t i = 0; i < perfEventCount; i++)
+        {
+            if (mFds[i] == -1)
+                continue;
+
+            // A failed read reports zero, which must not wrap around.
+            std::uint64_t value = Read(mFds[i]);
+            if (value >= mStartValues[i])
+                mCounts.values[i] += value - mStartValues[i];
+        }
+    }
+
+    PerfCounts PerfCounters::Counts() const
+    {
+        return mCounts;
+    }
+
+    std::uint64_t PerfCounters::Read(int fd) const
+    {
+#ifdef CMD_LINE_PERF_COUNTERS
+        // The value, the time enabled and the time running, as requested by
+        // the read format.
+        std::uint64_t data[3]{};
+        if (read(fd, data, sizeof(data)) != sizeof(data))
+            return 0;
+
+        if (data[2] == 0 || data[2] >= data[1])
+            return data[0];
+
+        double scale = static_cast<double>(data[1]) / data[2];
+        return static_cast<std::uint64_t>(data[0] * scale);
+#else
+        return 0;
+#endif
+    }
+
+    const char* PerfEventName(PerfEvent e)
+    {
+        switch (e)
+        {
+            case PerfEvent::Instructions:
+                return "instructions";
+            case PerfEvent::Cycles:
+                return "cycles";
+            case PerfEvent::L1DataMisses:
+                return "l1d_misses";
+            case PerfEvent::LastLevelCacheMisses:
+                return "llc_misses";
+            case PerfEvent::BranchMisses:
+                return "branch_misses";
+        }
+
+        return "unknown";
+    }
+}
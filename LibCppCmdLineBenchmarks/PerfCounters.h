@@ -0,0 +1,135 @@
+// PerfCounters.h - Declares the hardware performance counter collector.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_PERF_COUNTERS_H
+#define CMD_LINE_PERF_COUNTERS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace CmdLine
+{
+    /// @brief The hardware events a PerfCounters collector can count.
+    enum class PerfEvent
+    {
+        /// @brief Instructions retired.
+        Instructions,
+
+        /// @brief CPU cycles.
+        Cycles,
+
+        /// @brief Level 1 data cache read misses.
+        L1DataMisses,
+
+        /// @brief Last level cache misses.
+        LastLevelCacheMisses,
+
+        /// @brief Mispredicted branches.
+        BranchMisses
+    };
+
+    /// @brief The number of PerfEvent values.
+    constexpr std::size_t perfEventCount = 5;
+
+    /// @brief The counts a PerfCounters collector has accumulated.
+    struct PerfCounts
+    {
+        /// @brief The count of each PerfEvent, indexed by the event.
+        std::array<std::uint64_t, perfEventCount> values{};
+
+        /// @brief Whether each PerfEvent could be counted.
+        ///
+        /// Events the kernel or hardware does not support (common on
+        /// virtual machines) are never counted and stay at zero.
+        std::array<bool, perfEventCount> available{};
+    };
+
+    /// @brief Counts hardware events while a benchmark runs.
+    ///
+    /// Uses the Linux perf_event_open() system call to count the PerfEvents
+    /// occurring in the calling thread while the collector is started, 
+    /// excluding any time spent in the kernel. Counting is optional: when
+    /// the build disables it (the LIBCPPCMDLINE_BENCH_PERF_COUNTERS
+    /// option), the platform isn't Linux, or the kernel doesn't permit it
+    /// (see /proc/sys/kernel/perf_event_paranoid), no events are available
+    /// and Start() and Stop() do nothing, so benchmarks can use a collector
+    /// unconditionally. For example:
+    ///
+    ///     PerfCounters counters;
+    ///     counters.Start();
+    ///     parser.Parse();
+    ///     counters.Stop();
+    ///     SetPerfCounters(state, counters.Counts(), "arg", argCount);
+    class PerfCounters
+    {
+    public:
+        /// @brief Opens a counter for each PerfEvent that is available.
+        PerfCounters();
+
+        /// @brief Closes every open counter.
+        ~PerfCounters();
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        /// @brief Determines if any PerfEvent can be counted.
+        ///
+        /// @return True if at least one event is available, otherwise false.
+        bool Available() const;
+
+        /// @brief Starts counting events.
+        void Start();
+
+        /// @brief Stops counting events and adds them to the counts.
+        ///
+        /// @pre Start() was called since the last call to Stop().
+        void Stop();
+
+        /// @brief Gets the events counted between every Start() and Stop().
+        ///
+        /// @return The accumulated counts.
+        PerfCounts Counts() const;
+
+        /// @brief Explains why no PerfEvent can be counted.
+        ///
+        /// @return The reason, or an empty string if Available().
+        std::string UnavailableReason() const { return mUnavailableReason; }
+    private:
+        std::array<int, perfEventCount> mFds;
+        std::array<std::uint64_t, perfEventCount> mStartValues;
+        PerfCounts mCounts;
+        std::string mUnavailableReason;
+
+        /// @brief Reads the current value of a counter.
+        ///
+        /// Scales the value up if the kernel had to multiplex the counter
+        /// with others and so only counted for part of the time.
+        ///
+        /// @param fd The file descriptor of the counter.
+        /// @return The current value of the counter.
+        std::uint64_t Read(int fd) const;
+    };
+
+    /// @brief Gets the short name used to report a PerfEvent.
+    ///
+    /// @param e The PerfEvent to get the name of.
+    /// @return The name of the event, e.g. "instructions".
+    const char* PerfEventName(PerfEvent e);
+}
+
+#endif
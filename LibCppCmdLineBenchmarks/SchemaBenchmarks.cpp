@@ -0,0 +1,159 @@
+// SchemaBenchmarks.cpp - Defines benchmarks for building a Parser schema.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include <chrono>
+#include <memory>
+#include "benchmark/benchmark.h"
+#include "AllocationTracker.h"
+#include "BenchmarkAlgorithms.h"
+#include "SyntheticCli.h"
+
+namespace CmdLine
+{
+    /// @brief Benchmarks building a ready-to-parse Parser from scratch.
+    ///
+    /// Measures everything a short-lived program does between starting and
+    /// calling Parser::Parse(): constructing each Param, constructing the
+    /// Parser (including its built-in help Option) and adding every Param to
+    /// it. The only benchmark argument is the number of Options to define.
+    /// Tearing the schema down is not timed.
+    ///
+    /// @param state The benchmark state.
+    static void BM_BuildSchema(benchmark::State& state)
+    {
+        SyntheticSchemaSpec spec;
+        spec.optionCount = static_cast<std::size_t>(state.range(0));
+
+        AllocationStats total;
+        for (auto _ : state)
+        {
+            auto start = std::chrono::steady_clock::now();
+            AllocationScope scope;
+
+            SyntheticSchema schema = GenerateSyntheticSchema(spec);
+            auto parser = CreateSyntheticParser(schema, { "synthetic" });
+            benchmark::DoNotOptimize(parser);
+
+            total.allocations += scope.Stats().allocations;
+            total.bytes += scope.Stats().bytes;
+            auto end = std::chrono::steady_clock::now();
+
+            std::chrono::duration<double> iterationTime = end - start;
+            state.SetIterationTime(iterationTime.count());
+        }
+
+        SetAllocationCounters(state, total);
+    }
+
+    /// @brief Benchmarks adding Options to a Parser.
+    ///
+    /// Isolates the cost of Parser::Add(), including its duplicate checks,
+    /// from the cost of constructing the Options being added. The only
+    /// benchmark argument is the number of Options to add.
+    ///
+    /// @param state The benchmark state.
+    static void BM_ParserAdd(benchmark::State& state)
+    {
+        SyntheticSchemaSpec spec;
+        spec.optionCount = static_cast<std::size_t>(state.range(0));
+
+        AllocationStats total;
+        for (auto _ : state)
+        {
+            SyntheticSchema schema = GenerateSyntheticSchema(spec);
+            Parser parser{ schema.program.get(), { "synthetic" } };
+
+            auto start = std::chrono::steady_clock::now();
+            AllocationScope scope;
+
+            for (auto& o : schema.options)
+                parser.Add(o.option.get());
+
+            total.allocations += scope.Stats().allocations;
+            total.bytes += scope.Stats().bytes;
+            auto end = std::chrono::steady_clock::now();
+
+            std::chrono::duration<double> iterationTime = end - start;
+            state.SetIterationTime(iterationTime.count());
+        }
+
+        SetAllocationCounters(state, total);
+    }
+
+    /// @brief Benchmarks constructing a Parser with no Params added.
+    ///
+    /// Most of the cost is constructing and adding the built-in help Option.
+    ///
+    /// @param state The benchmark state.
+    static void BM_ConstructParser(benchmark::State& state)
+    {
+        ProgParam::Definition programDef;
+        programDef.name = "synthetic";
+        ProgParam program{ programDef };
+        std::vector<std::string> args{ "synthetic" };
+
+        AllocationScope scope;
+        for (auto _ : state)
+        {
+            Parser parser{ &program, args };
+            benchmark::DoNotOptimize(parser);
+        }
+
+        SetAllocationCounters(state, scope.Stats());
+    }
+
+    /// @brief Benchmarks constructing a single Option or ValueOption.
+    ///
+    /// @tparam T The type of Option to construct.
+    /// @param state The benchmark state.
+    template <typename T>
+    static void BM_ConstructOption(benchmark::State& state)
+    {
+        typename T::Definition d;
+        d.shortName = 'v';
+        d.longName = "verbose";
+        d.description = "prints verbose info";
+
+        AllocationScope scope;
+        for (auto _ : state)
+        {
+            T option{ d };
+            benchmark::DoNotOptimize(option);
+        }
+
+        SetAllocationCounters(state, scope.Stats());
+    }
+
+    BENCHMARK(BM_BuildSchema)
+        ->ArgName("options")
+        ->RangeMultiplier(10)
+        ->Range(10, 10000)
+        ->UseManualTime()
+        ->Unit(benchmark::kMicrosecond);
+
+    BENCHMARK(BM_ParserAdd)
+        ->ArgName("options")
+        ->RangeMultiplier(10)
+        ->Range(10, 10000)
+        ->UseManualTime()
+        ->Unit(benchmark::kMicrosecond);
+
+    BENCHMARK(BM_ConstructParser);
+
+    BENCHMARK_TEMPLATE(BM_ConstructOption, Option);
+
+    BENCHMARK_TEMPLATE(BM_ConstructOption, ValueOption);
+}
@@ -0,0 +1,107 @@
+// ValidationBenchmarks.cpp - Defines benchmarks for argument classification.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include <string>
+#include <string_view>
+#include "benchmark/benchmark.h"
+#include "BenchmarkAlgorithms.h"
+#include "Validation.h"
+#include "Option.h"
+#include "NameValuePair.h"
+
+namespace CmdLine
+{
+    /// @brief Benchmarks a classification function against one argument.
+    ///
+    /// The functions under test are called once per command line argument
+    /// during parsing, so each is measured in isolation against a single
+    /// argument shape. Bytes processed are reported so that the long argument
+    /// shapes can be compared with the short ones.
+    ///
+    /// @tparam F The type of the function under test.
+    /// @param state The benchmark state.
+    /// @param f The function under test.
+    /// @param arg The argument to call the function with.
+    template <typename F>
+    static void BM_Classify(benchmark::State& state, F f, std::string arg)
+    {
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(arg);
+            auto result = f(arg);
+            benchmark::DoNotOptimize(result);
+        }
+
+        state.SetBytesProcessed(state.iterations() * arg.size());
+    }
+
+    /// @brief Constructs a NameValuePair from the argument if it is valid.
+    ///
+    /// Invalid pairs are rejected with IsNameValuePair() first, the same way
+    /// a caller that wants to avoid the InvalidPair exception would.
+    ///
+    /// @param arg The argument to construct the NameValuePair from.
+    /// @return The size of the name, so the result can't be optimized out.
+    static std::size_t ConstructNameValuePair(const std::string& arg)
+    {
+        if (!IsNameValuePair(arg))
+            return 0;
+
+        NameValuePair pair{ arg };
+        return pair.Name().size();
+    }
+
+    /// @brief Registers a benchmark for each function and argument shape.
+    ///
+    /// @return True once the benchmarks have been registered.
+    static bool RegisterValidationBenchmarks()
+    {
+        for (const auto& shape : GenerateArgumentShapes())
+        {
+            const std::string& a = shape.arg;
+            const std::string suffix = "/" + shape.name;
+
+            benchmark::RegisterBenchmark(
+                ("BM_IsValidNonOptionName" + suffix).c_str(),
+                BM_Classify<bool(*)(std::string_view)>, IsValidNonOptionName,
+                a);
+
+            benchmark::RegisterBenchmark(
+                ("BM_StartsWithOptionPrefix" + suffix).c_str(),
+                BM_Classify<bool(*)(std::string_view)>, StartsWithOptionPrefix,
+                a);
+
+            benchmark::RegisterBenchmark(("BM_IsOption" + suffix).c_str(),
+                BM_Classify<bool(*)(std::string_view)>, IsOption, a);
+
+            benchmark::RegisterBenchmark(
+                ("BM_IsNameValuePair" + suffix).c_str(),
+                BM_Classify<bool(*)(std::string)>, IsNameValuePair, a);
+
+            benchmark::RegisterBenchmark(
+                ("BM_NameValuePair" + suffix).c_str(),
+                BM_Classify<std::size_t(*)(const std::string&)>,
+                ConstructNameValuePair, a);
+        }
+
+        return true;
+    }
+
+    static const bool validationBenchmarksRegistered
+    {
+        RegisterValidationBenchmarks()
+    };
+}
@@ -0,0 +1,198 @@
+// AllocationTests.cpp - Defines the allocation budget tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include <thread>
+#include "AllocationTests.h"
+
+namespace CmdLine
+{
+    AllocationTests::AllocationTests()
+    {
+        copyProgramDef.name = copyProgramName;
+        copyProgramDef.description = copyProgramDescription;
+
+        verboseDef.shortName = verboseOptionShortName;
+        verboseDef.longName = verboseOptionLongName;
+        verboseDef.description = verboseOptionDescription;
+
+        printDef.shortName = printOptionShortName;
+        printDef.longName = printOptionLongName;
+        printDef.description = printOptionDescription;
+
+        songDef.name = songOptionParamName;
+        songDef.description = songOptionParamDescription;
+
+        destinationDef.name = copyDestinationPosName;
+        destinationDef.description = copyDestinationPosDescription;
+        destinationDef.isMandatory = true;
+
+        sourceDef.name = copySourceMultiPosName;
+        sourceDef.description = copySourceMultiPosDescription;
+        sourceDef.isMandatory = true;
+        sourceDef.order = MultiPosParam::ParsingOrder::AfterOptions;
+
+        copyProgParam = std::make_unique<ProgParam>(copyProgramDef);
+        verboseOption = std::make_unique<Option>(verboseDef);
+        printOption = std::make_unique<ValueOption>(printDef);
+        songOptionParam = std::make_unique<OptionParam>(songDef);
+        destinationPos = std::make_unique<PosParam>(destinationDef);
+        sourceMultiPos = std::make_unique<MultiPosParam>(sourceDef);
+        printOption->Add(songOptionParam.get());
+
+        copyParser = std::make_unique<Parser>(copyProgParam.get(), copyArgs);
+        copyParser->Add(verboseOption.get());
+        copyParser->Add(destinationPos.get());
+        copyParser->Set(sourceMultiPos.get());
+    }
+
+    void AllocationTests::SetUp()
+    {
+        if (!AllocationTrackingEnabled())
+            GTEST_SKIP() << "allocation tracking is not compiled in";
+    }
+
+    TEST_F(AllocationTests, CountsAllocationsMadeWithinScope)
+    {
+        // Storing the pointer in a volatile stops the compiler from eliding
+        // the allocation altogether.
+        AllocationScope scope;
+        long long* volatile value = new long long{ 0 };
+        delete value;
+
+        AllocationStats stats = scope.Stats();
+        EXPECT_EQ(stats.allocations, 1);
+        EXPECT_EQ(stats.bytes, sizeof(long long));
+        EXPECT_EQ(stats.deallocations, 1);
+    }
+
+    TEST_F(AllocationTests, NestedScopesOnlyCountTheirOwnAllocations)
+    {
+        AllocationScope outer;
+        auto first = std::make_unique<int>(0);
+
+        AllocationScope inner;
+        auto second = std::make_unique<int>(0);
+        auto third = std::make_unique<int>(0);
+
+        EXPECT_EQ(inner.Stats().allocations, 2);
+        EXPECT_EQ(outer.Stats().allocations, 3);
+
+        inner.Reset();
+        EXPECT_EQ(inner.Stats().allocations, 0);
+    }
+
+    TEST_F(AllocationTests, IgnoresAllocationsMadeByOtherThreads)
+    {
+        AllocationScope scope;
+        std::size_t otherThreadAllocations = 0;
+
+        // Creating the thread allocates on this thread, so only count from
+        // after it has been joined.
+        std::thread other{ [&otherThreadAllocations]()
+        {
+            AllocationScope otherScope;
+            auto value = std::make_unique<int>(0);
+            otherThreadAllocations = otherScope.Stats().allocations;
+        }};
+        other.join();
+
+        scope.Reset();
+        EXPECT_EQ(otherThreadAllocations, 1);
+        EXPECT_EQ(scope.Stats().allocations, 0);
+    }
+
+    TEST_F(AllocationTests, OptionPopulationDoesNotAllocate)
+    {
+        std::deque<std::string> args{ unixVerboseOptionShortName };
+
+        AllocationScope scope;
+        EXPECT_TRUE(verboseOption->CanPopulate(args));
+        EXPECT_TRUE(verboseOption->Populate(args));
+        EXPECT_EQ(scope.Stats().allocations, 0);
+    }
+
+    TEST_F(AllocationTests, ProgParamPopulationDoesNotAllocate)
+    {
+        std::deque<std::string> args{ copyProgramName };
+
+        AllocationScope scope;
+        EXPECT_TRUE(copyProgParam->Populate(args));
+        EXPECT_EQ(scope.Stats().allocations, 0);
+    }
+
+    TEST_F(AllocationTests, PosParamPopulationDoesNotAllocateForShortValues)
+    {
+        // Short values fit in the small string buffer, so copying them into
+        // the PosParam doesn't need the heap.
+        std::deque<std::string> args{ copySourceFileName1 };
+
+        AllocationScope scope;
+        EXPECT_TRUE(destinationPos->Populate(args));
+        EXPECT_EQ(scope.Stats().allocations, 0);
+    }
+
+    TEST_F(AllocationTests, ValueOptionPopulationStaysWithinBudget)
+    {
+        const std::size_t budget = 2;
+        std::deque<std::string> args
+        {
+            unixPrintOptionShortName,
+            songOptionParamName
+        };
+
+        AllocationScope scope;
+        EXPECT_TRUE(printOption->Populate(args));
+        EXPECT_LE(scope.Stats().allocations, budget);
+    }
+
+    TEST_F(AllocationTests, MultiPosParamPopulationStaysWithinBudget)
+    {
+        // One allocation each time the value vector grows.
+        const std::size_t budget = 2;
+        std::deque<std::string> args
+        {
+            copySourceFileName1,
+            copySourceFileName2
+        };
+
+        AllocationScope scope;
+        EXPECT_TRUE(sourceMultiPos->Populate(args));
+        EXPECT_LE(scope.Stats().allocations, budget);
+    }
+
+    TEST_F(AllocationTests, ParseStaysWithinBudget)
+    {
+        // Every argument fits in the small string buffer, so the only 
+        // allocations are the temporary deques FillArgQueue() reorders the
+        // arguments with (7), the vector of ArgParams (1) and the 
+        // MultiPosParam's values (1). Params aren't reset between parses, 
+        // so a Parser can't be reused to avoid even these.
+        const std::size_t budget = 9;
+
+        AllocationScope scope;
+        EXPECT_EQ(copyParser->Parse(), Parser::Status::Success);
+        EXPECT_LE(scope.Stats().allocations, budget);
+    }
+
+    TEST_F(AllocationTests, GenerateHelpStaysWithinBudget)
+    {
+        const std::size_t budget = 20;
+
+        AllocationScope scope;
+        std::string help = copyParser->GenerateHelp();
+        EXPECT_LE(scope.Stats().allocations, budget);
+    }
+}
@@ -0,0 +1,83 @@
+// AllocationTests.h - Declares the AllocationTests fixture.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_ALLOCATION_TESTS_H
+#define CMD_LINE_ALLOCATION_TESTS_H
+
+#include <memory>
+#include <deque>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "AllocationTracker.h"
+#include "ExampleArguments.h"
+#include "Parser.h"
+#include "Option.h"
+#include "ValueOption.h"
+#include "OptionParam.h"
+#include "PosParam.h"
+#include "MultiPosParam.h"
+#include "ProgParam.h"
+
+namespace CmdLine
+{
+    /// @brief Test fixture for the allocation budget tests.
+    ///
+    /// Checks that the allocation harness itself counts correctly and that
+    /// parsing, help generation and ArgParam population stay within their
+    /// heap allocation budgets. The budgets are ceilings: when a change
+    /// reduces the allocations made, the budget should be lowered to match.
+    /// Every test is skipped when allocation tracking is not compiled in.
+    /// See AllocationTests.cpp for the actual tests.
+    class AllocationTests : public ::testing::Test
+    {
+    protected:
+        /// @brief Constructs the AllocationTests fixture.
+        ///
+        /// Defines and initializes the Params of a hypothetical copy
+        /// program, along with a Parser that has all of them added.
+        AllocationTests();
+
+        /// @brief Skips the test if allocation tracking is disabled.
+        void SetUp() override;
+
+        std::vector<std::string> copyArgs
+        {
+            copyProgramName,
+            unixVerboseOptionShortName,
+            copySourceFileName1,
+            copySourceFileName2,
+            copyDestinationFileName
+        };
+
+        ProgParam::Definition copyProgramDef;
+        Option::Definition verboseDef;
+        ValueOption::Definition printDef;
+        OptionParam::Definition songDef;
+        PosParam::Definition destinationDef;
+        MultiPosParam::Definition sourceDef;
+
+        std::unique_ptr<ProgParam> copyProgParam;
+        std::unique_ptr<Option> verboseOption;
+        std::unique_ptr<ValueOption> printOption;
+        std::unique_ptr<OptionParam> songOptionParam;
+        std::unique_ptr<PosParam> destinationPos;
+        std::unique_ptr<MultiPosParam> sourceMultiPos;
+        std::unique_ptr<Parser> copyParser;
+    };
+}
+
+#endif
@@ -0,0 +1,130 @@
+// AllocationTracker.cpp - Defines the heap allocation accounting harness.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include <cstdlib>
+#include <new>
+#include "AllocationTracker.h"
+
+namespace
+{
+    // Each thread only ever touches its own totals, so no synchronization is
+    // needed. The totals are trivially constructible, which means they are
+    // safe to use from operator new before any static initialization runs.
+    thread_local std::size_t threadAllocations = 0;
+    thread_local std::size_t threadBytes = 0;
+    thread_local std::size_t threadDeallocations = 0;
+
+    CmdLine::AllocationStats CurrentThreadTotals()
+    {
+        CmdLine::AllocationStats totals;
+        totals.allocations = threadAllocations;
+        totals.bytes = threadBytes;
+        totals.deallocations = threadDeallocations;
+        return totals;
+    }
+}
+
+#ifdef CMD_LINE_TRACK_ALLOCATIONS
+
+namespace
+{
+    void* TrackedAllocate(std::size_t size)
+    {
+        threadAllocations++;
+        threadBytes += size;
+
+        // malloc(0) may return null, which operator new must never do.
+        void* p = std::malloc(size == 0 ? 1 : size);
+        if (p == nullptr)
+            throw std::bad_alloc{};
+
+        return p;
+    }
+
+    void TrackedDeallocate(void* p)
+    {
+        if (p == nullptr)
+            return;
+
+        threadDeallocations++;
+        std::free(p);
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    return TrackedAllocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return TrackedAllocate(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    TrackedDeallocate(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    TrackedDeallocate(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    TrackedDeallocate(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    TrackedDeallocate(p);
+}
+
+#endif
+
+namespace CmdLine
+{
+    AllocationScope::AllocationScope()
+        : mStart{ CurrentThreadTotals() }
+    {
+    }
+
+    AllocationStats AllocationScope::Stats() const
+    {
+        AllocationStats current = CurrentThreadTotals();
+
+        AllocationStats stats;
+        stats.allocations = current.allocations - mStart.allocations;
+        stats.bytes = current.bytes - mStart.bytes;
+        stats.deallocations = current.deallocations - mStart.deallocations;
+        return stats;
+    }
+
+    void AllocationScope::Reset()
+    {
+        mStart = CurrentThreadTotals();
+    }
+
+    bool AllocationTrackingEnabled()
+    {
+#ifdef CMD_LINE_TRACK_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+}
@@ -0,0 +1,80 @@
+// AllocationTracker.h - Declares the heap allocation accounting harness.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_ALLOCATION_TRACKER_H
+#define CMD_LINE_ALLOCATION_TRACKER_H
+
+#include <cstddef>
+
+namespace CmdLine
+{
+    /// @brief The heap allocations made during a region of code.
+    struct AllocationStats
+    {
+        /// @brief The number of calls to the global operator new.
+        std::size_t allocations = 0;
+
+        /// @brief The number of bytes requested from the global operator new.
+        std::size_t bytes = 0;
+
+        /// @brief The number of calls to the global operator delete.
+        std::size_t deallocations = 0;
+    };
+
+    /// @brief Records the heap allocations made on a thread within a scope.
+    ///
+    /// When allocation tracking is enabled (the CMD_LINE_TRACK_ALLOCATIONS
+    /// build option), the test and benchmark binaries replace the global
+    /// operator new and operator delete with versions that count every heap
+    /// allocation made by the calling thread. An AllocationScope takes a
+    /// snapshot of those counts when it is constructed, so Stats() reports
+    /// only the allocations made since then. Scopes may be nested, and
+    /// allocations made by other threads are never included. For example,
+    /// to assert that parsing stays within an allocation budget:
+    ///
+    ///     AllocationScope scope;
+    ///     parser.Parse();
+    ///     EXPECT_LE(scope.Stats().allocations, budget);
+    class AllocationScope
+    {
+    public:
+        /// @brief Starts recording allocations made by the current thread.
+        AllocationScope();
+
+        /// @brief Gets the allocations made since the scope was constructed.
+        ///
+        /// @return The allocations made so far within the scope.
+        AllocationStats Stats() const;
+
+        /// @brief Starts recording again from the current point.
+        ///
+        /// @post Stats() reports no allocations until the next allocation.
+        void Reset();
+    private:
+        AllocationStats mStart;
+    };
+
+    /// @brief Determines if allocation tracking is compiled in.
+    ///
+    /// When allocation tracking is disabled, every AllocationScope reports
+    /// zero allocations, so tests that assert an allocation budget should
+    /// be skipped.
+    ///
+    /// @return True if allocations are being tracked, otherwise false.
+    bool AllocationTrackingEnabled();
+}
+
+#endif
@@ -0,0 +1,180 @@
+// ArgSourceTests.cpp - Defines the ArgSource tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#include "ArgSourceTests.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace CmdLine
+{
+    std::vector<std::string> ArgSourceTests::ReadAll(ArgSource& source)
+    {
+        std::vector<std::string> args;
+        std::string_view arg;
+        while (source.Next(arg))
+            args.emplace_back(arg);
+
+        return args;
+    }
+
+    TEST_F(ArgSourceTests, ReadsArgv)
+    {
+        const char* argv[]
+        { 
+            mediaProgramName, unixVerboseOptionShortName, mediaFileName1 
+        };
+        ArgvSource source{ 3, argv };
+        EXPECT_EQ(source.RemainingHint(), 3);
+        EXPECT_EQ(ReadAll(source), mediaArgs);
+        EXPECT_EQ(source.RemainingHint(), 0);
+
+        ArgvSource empty{ 0, nullptr };
+        EXPECT_TRUE(ReadAll(empty).empty());
+    }
+
+    TEST_F(ArgSourceTests, ReadsContainers)
+    {
+        ContainerSource strings{ mediaArgs };
+        EXPECT_EQ(strings.RemainingHint(), 3);
+        EXPECT_EQ(ReadAll(strings), mediaArgs);
+
+        std::vector<std::string_view> views{ mediaArgs.begin(), 
+            mediaArgs.end() };
+        ContainerSource viewSource{ views };
+        EXPECT_EQ(ReadAll(viewSource), mediaArgs);
+
+        const char* array[]
+        { 
+            mediaProgramName, unixVerboseOptionShortName, mediaFileName1 
+        };
+        ContainerSource arraySource{ array };
+        EXPECT_EQ(ReadAll(arraySource), mediaArgs);
+    }
+
+    TEST_F(ArgSourceTests, ReadsResponseFiles)
+    {
+        std::string path = (std::filesystem::temp_directory_path() / 
+            "libcppcmdtests_ArgSourceTests.rsp").string();
+        {
+            std::ofstream file{ path, std::ios::binary };
+            for (auto& arg : mediaArgs)
+                file << arg << "\n";
+        }
+
+        {
+            ResponseFile file{ path };
+            ResponseFileSource source{ file };
+            EXPECT_EQ(source.RemainingHint(), 3);
+            EXPECT_EQ(ReadAll(source), mediaArgs);
+        }
+
+        std::remove(path.c_str());
+    }
+
+#ifndef _WIN32
+    TEST_F(ArgSourceTests, ReadsDescriptors)
+    {
+        int fds[2];
+        ASSERT_EQ(pipe(fds), 0);
+        std::string piped;
+        for (auto& arg : mediaArgs)
+            piped += arg + '\0';
+        ASSERT_EQ(write(fds[1], piped.data(), piped.size()), 
+            static_cast<ssize_t>(piped.size()));
+        close(fds[1]);
+
+        DescriptorSource source{ fds[0], '\0' };
+        EXPECT_EQ(ReadAll(source), mediaArgs);
+        EXPECT_FALSE(source.Failed());
+        close(fds[0]);
+    }
+
+    TEST_F(ArgSourceTests, DescriptorsCanKeepEmptyArguments)
+    {
+        std::vector<std::string> args{ mediaProgramName, "", mediaFileName1 };
+        int fds[2];
+        ASSERT_EQ(pipe(fds), 0);
+        std::string piped;
+        for (auto& arg : args)
+            piped += arg + '\0';
+        ASSERT_EQ(write(fds[1], piped.data(), piped.size()), 
+            static_cast<ssize_t>(piped.size()));
+        close(fds[1]);
+
+        DescriptorSource source{ fds[0], '\0', true };
+        EXPECT_EQ(ReadAll(source), args);
+        close(fds[0]);
+    }
+#endif
+
+#ifdef __linux__
+    TEST_F(ArgSourceTests, ReadsTheProcessCommandLine)
+    {
+        ProcCmdlineSource source;
+        ASSERT_FALSE(source.Failed());
+
+        // The test program's own name comes first.
+        std::vector<std::string> args = ReadAll(source);
+        ASSERT_FALSE(args.empty());
+        EXPECT_NE(args.front().find("libcppcmdtests"), std::string::npos);
+
+        // Each argument, even an empty one, ends with a NUL.
+        std::ifstream cmdline{ "/proc/self/cmdline", std::ios::binary };
+        std::string contents{ std::istreambuf_iterator<char>{ cmdline }, {} };
+        EXPECT_EQ(args.size(), static_cast<std::size_t>(
+            std::count(contents.begin(), contents.end(), '\0')));
+    }
+#endif
+
+    TEST_F(ArgSourceTests, CollectsArguments)
+    {
+        ContainerSource source{ mediaArgs };
+        EXPECT_EQ(CollectArgs(source), mediaArgs);
+        EXPECT_TRUE(CollectArgs(source).empty());
+    }
+
+    TEST_F(ArgSourceTests, ParsersReadSources)
+    {
+        ProgParam::Definition programDef;
+        programDef.name = mediaProgramName;
+        ProgParam program{ programDef };
+
+        Option::Definition verboseDef;
+        verboseDef.shortName = verboseOptionShortName;
+        Option verbose{ verboseDef };
+
+        PosParam::Definition fileDef;
+        fileDef.name = "FILE";
+        PosParam file{ fileDef };
+
+        ContainerSource source{ mediaArgs };
+        Parser parser{ &program, source };
+        parser.Add(&verbose);
+        parser.Add(&file);
+        ASSERT_EQ(parser.Parse(), Parser::Status::Success);
+        EXPECT_TRUE(verbose.IsSpecified());
+        EXPECT_EQ(file.Value(), mediaFileName1);
+    }
+}
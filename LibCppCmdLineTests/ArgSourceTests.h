@@ -0,0 +1,55 @@
+// ArgSourceTests.h - Declares the ArgSource tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_ARG_SOURCE_TESTS_H
+#define CMD_LINE_ARG_SOURCE_TESTS_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "gtest/gtest.h"
+#include "ArgSource.h"
+#include "ExampleArguments.h"
+#include "Parser.h"
+#include "PosParam.h"
+#include "ProgParam.h"
+
+namespace CmdLine
+{
+    /// @brief Test fixture for the ArgSource tests.
+    ///
+    /// Reads the arguments of a hypothetical media program from each kind
+    /// of ArgSource. See ArgSourceTests.cpp for the actual tests.
+    class ArgSourceTests : public ::testing::Test
+    {
+    protected:
+        /// @brief Reads every argument from a source as views.
+        ///
+        /// @param source The source to read.
+        /// @return The arguments, in order.
+        std::vector<std::string> ReadAll(ArgSource& source);
+
+        std::vector<std::string> mediaArgs
+        {
+            mediaProgramName,
+            unixVerboseOptionShortName,
+            mediaFileName1
+        };
+    };
+}
+
+#endif
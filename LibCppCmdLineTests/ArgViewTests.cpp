@@ -0,0 +1,164 @@
+// ArgViewTests.cpp - Defines the ArgView tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#include "ArgViewTests.h"
+
+#include <algorithm>
+#include "AllocationTracker.h"
+
+namespace CmdLine
+{
+    ArgViewTests::ArgViewTests()
+    {
+        ProgParam::Definition programDef;
+        programDef.name = mediaProgramName;
+        mediaProgram = std::make_unique<ProgParam>(programDef);
+
+        Option::Definition verboseDef;
+        verboseDef.shortName = verboseOptionShortName;
+        verboseDef.longName = verboseOptionLongName;
+        verbose = std::make_unique<Option>(verboseDef);
+
+        MultiPosParam::Definition filesDef;
+        filesDef.name = mediaFilesMultiPosName;
+        filesDef.isLazy = true;
+        mediaFiles = std::make_unique<MultiPosParam>(filesDef);
+    }
+
+    std::unique_ptr<Parser> ArgViewTests::MakeParser(
+        std::vector<std::string> args)
+    {
+        auto parser = std::make_unique<Parser>(mediaProgram.get(), 
+            std::move(args));
+        parser->Add(verbose.get());
+        parser->Set(mediaFiles.get());
+        return parser;
+    }
+
+    TEST_F(ArgViewTests, ViewsContiguousArguments)
+    {
+        std::vector<std::string> args
+        {
+            mediaProgramName, mediaFileName1, mediaFileName2
+        };
+        ArgView view{ args };
+        ASSERT_EQ(view.Size(), 3);
+        EXPECT_FALSE(view.IsEmpty());
+        EXPECT_EQ(view[1], mediaFileName1);
+        EXPECT_EQ(view[1].data(), args[1].data());
+        EXPECT_EQ(view.end() - view.begin(), 3);
+        EXPECT_EQ(*(view.begin() + 2), mediaFileName2);
+        EXPECT_TRUE(std::is_sorted(view.begin() + 1, view.end()));
+
+        ArgView files = view.Subview(1, 5);
+        ASSERT_EQ(files.Size(), 2);
+        EXPECT_EQ(files[0], mediaFileName1);
+        EXPECT_TRUE(view.Subview(3, 1).IsEmpty());
+        EXPECT_TRUE(ArgView{}.IsEmpty());
+    }
+
+    TEST_F(ArgViewTests, ViewsArgumentsOnlyWhenContiguous)
+    {
+        auto parser = MakeParser({ mediaProgramName, mediaFileName1,
+            unixVerboseOptionShortName, mediaFileName2 });
+        ASSERT_EQ(parser->Parse(), Parser::Status::Success);
+        EXPECT_TRUE(verbose->IsSpecified());
+        ASSERT_TRUE(mediaFiles->IsSpecified());
+
+        // The Option between the files means they aren't contiguous, so
+        // they're copied as usual.
+        std::vector<std::string> expected{ mediaFileName1, mediaFileName2 };
+        EXPECT_EQ(mediaFiles->Values(), expected);
+        EXPECT_EQ(mediaFiles->ValueView().Size(), 2);
+
+        ProgParam::Definition programDef;
+        programDef.name = mediaProgramName;
+        ProgParam program{ programDef };
+        MultiPosParam::Definition filesDef;
+        filesDef.name = mediaFilesMultiPosName;
+        filesDef.isLazy = true;
+        MultiPosParam files{ filesDef };
+        std::vector<std::string> args{ mediaProgramName, 
+            unixVerboseOptionShortName, mediaFileName1, mediaFileName2 };
+        Parser contiguous{ &program, args };
+        contiguous.Add(verbose.get());
+        contiguous.Set(&files);
+        ASSERT_EQ(contiguous.Parse(), Parser::Status::Success);
+        ASSERT_TRUE(files.IsSpecified());
+        EXPECT_EQ(files.Values(), expected);
+
+        ArgView view = files.ValueView();
+        ASSERT_EQ(view.Size(), 2);
+        EXPECT_EQ(view[0], mediaFileName1);
+        EXPECT_EQ(view[1], mediaFileName2);
+    }
+
+    TEST_F(ArgViewTests, LazyOperandsReferToTheArguments)
+    {
+        auto parser = MakeParser({ mediaProgramName, "--", 
+            unixVerboseOptionShortName, mediaFileName1 });
+        ASSERT_EQ(parser->Parse(), Parser::Status::Success);
+        EXPECT_FALSE(verbose->IsSpecified());
+
+        std::vector<std::string> expected
+        { 
+            unixVerboseOptionShortName, mediaFileName1 
+        };
+        EXPECT_EQ(mediaFiles->Values(), expected);
+
+        std::string_view first = mediaFiles->ValueView()[0];
+        EXPECT_EQ(first, unixVerboseOptionShortName);
+    }
+
+    TEST_F(ArgViewTests, PopulatingLazilyCopiesNothing)
+    {
+        std::vector<std::string> args{ mediaProgramName };
+        for (int i = 0; i < 10000; i++)
+            args.push_back("file" + std::to_string(i) + ".mp3");
+        auto parser = MakeParser(args);
+
+        AllocationScope scope;
+        ASSERT_TRUE(mediaFiles->PopulateView(ArgView{ args }.Subview(1, 
+            args.size())));
+        EXPECT_EQ(scope.Stats().allocations, 0);
+
+        ASSERT_EQ(mediaFiles->ValueView().Size(), 10000);
+        EXPECT_EQ(mediaFiles->ValueView()[9999], "file9999.mp3");
+        EXPECT_EQ(mediaFiles->ValueView()[0].data(), args[1].data());
+
+        // Populating again keeps the values from before.
+        std::vector<std::string> more{ mediaFileName1 };
+        ASSERT_TRUE(mediaFiles->PopulateView(ArgView{ more }));
+        ASSERT_EQ(mediaFiles->Values().size(), 10001);
+        EXPECT_EQ(mediaFiles->Values().back(), mediaFileName1);
+        EXPECT_FALSE(mediaFiles->PopulateView(ArgView{}));
+    }
+
+    TEST_F(ArgViewTests, ParsedLazyValuesViewTheParsersArguments)
+    {
+        std::vector<std::string> args{ mediaProgramName };
+        for (int i = 0; i < 1000; i++)
+            args.push_back("file" + std::to_string(i) + ".mp3");
+        auto parser = MakeParser(args);
+        ASSERT_EQ(parser->Parse(), Parser::Status::Success);
+
+        ArgView view = mediaFiles->ValueView();
+        ASSERT_EQ(view.Size(), 1000);
+        EXPECT_EQ(view[0], "file0.mp3");
+        EXPECT_TRUE(std::equal(view.begin(), view.end(), args.begin() + 1));
+    }
+}
@@ -0,0 +1,55 @@
+// ArgViewTests.h - Declares the ArgView test fixture.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_ARG_VIEW_TESTS_H
+#define CMD_LINE_ARG_VIEW_TESTS_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "ArgView.h"
+#include "ExampleArguments.h"
+#include "MultiPosParam.h"
+#include "Option.h"
+#include "Parser.h"
+#include "ProgParam.h"
+
+namespace CmdLine
+{
+    /// @brief Test fixture for the ArgView and lazy MultiPosParam tests.
+    ///
+    /// Parses the media files of a hypothetical media program into a lazy
+    /// MultiPosParam. See ArgViewTests.cpp for the actual tests.
+    class ArgViewTests : public ::testing::Test
+    {
+    protected:
+        ArgViewTests();
+
+        /// @brief Makes a Parser for the media program's parameters.
+        ///
+        /// @param args The arguments to parse.
+        /// @return The Parser.
+        std::unique_ptr<Parser> MakeParser(std::vector<std::string> args);
+
+        std::unique_ptr<ProgParam> mediaProgram;
+        std::unique_ptr<Option> verbose;
+        std::unique_ptr<MultiPosParam> mediaFiles;
+    };
+}
+
+#endif
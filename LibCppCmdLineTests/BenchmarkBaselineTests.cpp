@@ -0,0 +1,212 @@
+// BenchmarkBaselineTests.cpp - Defines the benchmark baseline tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include <cmath>
+#include "BenchmarkBaselineTests.h"
+
+namespace CmdLine
+{
+    BenchmarkBaseline BenchmarkBaselineTests::CreateBaseline(
+        const std::string& metric, std::vector<double> samples)
+    {
+        BenchmarkBaseline baseline;
+        baseline.benchmarks.push_back(BenchmarkSamples{ benchmarkName, {} });
+        baseline.benchmarks[0].metrics[metric] = samples;
+        return baseline;
+    }
+
+    MetricComparison BenchmarkBaselineTests::CompareOnly(
+        const BenchmarkBaseline& baseline, const BenchmarkBaseline& current)
+    {
+        std::vector<MetricComparison> comparisons = CompareToBaseline(
+            baseline, current, DefaultTrackedMetrics(),
+            ComparisonThresholds{});
+
+        EXPECT_EQ(comparisons.size(), 1);
+        return comparisons.empty() ? MetricComparison{} : comparisons[0];
+    }
+
+    TEST_F(BenchmarkBaselineTests, ReadsTrackedMetricsOfEachIteration)
+    {
+        BenchmarkBaseline baseline = ReadBenchmarkResults(
+            JsonValue::Parse(benchmarkResults), DefaultTrackedMetrics(),
+            "1.0");
+
+        EXPECT_EQ(baseline.libraryVersion, "1.0");
+        EXPECT_EQ(baseline.hostName, "builder");
+        EXPECT_EQ(baseline.cpuCount, 8);
+        EXPECT_EQ(baseline.buildType, "release");
+
+        ASSERT_EQ(baseline.benchmarks.size(), 2);
+        const BenchmarkSamples& parse = baseline.benchmarks[0];
+        EXPECT_EQ(parse.name, "BM_Parse/args:10");
+        EXPECT_EQ(parse.metrics.size(), 2);
+        EXPECT_EQ(parse.metrics.at("args/sec"),
+            std::vector<double>({ 2000, 2500 }));
+        EXPECT_EQ(parse.metrics.at("allocs"), std::vector<double>({ 12, 12 }));
+
+        const BenchmarkSamples& help = baseline.benchmarks[1];
+        EXPECT_EQ(help.name, "BM_GenerateHelp/options:10");
+        EXPECT_EQ(help.metrics.at("real_time"), std::vector<double>({ 2e6 }));
+    }
+
+    TEST_F(BenchmarkBaselineTests, RejectsFilesThatAreNotResults)
+    {
+        EXPECT_THROW(ReadBenchmarkResults(JsonValue::Parse("{}"),
+            DefaultTrackedMetrics(), "1.0"),
+            BenchmarkBaseline::InvalidBaseline);
+        EXPECT_THROW(ReadBenchmarkResults(
+            JsonValue::Parse("{\"context\": 1, \"benchmarks\": []}"),
+            DefaultTrackedMetrics(), "1.0"),
+            BenchmarkBaseline::InvalidBaseline);
+    }
+
+    TEST_F(BenchmarkBaselineTests, BaselineSurvivesJsonRoundTrip)
+    {
+        BenchmarkBaseline baseline = ReadBenchmarkResults(
+            JsonValue::Parse(benchmarkResults), DefaultTrackedMetrics(),
+            "1.0");
+
+        BenchmarkBaseline parsed = BaselineFromJson(
+            JsonValue::Parse(ToJson(baseline).Serialize()));
+
+        EXPECT_EQ(parsed.formatVersion, baselineFormatVersion);
+        EXPECT_EQ(parsed.libraryVersion, baseline.libraryVersion);
+        EXPECT_EQ(parsed.date, baseline.date);
+        EXPECT_EQ(parsed.hostName, baseline.hostName);
+        EXPECT_EQ(parsed.cpuCount, baseline.cpuCount);
+        EXPECT_EQ(parsed.buildType, baseline.buildType);
+        ASSERT_EQ(parsed.benchmarks.size(), baseline.benchmarks.size());
+        for (std::size_t i = 0; i < parsed.benchmarks.size(); i++)
+        {
+            EXPECT_EQ(parsed.benchmarks[i].name, baseline.benchmarks[i].name);
+            EXPECT_EQ(parsed.benchmarks[i].metrics,
+                baseline.benchmarks[i].metrics);
+        }
+    }
+
+    TEST_F(BenchmarkBaselineTests, RejectsUnsupportedFormatVersions)
+    {
+        JsonValue json = ToJson(BenchmarkBaseline{});
+        json.Set("format_version",
+            static_cast<double>(baselineFormatVersion + 1));
+
+        EXPECT_THROW(BaselineFromJson(json),
+            BenchmarkBaseline::InvalidBaseline);
+    }
+
+    TEST_F(BenchmarkBaselineTests, StudentTUpperTailMatchesKnownValues)
+    {
+        EXPECT_NEAR(StudentTUpperTail(0, 5), 0.5, 1e-12);
+        EXPECT_NEAR(StudentTUpperTail(1, 1), 0.25, 1e-12);
+        EXPECT_NEAR(StudentTUpperTail(2, 10), 0.036694017385, 1e-9);
+        EXPECT_NEAR(StudentTUpperTail(-2, 10), 1 - 0.036694017385, 1e-9);
+    }
+
+    TEST_F(BenchmarkBaselineTests, WelchTTestMatchesKnownValues)
+    {
+        std::vector<double> first{ 19.8, 20.4, 19.6, 17.8, 18.5, 18.9, 18.3,
+            18.9, 19.5, 22.0 };
+        std::vector<double> second{ 28.2, 26.6, 20.1, 23.3, 25.2, 22.1, 17.7,
+            27.6, 20.6, 13.7, 23.2, 17.5, 20.6, 18.0, 23.9, 21.6, 24.3, 20.4,
+            23.9, 13.3 };
+
+        WelchResult result = WelchTTest(first, second);
+
+        EXPECT_NEAR(result.t, 2.225512039970, 1e-9);
+        EXPECT_NEAR(result.degreesOfFreedom, 24.524634944257, 1e-9);
+        EXPECT_NEAR(result.pValue, 0.017742265415, 1e-9);
+    }
+
+    TEST_F(BenchmarkBaselineTests, WelchTTestHandlesDegenerateSamples)
+    {
+        EXPECT_EQ(WelchTTest({ 12, 12 }, { 13, 13 }).pValue, 0);
+        EXPECT_EQ(WelchTTest({ 12, 12 }, { 12, 12 }).pValue, 1);
+        EXPECT_EQ(WelchTTest({ 13, 13 }, { 12, 12 }).pValue, 1);
+        EXPECT_TRUE(std::isnan(WelchTTest({ 12 }, { 13, 14 }).pValue));
+    }
+
+    TEST_F(BenchmarkBaselineTests, ReportsSignificantThroughputRegressions)
+    {
+        MetricComparison c = CompareOnly(
+            CreateBaseline("args/sec", { 1000, 1010, 990, 1005, 995 }),
+            CreateBaseline("args/sec", { 800, 810, 790, 805, 795 }));
+
+        EXPECT_EQ(c.benchmark, benchmarkName);
+        EXPECT_EQ(c.metric, "args/sec");
+        EXPECT_NEAR(c.change, 0.2, 1e-12);
+        EXPECT_TRUE(c.regression);
+        EXPECT_FALSE(c.improvement);
+    }
+
+    TEST_F(BenchmarkBaselineTests, ReportsSignificantThroughputImprovements)
+    {
+        MetricComparison c = CompareOnly(
+            CreateBaseline("args/sec", { 800, 810, 790, 805, 795 }),
+            CreateBaseline("args/sec", { 1000, 1010, 990, 1005, 995 }));
+
+        EXPECT_NEAR(c.change, -0.25, 1e-12);
+        EXPECT_FALSE(c.regression);
+        EXPECT_TRUE(c.improvement);
+    }
+
+    TEST_F(BenchmarkBaselineTests, IgnoresNoisyChanges)
+    {
+        MetricComparison c = CompareOnly(
+            CreateBaseline("args/sec", { 1000, 1400, 600, 1300, 700 }),
+            CreateBaseline("args/sec", { 900, 1300, 500, 1200, 600 }));
+
+        EXPECT_GT(c.pValue, ComparisonThresholds{}.significance);
+        EXPECT_FALSE(c.regression);
+    }
+
+    TEST_F(BenchmarkBaselineTests, IgnoresSignificantButSmallChanges)
+    {
+        MetricComparison c = CompareOnly(
+            CreateBaseline("args/sec", { 1000, 1001, 999, 1000, 1000 }),
+            CreateBaseline("args/sec", { 990, 991, 989, 990, 990 }));
+
+        EXPECT_LT(c.pValue, ComparisonThresholds{}.significance);
+        EXPECT_FALSE(c.regression);
+    }
+
+    TEST_F(BenchmarkBaselineTests, ReportsAnyIncreaseInAllocations)
+    {
+        MetricComparison fewer = CompareOnly(
+            CreateBaseline("allocs", { 20, 20, 20 }),
+            CreateBaseline("allocs", { 12, 12, 12 }));
+        MetricComparison more = CompareOnly(
+            CreateBaseline("allocs", { 20, 20, 20 }),
+            CreateBaseline("allocs", { 22, 22, 22 }));
+        MetricComparison fromNone = CompareOnly(
+            CreateBaseline("allocs", { 0, 0, 0 }),
+            CreateBaseline("allocs", { 1, 1, 1 }));
+
+        EXPECT_TRUE(fewer.improvement);
+        EXPECT_TRUE(more.regression);
+        EXPECT_TRUE(fromNone.regression);
+    }
+
+    TEST_F(BenchmarkBaselineTests, OnlyComparesBenchmarksInBoth)
+    {
+        BenchmarkBaseline baseline = CreateBaseline("allocs", { 1, 1 });
+        BenchmarkBaseline current = CreateBaseline("allocs", { 1, 1 });
+        current.benchmarks[0].name = "BM_Parse/args:10";
+
+        EXPECT_TRUE(CompareToBaseline(baseline, current,
+            DefaultTrackedMetrics(), ComparisonThresholds{}).empty());
+    }
+}
@@ -0,0 +1,97 @@
+// BenchmarkBaselineTests.h - Declares the BenchmarkBaselineTests fixture.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_BENCHMARK_BASELINE_TESTS_H
+#define CMD_LINE_BENCHMARK_BASELINE_TESTS_H
+
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "BenchmarkBaseline.h"
+#include "Json.h"
+
+namespace CmdLine
+{
+    /// @brief Test fixture for the benchmark baseline tests.
+    ///
+    /// Checks that benchmark results are read and stored as baselines
+    /// correctly, that the statistics behind the comparison are accurate
+    /// and that only significant changes are reported. See
+    /// BenchmarkBaselineTests.cpp for the actual tests.
+    class BenchmarkBaselineTests : public ::testing::Test
+    {
+    protected:
+        /// @brief Creates a baseline of one benchmark with one metric.
+        ///
+        /// @param metric The name of the metric.
+        /// @param samples The samples of the metric.
+        /// @return The baseline.
+        BenchmarkBaseline CreateBaseline(const std::string& metric,
+            std::vector<double> samples);
+
+        /// @brief Compares two baselines with the default tracked metrics.
+        ///
+        /// @param baseline The baseline to compare to.
+        /// @param current The run to compare.
+        /// @return The only comparison made.
+        MetricComparison CompareOnly(const BenchmarkBaseline& baseline,
+            const BenchmarkBaseline& current);
+
+        /// @brief The name of the benchmark in created baselines.
+        const std::string benchmarkName{
+            "BM_Parse/args:1000/options:10/value%:25/order:0/manual_time" };
+
+        /// @brief Two repetitions of BM_Parse and their aggregates, along
+        /// with an untracked benchmark and a failed one.
+        const std::string benchmarkResults
+        {
+            "{"
+            "  \"context\": {"
+            "    \"date\": \"2024-05-01T10:00:00+00:00\","
+            "    \"host_name\": \"builder\","
+            "    \"num_cpus\": 8,"
+            "    \"library_build_type\": \"debug\","
+            "    \"libcppcmdline_build_type\": \"release\""
+            "  },"
+            "  \"benchmarks\": ["
+            "    { \"run_name\": \"BM_Parse/args:10\", "
+            "      \"run_type\": \"iteration\", \"real_time\": 5, "
+            "      \"time_unit\": \"us\", \"args/sec\": 2000, "
+            "      \"allocs\": 12 },"
+            "    { \"run_name\": \"BM_Parse/args:10\", "
+            "      \"run_type\": \"iteration\", \"real_time\": 4, "
+            "      \"time_unit\": \"us\", \"args/sec\": 2500, "
+            "      \"allocs\": 12 },"
+            "    { \"run_name\": \"BM_Parse/args:10\", "
+            "      \"run_type\": \"aggregate\", \"real_time\": 4.5, "
+            "      \"time_unit\": \"us\", \"args/sec\": 2250, "
+            "      \"allocs\": 12 },"
+            "    { \"run_name\": \"BM_GenerateHelp/options:10\", "
+            "      \"run_type\": \"iteration\", \"real_time\": 2, "
+            "      \"time_unit\": \"ms\" },"
+            "    { \"run_name\": \"BM_GenerateHelp/options:100\", "
+            "      \"run_type\": \"iteration\", \"error_occurred\": true, "
+            "      \"real_time\": 0, \"time_unit\": \"ms\" },"
+            "    { \"run_name\": \"BM_ConstructParser\", "
+            "      \"run_type\": \"iteration\", \"real_time\": 1, "
+            "      \"time_unit\": \"ns\" }"
+            "  ]"
+            "}"
+        };
+    };
+}
+
+#endif
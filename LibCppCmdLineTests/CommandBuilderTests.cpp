@@ -0,0 +1,303 @@
+// CommandBuilderTests.cpp - Defines the CommandBuilder tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#include "CommandBuilderTests.h"
+
+#include <cstdio>
+#include <filesystem>
+#include "ResponseFile.h"
+
+namespace CmdLine
+{
+    CopyProgram::CopyProgram(MultiPosParam::ParsingOrder order)
+    {
+        ProgParam::Definition programDef;
+        programDef.name = copyProgramName;
+        program = std::make_unique<ProgParam>(programDef);
+
+        Option::Definition verboseDef;
+        verboseDef.shortName = verboseOptionShortName;
+        verboseDef.longName = verboseOptionLongName;
+        verbose = std::make_unique<Option>(verboseDef);
+
+        ValueOption::Definition printDef;
+        printDef.shortName = printOptionShortName;
+        printDef.longName = printOptionLongName;
+        print = std::make_unique<ValueOption>(printDef);
+
+        MultiPosParam::Definition sourcesDef;
+        sourcesDef.name = copySourceMultiPosName;
+        sourcesDef.order = order;
+        sourcesDef.isLazy = true;
+        sources = std::make_unique<MultiPosParam>(sourcesDef);
+
+        PosParam::Definition destinationDef;
+        destinationDef.name = copyDestinationPosName;
+        destination = std::make_unique<PosParam>(destinationDef);
+    }
+
+    Parser::Status CopyProgram::Parse(std::vector<std::string> args)
+    {
+        parser = std::make_unique<Parser>(program.get(), std::move(args));
+        parser->Add(verbose.get());
+        parser->Add(print.get());
+        parser->Add(destination.get());
+        parser->Set(sources.get());
+        return parser->Parse();
+    }
+
+    void CopyProgram::AddTo(CommandBuilder& builder) const
+    {
+        builder.Add(*verbose);
+        builder.Add(*print);
+        builder.Add(*destination);
+        builder.Set(*sources);
+    }
+
+    CommandBuilderTests::~CommandBuilderTests()
+    {
+        for (auto& path : writtenFiles)
+            std::remove(path.c_str());
+    }
+
+    std::string CommandBuilderTests::TempPath(const std::string& name)
+    {
+        // Tests may run in parallel, so each test's files are named after it.
+        std::string test = 
+            ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        std::filesystem::path path = std::filesystem::temp_directory_path() / 
+            ("libcppcmdtests_" + test + "_" + name);
+
+        writtenFiles.push_back(path.string());
+        return path.string();
+    }
+
+    std::vector<std::string> CommandBuilderTests::CopyArgs(
+        std::size_t sourceCount, MultiPosParam::ParsingOrder order) const
+    {
+        std::vector<std::string> args{ copyProgramName, 
+            unixVerboseOptionShortName, unixPrintOptionShortName, 
+            songOptionParamName };
+        if (order == MultiPosParam::ParsingOrder::End)
+            args.push_back(copyDestinationFileName);
+        for (std::size_t i = 0; i < sourceCount; i++)
+            args.push_back("src/file" + std::to_string(i) + ".cpp");
+        if (order == MultiPosParam::ParsingOrder::AfterOptions)
+            args.push_back(copyDestinationFileName);
+        return args;
+    }
+
+    TEST_F(CommandBuilderTests, RebuildsTheParsedArguments)
+    {
+        CopyProgram copy;
+        ASSERT_EQ(copy.Parse(CopyArgs(2)), Parser::Status::Success);
+
+        CommandBuilder builder{ copyProgramName };
+        copy.AddTo(builder);
+        std::vector<std::vector<std::string>> commands;
+        builder.Build(commands);
+
+        ASSERT_EQ(commands.size(), 1);
+        std::vector<std::string> expected
+        {
+            copyProgramName, unixVerboseOptionShortName, 
+            unixPrintOptionShortName, songOptionParamName, 
+            copyDestinationFileName, "src/file0.cpp", "src/file1.cpp"
+        };
+        EXPECT_EQ(commands[0], expected);
+
+        CopyProgram child;
+        ASSERT_EQ(child.Parse(commands[0]), Parser::Status::Success);
+        EXPECT_TRUE(child.verbose->IsSpecified());
+        EXPECT_EQ(child.print->Values(), copy.print->Values());
+        EXPECT_EQ(child.destination->Value(), copyDestinationFileName);
+        EXPECT_EQ(child.sources->Values(), copy.sources->Values());
+    }
+
+    TEST_F(CommandBuilderTests, LeavesOutUnspecifiedParams)
+    {
+        CopyProgram copy;
+        ASSERT_EQ(copy.Parse({ copyProgramName }), Parser::Status::Success);
+
+        CommandBuilder builder{ copyProgramName };
+        copy.AddTo(builder);
+        std::vector<std::vector<std::string>> commands;
+        builder.Build(commands);
+
+        std::vector<std::vector<std::string>> expected{ { copyProgramName } };
+        EXPECT_EQ(commands, expected);
+    }
+
+    TEST_F(CommandBuilderTests, BatchesValuesWithinTheLimit)
+    {
+        CopyProgram copy;
+        ASSERT_EQ(copy.Parse(CopyArgs(1000)), Parser::Status::Success);
+
+        ArgLimits limits{ 4096, 4096 };
+        CommandBuilder builder{ copyProgramName, limits };
+        copy.AddTo(builder);
+        std::vector<std::vector<std::string>> commands;
+        builder.Build(commands);
+        ASSERT_GT(commands.size(), 1);
+
+        std::vector<std::string> sources;
+        for (auto& command : commands)
+        {
+            std::size_t size = 0;
+            for (auto& arg : command)
+                size += CommandBuilder::ArgSize(arg);
+            EXPECT_LE(size, limits.total);
+
+            CopyProgram child;
+            ASSERT_EQ(child.Parse(command), Parser::Status::Success);
+            EXPECT_TRUE(child.verbose->IsSpecified());
+            EXPECT_EQ(child.destination->Value(), copyDestinationFileName);
+
+            std::vector<std::string> batch = child.sources->Values();
+            sources.insert(sources.end(), batch.begin(), batch.end());
+        }
+
+        EXPECT_EQ(sources, copy.sources->Values());
+    }
+
+    TEST_F(CommandBuilderTests, KeepsTheParsingOrder)
+    {
+        MultiPosParam::ParsingOrder order{ 
+            MultiPosParam::ParsingOrder::AfterOptions };
+        CopyProgram copy{ order };
+        ASSERT_EQ(copy.Parse(CopyArgs(2, order)), Parser::Status::Success);
+
+        CommandBuilder builder{ copyProgramName };
+        copy.AddTo(builder);
+        std::vector<std::vector<std::string>> commands;
+        builder.Build(commands);
+        ASSERT_EQ(commands.size(), 1);
+        EXPECT_EQ(commands[0].back(), copyDestinationFileName);
+
+        CopyProgram child{ order };
+        ASSERT_EQ(child.Parse(commands[0]), Parser::Status::Success);
+        EXPECT_EQ(child.destination->Value(), copyDestinationFileName);
+        EXPECT_EQ(child.sources->Values(), copy.sources->Values());
+    }
+
+    TEST_F(CommandBuilderTests, MarksValuesThatLookLikeOptions)
+    {
+        CopyProgram copy;
+        ASSERT_EQ(copy.Parse({ copyProgramName, endOfOptionsMarker, 
+            copyDestinationFileName, unixVerboseOptionShortName }), 
+            Parser::Status::Success);
+
+        CommandBuilder builder{ copyProgramName };
+        copy.AddTo(builder);
+        std::vector<std::vector<std::string>> commands;
+        builder.Build(commands);
+
+        std::vector<std::string> expected
+        {
+            copyProgramName, endOfOptionsMarker, copyDestinationFileName, 
+            unixVerboseOptionShortName
+        };
+        ASSERT_EQ(commands.size(), 1);
+        EXPECT_EQ(commands[0], expected);
+    }
+
+    TEST_F(CommandBuilderTests, MarksValuesThatAreTheEndOfOptionsMarker)
+    {
+        CopyProgram copy;
+        ASSERT_EQ(copy.Parse({ copyProgramName, endOfOptionsMarker, 
+            copyDestinationFileName, "a", endOfOptionsMarker, "b" }), 
+            Parser::Status::Success);
+        std::vector<std::string> values{ "a", endOfOptionsMarker, "b" };
+        ASSERT_EQ(copy.sources->Values(), values);
+
+        CommandBuilder builder{ copyProgramName };
+        copy.AddTo(builder);
+        std::vector<std::vector<std::string>> commands;
+        builder.Build(commands);
+
+        ASSERT_EQ(commands.size(), 1);
+        CopyProgram child;
+        ASSERT_EQ(child.Parse(commands[0]), Parser::Status::Success);
+        EXPECT_EQ(child.destination->Value(), copyDestinationFileName);
+        EXPECT_EQ(child.sources->Values(), values);
+
+        std::vector<std::string> command;
+        builder.Spill(TempPath("marker.rsp"), command);
+        ExpandResponseFiles(command);
+        CopyProgram spilled;
+        ASSERT_EQ(spilled.Parse(command), Parser::Status::Success);
+        EXPECT_EQ(spilled.destination->Value(), copyDestinationFileName);
+        EXPECT_EQ(spilled.sources->Values(), values);
+    }
+
+    TEST_F(CommandBuilderTests, SpillsValuesThatDontFit)
+    {
+        CopyProgram copy;
+        std::vector<std::string> args = CopyArgs(10);
+        args[7] = std::string(200, 'x');
+        ASSERT_EQ(copy.Parse(args), Parser::Status::Success);
+
+        ArgLimits limits{ 4096, 100 };
+        CommandBuilder builder{ copyProgramName, limits };
+        copy.AddTo(builder);
+        std::vector<std::vector<std::string>> commands;
+        EXPECT_CMD_LINE_ERROR(builder.Build(commands), 
+            CommandBuilder::ArgumentsTooLong, ErrorCode::ArgumentsTooLong);
+        EXPECT_TRUE(commands.empty());
+
+        std::string path = TempPath("sources.rsp");
+        builder.Build(commands, path);
+        std::vector<std::string> expected
+        {
+            copyProgramName, unixVerboseOptionShortName, 
+            unixPrintOptionShortName, songOptionParamName, "@" + path
+        };
+        ASSERT_EQ(commands.size(), 1);
+        EXPECT_EQ(commands[0], expected);
+
+        std::vector<std::string> expanded = commands[0];
+        ExpandResponseFiles(expanded);
+        CopyProgram child;
+        ASSERT_EQ(child.Parse(expanded), Parser::Status::Success);
+        EXPECT_TRUE(child.verbose->IsSpecified());
+        EXPECT_EQ(child.destination->Value(), copyDestinationFileName);
+        EXPECT_EQ(child.sources->Values(), copy.sources->Values());
+    }
+
+    TEST_F(CommandBuilderTests, CantSpillValuesThatSpanLines)
+    {
+        CopyProgram copy;
+        std::vector<std::string> args = CopyArgs(2);
+        args[5] = "two\nlines";
+        ASSERT_EQ(copy.Parse(args), Parser::Status::Success);
+
+        CommandBuilder builder{ copyProgramName };
+        copy.AddTo(builder);
+        std::vector<std::string> command;
+        EXPECT_CMD_LINE_ERROR(builder.Spill(TempPath("lines.rsp"), command), 
+            CommandBuilder::Unwritable, ErrorCode::UnwritableResponseFile);
+        EXPECT_TRUE(command.empty());
+    }
+
+    TEST_F(CommandBuilderTests, GetsTheSystemLimits)
+    {
+        ArgLimits limits = SystemArgLimits();
+        EXPECT_GT(limits.total, 0);
+        EXPECT_GT(limits.perArgument, 0);
+        EXPECT_LE(limits.perArgument, limits.total);
+    }
+}
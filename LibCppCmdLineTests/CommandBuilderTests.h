@@ -0,0 +1,97 @@
+// CommandBuilderTests.h - Declares the CommandBuilder test fixture.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_COMMAND_BUILDER_TESTS_H
+#define CMD_LINE_COMMAND_BUILDER_TESTS_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "CommandBuilder.h"
+#include "ExampleArguments.h"
+#include "MultiPosParam.h"
+#include "Option.h"
+#include "Parser.h"
+#include "PosParam.h"
+#include "ProgParam.h"
+#include "TestAlgorithms.h"
+#include "ValueOption.h"
+
+namespace CmdLine
+{
+    /// @brief The parameters of a hypothetical copy program.
+    struct CopyProgram
+    {
+        /// @brief Constructs the parameters.
+        ///
+        /// @param order The ParsingOrder of the source files.
+        CopyProgram(MultiPosParam::ParsingOrder order = 
+            MultiPosParam::ParsingOrder::End);
+
+        /// @brief Parses arguments into the parameters.
+        ///
+        /// @param args The arguments to parse.
+        /// @return The result of Parser::Parse().
+        Parser::Status Parse(std::vector<std::string> args);
+
+        /// @brief Adds the parameters to a CommandBuilder.
+        ///
+        /// @param builder The CommandBuilder.
+        void AddTo(CommandBuilder& builder) const;
+
+        std::unique_ptr<ProgParam> program;
+        std::unique_ptr<Option> verbose;
+        std::unique_ptr<ValueOption> print;
+        std::unique_ptr<MultiPosParam> sources;
+        std::unique_ptr<PosParam> destination;
+        std::unique_ptr<Parser> parser;
+    };
+
+    /// @brief Test fixture for the CommandBuilder tests.
+    ///
+    /// Rebuilds the commands of a hypothetical copy program from the 
+    /// arguments it parsed. See CommandBuilderTests.cpp for the actual 
+    /// tests.
+    class CommandBuilderTests : public ::testing::Test
+    {
+    protected:
+        /// @brief Removes the response files written by the test.
+        ~CommandBuilderTests();
+
+        /// @brief Gets a path for a response file.
+        ///
+        /// @param name The name of the file in the temporary directory.
+        /// @return The path of the file, which is removed after the test.
+        std::string TempPath(const std::string& name);
+
+        /// @brief Gets the arguments of a copy command.
+        ///
+        /// @param sourceCount The number of source files.
+        /// @param order The ParsingOrder the arguments are for, which 
+        /// determines whether the destination is before or after the 
+        /// source files.
+        /// @return The arguments.
+        std::vector<std::string> CopyArgs(std::size_t sourceCount, 
+            MultiPosParam::ParsingOrder order = 
+                MultiPosParam::ParsingOrder::End) const;
+
+        std::vector<std::string> writtenFiles;
+    };
+}
+
+#endif
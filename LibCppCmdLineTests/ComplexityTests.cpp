@@ -0,0 +1,199 @@
+// ComplexityTests.cpp - Defines the algorithmic complexity tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include "ComplexityTests.h"
+
+namespace CmdLine
+{
+    using Placement = SyntheticArgsSpec::OptionPlacement;
+
+    double ComplexityTests::MeasureGrowth(const TimedRun& run, 
+        std::size_t baseSize)
+    {
+        std::vector<double> logSizes;
+        std::vector<double> logTimes;
+
+        for (int d = 0; d <= sizeDoublings; d++)
+        {
+            std::size_t size = baseSize << d;
+
+            std::chrono::duration<double> fastest = run(size);
+            for (int r = 1; r < repetitions; r++)
+                fastest = std::min(fastest, run(size));
+
+            // Guard against a clock too coarse to measure the run at all.
+            double seconds = std::max(fastest.count(), 1e-9);
+
+            logSizes.push_back(std::log(static_cast<double>(size)));
+            logTimes.push_back(std::log(seconds));
+        }
+
+        // Fit log(t) = k * log(n) + log(c) with least squares, k is the slope.
+        double n = static_cast<double>(logSizes.size());
+        double meanSize = 0;
+        double meanTime = 0;
+        for (std::size_t i = 0; i < logSizes.size(); i++)
+        {
+            meanSize += logSizes[i] / n;
+            meanTime += logTimes[i] / n;
+        }
+
+        double covariance = 0;
+        double variance = 0;
+        for (std::size_t i = 0; i < logSizes.size(); i++)
+        {
+            covariance += (logSizes[i] - meanSize) * (logTimes[i] - meanTime);
+            variance += (logSizes[i] - meanSize) * (logSizes[i] - meanSize);
+        }
+
+        return covariance / variance;
+    }
+
+    std::chrono::duration<double> ComplexityTests::TimeParse(
+        std::size_t argCount, SyntheticArgsSpec::OptionPlacement placement,
+        MultiPosParam::ParsingOrder order)
+    {
+        SyntheticSchemaSpec schemaSpec;
+        schemaSpec.optionCount = parseOptionCount;
+        schemaSpec.order = order;
+
+        SyntheticArgsSpec argsSpec;
+        argsSpec.argCount = argCount;
+        argsSpec.placement = placement;
+
+        SyntheticSchema schema = GenerateSyntheticSchema(schemaSpec);
+        auto parser = CreateSyntheticParser(schema, 
+            GenerateSyntheticArgs(schema, argsSpec));
+
+        auto start = std::chrono::steady_clock::now();
+        Parser::Status status = parser->Parse();
+        auto end = std::chrono::steady_clock::now();
+
+        EXPECT_EQ(status, Parser::Status::Success);
+        return end - start;
+    }
+
+    TEST_F(ComplexityTests, ParserAddGrowsLinearlyWithOptions)
+    {
+        auto run = [](std::size_t n)
+        {
+            SyntheticSchemaSpec spec;
+            spec.optionCount = n;
+            SyntheticSchema schema = GenerateSyntheticSchema(spec);
+
+            auto start = std::chrono::steady_clock::now();
+            Parser parser{ schema.program.get(), { "synthetic" } };
+            for (auto& o : schema.options)
+                parser.Add(o.option.get());
+            auto end = std::chrono::steady_clock::now();
+
+            return std::chrono::duration<double>{ end - start };
+        };
+
+        EXPECT_LT(MeasureGrowth(run, 2000), linearGrowthLimit);
+    }
+
+    TEST_F(ComplexityTests, SettingOptionStyleGrowsLinearlyWithOptions)
+    {
+        auto run = [](std::size_t n)
+        {
+            SyntheticSchemaSpec spec;
+            spec.optionCount = n;
+            SyntheticSchema schema = GenerateSyntheticSchema(spec);
+            auto parser = CreateSyntheticParser(schema, { "synthetic" });
+
+            auto start = std::chrono::steady_clock::now();
+            parser->Set(Option::Style::Windows);
+            auto end = std::chrono::steady_clock::now();
+
+            return std::chrono::duration<double>{ end - start };
+        };
+
+        EXPECT_LT(MeasureGrowth(run, 2000), linearGrowthLimit);
+    }
+
+    TEST_F(ComplexityTests, ParseGrowsLinearlyWithOptionsFirst)
+    {
+        auto run = [this](std::size_t n)
+        {
+            return TimeParse(n, Placement::First,
+                MultiPosParam::ParsingOrder::End);
+        };
+
+        EXPECT_LT(MeasureGrowth(run, 2000), linearGrowthLimit);
+    }
+
+    TEST_F(ComplexityTests, ParseGrowsLinearlyWithOptionsInterleaved)
+    {
+        auto run = [this](std::size_t n)
+        {
+            return TimeParse(n, Placement::Interleaved,
+                MultiPosParam::ParsingOrder::End);
+        };
+
+        EXPECT_LT(MeasureGrowth(run, 2000), linearGrowthLimit);
+    }
+
+    TEST_F(ComplexityTests, ParseGrowsLinearlyWithOptionsLast)
+    {
+        auto run = [this](std::size_t n)
+        {
+            return TimeParse(n, Placement::Last,
+                MultiPosParam::ParsingOrder::End);
+        };
+
+        EXPECT_LT(MeasureGrowth(run, 2000), linearGrowthLimit);
+    }
+
+    TEST_F(ComplexityTests, ParseGrowsLinearlyWithMultiPosParamAfterOptions)
+    {
+        auto run = [this](std::size_t n)
+        {
+            return TimeParse(n, Placement::Interleaved,
+                MultiPosParam::ParsingOrder::AfterOptions);
+        };
+
+        EXPECT_LT(MeasureGrowth(run, 2000), linearGrowthLimit);
+    }
+
+    TEST_F(ComplexityTests, MultiPosParamPopulationGrowsLinearly)
+    {
+        auto run = [](std::size_t n)
+        {
+            MultiPosParam::Definition d;
+            d.name = "sources";
+            MultiPosParam sources{ d };
+
+            std::deque<std::string> args;
+            for (std::size_t i = 0; i < n; i++)
+                args.push_back("file" + std::to_string(i));
+
+            auto start = std::chrono::steady_clock::now();
+            std::size_t consumes = sources.Consumes(args);
+            bool populated = sources.CanPopulate(args) && 
+                sources.Populate(args);
+            auto end = std::chrono::steady_clock::now();
+
+            EXPECT_EQ(consumes, n);
+            EXPECT_TRUE(populated);
+            return std::chrono::duration<double>{ end - start };
+        };
+
+        EXPECT_LT(MeasureGrowth(run, 2000), linearGrowthLimit);
+    }
+}
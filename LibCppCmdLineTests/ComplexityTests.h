@@ -0,0 +1,95 @@
+// ComplexityTests.h - Declares the ComplexityTests fixture.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_COMPLEXITY_TESTS_H
+#define CMD_LINE_COMPLEXITY_TESTS_H
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "SyntheticCli.h"
+#include "Parser.h"
+#include "MultiPosParam.h"
+
+namespace CmdLine
+{
+    /// @brief Test fixture for the algorithmic complexity tests.
+    ///
+    /// Runs code paths that have previously been superlinear at doubling
+    /// input sizes, times each size and estimates how fast the running time
+    /// grows. A test fails when the growth is clearly worse than linear (or
+    /// n log n), so a quadratic blowup is caught before it is released. The
+    /// timings are only compared against each other, never against absolute
+    /// limits, so the tests hold on both fast and slow machines, but other
+    /// load on the machine can still skew them. They are therefore built
+    /// into libcppcmdcomplexity instead of libcppcmdtests and only run on
+    /// demand. See ComplexityTests.cpp for the actual tests.
+    class ComplexityTests : public ::testing::Test
+    {
+    protected:
+        /// @brief Runs a code path once for an input size and times it.
+        ///
+        /// Only the work being measured should be timed, not the setup.
+        using TimedRun = std::function<std::chrono::duration<double>(
+            std::size_t)>;
+
+        /// @brief Estimates how fast the running time of a code path grows.
+        ///
+        /// Times the code path at the base size and at each doubling of it,
+        /// keeping the fastest of several runs for each size to filter out
+        /// noise, then fits t(n) = c * n^k to the timings. 
+        /// 
+        /// @param run Runs the code path for an input size and times it.
+        /// @param baseSize The smallest input size to run.
+        /// @return The estimated growth exponent, k (1 for linear growth).
+        double MeasureGrowth(const TimedRun& run, std::size_t baseSize);
+
+        /// @brief Times Parser::Parse() on synthetic arguments.
+        ///
+        /// Only parsing is timed, not generating the schema and arguments or
+        /// creating the Parser.
+        ///
+        /// @param argCount The number of arguments after the program name.
+        /// @param placement Where the option arguments should appear.
+        /// @param order The ParsingOrder of the MultiPosParam.
+        /// @return The time taken to parse.
+        std::chrono::duration<double> TimeParse(std::size_t argCount,
+            SyntheticArgsSpec::OptionPlacement placement, 
+            MultiPosParam::ParsingOrder order);
+
+        /// @brief The number of times the base input size is doubled.
+        const int sizeDoublings = 3;
+
+        /// @brief The number of times each input size is timed.
+        const int repetitions = 5;
+
+        /// @brief The largest growth exponent accepted as (near) linear.
+        ///
+        /// Linear growth measures close to 1 and n log n growth only 
+        /// slightly higher, while quadratic growth measures close to 2.
+        const double linearGrowthLimit = 1.5;
+
+        /// @brief The number of Options defined when timing parsing.
+        const std::size_t parseOptionCount = 20;
+    };
+}
+
+#endif
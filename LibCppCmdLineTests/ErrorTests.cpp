@@ -0,0 +1,153 @@
+// ErrorTests.cpp - Defines the Error tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include "ErrorTests.h"
+
+namespace CmdLine
+{
+    ErrorTests::ErrorTests()
+    {
+        mediaProgramDef.name = mediaProgramName;
+        mediaProgramDef.description = mediaProgramDescription;
+
+        verboseDef.shortName = verboseOptionShortName;
+        verboseDef.longName = verboseOptionLongName;
+        verboseDef.description = verboseOptionDescription;
+
+        printDef.shortName = printOptionShortName;
+        printDef.longName = printOptionLongName;
+        printDef.description = printOptionDescription;
+
+        songDef.name = songOptionParamName;
+        songDef.description = songOptionParamDescription;
+
+        mediaProgParam = std::make_unique<ProgParam>(mediaProgramDef);
+        verboseOption = std::make_unique<Option>(verboseDef);
+        printOption = std::make_unique<ValueOption>(printDef);
+        songParam = std::make_unique<OptionParam>(songDef);
+        mediaParser = std::make_unique<Parser>(mediaProgParam.get(), 
+            mediaArgs);
+    }
+
+    TEST_F(ErrorTests, ValidParamsHaveNoConstructionError)
+    {
+        EXPECT_EQ(mediaProgParam->ConstructionError().code, ErrorCode::None);
+        EXPECT_EQ(verboseOption->ConstructionError().code, ErrorCode::None);
+        EXPECT_EQ(printOption->ConstructionError().code, ErrorCode::None);
+        EXPECT_EQ(songParam->ConstructionError().code, ErrorCode::None);
+        EXPECT_EQ(mediaParser->ConstructionError().code, ErrorCode::None);
+        EXPECT_EQ(NameValuePair{ songOptionParamName }.ConstructionError().code,
+            ErrorCode::None);
+    }
+
+    TEST_F(ErrorTests, SuccessfulAddsReturnNoError)
+    {
+        EXPECT_EQ(mediaParser->Add(verboseOption.get()).code, 
+            ErrorCode::None);
+        EXPECT_EQ(printOption->Add(songParam.get()).code, ErrorCode::None);
+    }
+
+    TEST_F(ErrorTests, ErrorsCarryTheExceptionMessage)
+    {
+        mediaParser->Add(verboseOption.get());
+
+        EXPECT_CMD_LINE_ERROR(mediaParser->Add(verboseOption.get()), 
+            Parser::DuplicateOption, ErrorCode::DuplicateOption);
+
+#ifdef CMD_LINE_NO_EXCEPTIONS
+        EXPECT_STREQ(mediaParser->Add(verboseOption.get()).message, 
+            duplicateOptionError);
+#else
+        try
+        {
+            mediaParser->Add(verboseOption.get());
+            FAIL() << "adding a duplicate Option didn't throw";
+        }
+        catch (Parser::DuplicateOption& e)
+        {
+            EXPECT_STREQ(e.what(), duplicateOptionError);
+        }
+#endif
+    }
+
+    TEST_F(ErrorTests, InvalidParamsCantBeAdded)
+    {
+#ifndef CMD_LINE_NO_EXCEPTIONS
+        GTEST_SKIP() << "invalid Params can't be constructed with exceptions";
+#else
+        Option::Definition invalidDef;
+        Option invalid{ invalidDef };
+        ASSERT_EQ(invalid.ConstructionError().code, 
+            ErrorCode::InvalidDefinition);
+
+        Error e = mediaParser->Add(&invalid);
+        EXPECT_EQ(e.code, ErrorCode::InvalidDefinition);
+        EXPECT_STREQ(e.message, optionEmptyNameError);
+
+        MultiPosParam::Definition invalidMultiDef;
+        MultiPosParam invalidMulti{ invalidMultiDef };
+        ASSERT_EQ(invalidMulti.ConstructionError().code, 
+            ErrorCode::InvalidDefinition);
+        EXPECT_EQ(mediaParser->Set(&invalidMulti).code, 
+            ErrorCode::InvalidDefinition);
+        MultiPosParam* none{ nullptr };
+        EXPECT_EQ(mediaParser->Set(none).code, ErrorCode::None);
+#endif
+    }
+
+    TEST_F(ErrorTests, InvalidParserFailsToParse)
+    {
+#ifndef CMD_LINE_NO_EXCEPTIONS
+        GTEST_SKIP() << "invalid Parsers can't be constructed with exceptions";
+#else
+        Parser parser{ mediaProgParam.get(), {} };
+        ASSERT_EQ(parser.ConstructionError().code, ErrorCode::EmptyArguments);
+
+        EXPECT_EQ(parser.Parse(), Parser::Status::Failure);
+        EXPECT_FALSE(parser.BuiltInHelpOptionIsSpecified());
+#endif
+    }
+
+    TEST_F(ErrorTests, NamesEachCode)
+    {
+        EXPECT_STREQ(ErrorCodeName(ErrorCode::None), "None");
+        EXPECT_STREQ(ErrorCodeName(ErrorCode::InvalidDefinition), 
+            "InvalidDefinition");
+        EXPECT_STREQ(ErrorCodeName(ErrorCode::InvalidPair), "InvalidPair");
+        EXPECT_STREQ(ErrorCodeName(ErrorCode::NullParameter), 
+            "NullParameter");
+        EXPECT_STREQ(ErrorCodeName(ErrorCode::EmptyArguments), 
+            "EmptyArguments");
+        EXPECT_STREQ(ErrorCodeName(ErrorCode::DuplicateOption), 
+            "DuplicateOption");
+        EXPECT_STREQ(ErrorCodeName(ErrorCode::DuplicatePosParam), 
+            "DuplicatePosParam");
+        EXPECT_STREQ(ErrorCodeName(ErrorCode::NullOptionParam), 
+            "NullOptionParam");
+        EXPECT_STREQ(ErrorCodeName(ErrorCode::DuplicateOptionParam), 
+            "DuplicateOptionParam");
+        EXPECT_STREQ(ErrorCodeName(ErrorCode::UnreadableResponseFile), 
+            "UnreadableResponseFile");
+        EXPECT_STREQ(ErrorCodeName(ErrorCode::ArgumentsTooLong), 
+            "ArgumentsTooLong");
+        EXPECT_STREQ(ErrorCodeName(ErrorCode::UnwritableResponseFile), 
+            "UnwritableResponseFile");
+        EXPECT_STREQ(ErrorCodeName(ErrorCode::InvalidSnapshot), 
+            "InvalidSnapshot");
+        EXPECT_STREQ(ErrorCodeName(ErrorCode::UnterminatedQuote), 
+            "UnterminatedQuote");
+    }
+}
@@ -0,0 +1,69 @@
+// ErrorTests.h - Declares the Error test fixture.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_ERROR_TESTS_H
+#define CMD_LINE_ERROR_TESTS_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "ExampleArguments.h"
+#include "TestAlgorithms.h"
+#include "Error.h"
+#include "Parser.h"
+#include "Option.h"
+#include "ValueOption.h"
+#include "OptionParam.h"
+#include "NameValuePair.h"
+#include "ProgParam.h"
+
+namespace CmdLine
+{
+    /// @brief Test fixture for the Error tests.
+    ///
+    /// Checks that errors are reported the way the library was built to
+    /// report them, and that nothing is reported when there is no error.
+    /// See ErrorTests.cpp for the actual tests.
+    class ErrorTests : public ::testing::Test
+    {
+    protected:
+        /// @brief Constructs the ErrorTests fixture.
+        ///
+        /// Defines and initializes the Params of a hypothetical media 
+        /// program, along with a Parser that has none of them added.
+        ErrorTests();
+
+        std::vector<std::string> mediaArgs
+        {
+            mediaProgramName,
+            unixVerboseOptionShortName
+        };
+
+        ProgParam::Definition mediaProgramDef;
+        Option::Definition verboseDef;
+        ValueOption::Definition printDef;
+        OptionParam::Definition songDef;
+
+        std::unique_ptr<ProgParam> mediaProgParam;
+        std::unique_ptr<Option> verboseOption;
+        std::unique_ptr<ValueOption> printOption;
+        std::unique_ptr<OptionParam> songParam;
+        std::unique_ptr<Parser> mediaParser;
+    };
+}
+
+#endif
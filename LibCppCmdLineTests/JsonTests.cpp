@@ -0,0 +1,135 @@
+// JsonTests.cpp - Defines the JsonValue tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include "JsonTests.h"
+
+namespace CmdLine
+{
+    TEST_F(JsonTests, ParsesBenchmarkResults)
+    {
+        JsonValue results = JsonValue::Parse(benchmarkResults);
+        const JsonValue& context = results["context"];
+
+        EXPECT_EQ(context["date"].AsString(), "2024-05-01T10:00:00+00:00");
+        EXPECT_EQ(context["num_cpus"].AsNumber(), 8);
+        EXPECT_FALSE(context["cpu_scaling_enabled"].AsBoolean());
+        ASSERT_EQ(context["load_avg"].Items().size(), 3);
+        EXPECT_EQ(context["load_avg"].Items()[1].AsNumber(), 0.125);
+
+        const JsonValue& run = results["benchmarks"].Items()[0];
+        EXPECT_EQ(run["name"].AsString(), "BM_GenerateHelp/options:10");
+        EXPECT_EQ(run["real_time"].AsNumber(), 2.9321807999622251e+01);
+        EXPECT_EQ(run["error_message"].GetType(), JsonValue::Type::Null);
+    }
+
+    TEST_F(JsonTests, MissingMembersAreNull)
+    {
+        JsonValue results = JsonValue::Parse(benchmarkResults);
+
+        EXPECT_FALSE(results.Contains("missing"));
+        EXPECT_EQ(results["missing"].GetType(), JsonValue::Type::Null);
+    }
+
+    TEST_F(JsonTests, DecodesEscapes)
+    {
+        JsonValue value = JsonValue::Parse(
+            "\"\\\"\\\\\\/\\b\\f\\n\\r\\t \\u00e9 \\ud83d\\ude00\"");
+
+        EXPECT_EQ(value.AsString(),
+            "\"\\/\b\f\n\r\t \xc3\xa9 \xf0\x9f\x98\x80");
+    }
+
+    TEST_F(JsonTests, RejectsInvalidJson)
+    {
+        EXPECT_THROW(JsonValue::Parse(""), JsonValue::ParseError);
+        EXPECT_THROW(JsonValue::Parse("{"), JsonValue::ParseError);
+        EXPECT_THROW(JsonValue::Parse("[1,]"), JsonValue::ParseError);
+        EXPECT_THROW(JsonValue::Parse("{\"a\" 1}"), JsonValue::ParseError);
+        EXPECT_THROW(JsonValue::Parse("\"unterminated"),
+            JsonValue::ParseError);
+        EXPECT_THROW(JsonValue::Parse("\"\\x\""), JsonValue::ParseError);
+        EXPECT_THROW(JsonValue::Parse("nul"), JsonValue::ParseError);
+        EXPECT_THROW(JsonValue::Parse("1 2"), JsonValue::ParseError);
+    }
+
+    TEST_F(JsonTests, ThrowsWhenAccessedAsTheWrongType)
+    {
+        JsonValue value = JsonValue::Parse("[1]");
+
+        EXPECT_THROW(value.AsString(), JsonValue::TypeError);
+        EXPECT_THROW(value["name"], JsonValue::TypeError);
+        EXPECT_THROW(value.Items()[0].AsBoolean(), JsonValue::TypeError);
+        EXPECT_THROW(value.Set("name", 1.0), JsonValue::TypeError);
+    }
+
+    TEST_F(JsonTests, SetReplacesExistingMembersInPlace)
+    {
+        JsonValue object = JsonValue::Object();
+        object.Set("first", 1.0);
+        object.Set("second", 2.0);
+        object.Set("first", 3.0);
+
+        ASSERT_EQ(object.GetMembers().size(), 2);
+        EXPECT_EQ(object.GetMembers()[0].first, "first");
+        EXPECT_EQ(object.GetMembers()[0].second.AsNumber(), 3);
+    }
+
+    TEST_F(JsonTests, SerializedJsonParsesToTheSameValue)
+    {
+        JsonValue samples = JsonValue::Array();
+        samples.Append(580.0);
+        samples.Append(0.1);
+        samples.Append(2.9321807999622251e+01);
+
+        JsonValue object = JsonValue::Object();
+        object.Set("name", "tab\tquote\"\x01");
+        object.Set("samples", samples);
+        object.Set("flag", true);
+        object.Set("nothing", JsonValue{});
+        object.Set("empty", JsonValue::Array());
+
+        JsonValue parsed = JsonValue::Parse(object.Serialize());
+
+        EXPECT_EQ(parsed["name"].AsString(), "tab\tquote\"\x01");
+        ASSERT_EQ(parsed["samples"].Items().size(), 3);
+        for (std::size_t i = 0; i < 3; i++)
+        {
+            EXPECT_EQ(parsed["samples"].Items()[i].AsNumber(),
+                samples.Items()[i].AsNumber());
+        }
+        EXPECT_TRUE(parsed["flag"].AsBoolean());
+        EXPECT_EQ(parsed["nothing"].GetType(), JsonValue::Type::Null);
+        EXPECT_TRUE(parsed["empty"].Items().empty());
+    }
+
+    TEST_F(JsonTests, SerializesNumbersCompactly)
+    {
+        JsonValue samples = JsonValue::Array();
+        samples.Append(580.0);
+        samples.Append(0.1);
+        samples.Append(-2.5);
+
+        EXPECT_EQ(samples.Serialize(), "[580, 0.1, -2.5]\n");
+    }
+
+    TEST_F(JsonTests, EscapesStringsWhenSerialized)
+    {
+        JsonValue name{ "tab\tquote\"slash\\\x01\xc3\xa9" };
+
+        EXPECT_EQ(name.Serialize(),
+            "\"tab\\tquote\\\"slash\\\\\\u0001\xc3\xa9\"\n");
+    }
+}
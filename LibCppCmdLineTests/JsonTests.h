@@ -0,0 +1,55 @@
+// JsonTests.h - Declares the JsonTests fixture.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_JSON_TESTS_H
+#define CMD_LINE_JSON_TESTS_H
+
+#include <string>
+#include "gtest/gtest.h"
+#include "Json.h"
+
+namespace CmdLine
+{
+    /// @brief Test fixture for the JsonValue tests.
+    ///
+    /// Checks that the JSON the benchmark tools read and write is parsed and
+    /// serialized correctly. See JsonTests.cpp for the actual tests.
+    class JsonTests : public ::testing::Test
+    {
+    protected:
+        /// @brief An excerpt of a Google Benchmark --benchmark_out file.
+        const std::string benchmarkResults
+        {
+            "{\n"
+            "  \"context\": {\n"
+            "    \"date\": \"2024-05-01T10:00:00+00:00\",\n"
+            "    \"num_cpus\": 8,\n"
+            "    \"load_avg\": [0.5,1.25e-1,0],\n"
+            "    \"cpu_scaling_enabled\": false\n"
+            "  },\n"
+            "  \"benchmarks\": [\n"
+            "    {\n"
+            "      \"name\": \"BM_GenerateHelp/options:10\",\n"
+            "      \"real_time\": 2.9321807999622251e+01,\n"
+            "      \"error_message\": null\n"
+            "    }\n"
+            "  ]\n"
+            "}\n"
+        };
+    };
+}
+
+#endif
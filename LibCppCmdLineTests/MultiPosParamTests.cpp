@@ -16,6 +16,10 @@
 
 #include "MultiPosParamTests.h"
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 namespace CmdLine
 {
     MultiPosParamTests::MultiPosParamTests()
@@ -120,4 +124,65 @@ namespace CmdLine
         EXPECT_EQ(searchFilesMultiPosParam->Consumes(mixedArgs), 1);
         EXPECT_EQ(searchFilesMultiPosParam->Consumes(multiPosArgs), 2);
     }
+
+    TEST_F(MultiPosParamTests, PopulatesOperandsThatLookLikeOptions)
+    {
+        std::vector<std::string> expected{ mixedArgs.begin(), 
+            mixedArgs.end() };
+        EXPECT_FALSE(searchFilesMultiPosParam->CanPopulate(mixedArgs));
+        EXPECT_FALSE(searchFilesMultiPosParam->PopulateOperands(emptyArgs));
+
+        EXPECT_TRUE(searchFilesMultiPosParam->PopulateOperands(mixedArgs));
+        EXPECT_TRUE(searchFilesMultiPosParam->IsSpecified());
+        EXPECT_EQ(searchFilesMultiPosParam->Values(), expected);
+        EXPECT_TRUE(mixedArgs.empty());
+    }
+
+    TEST_F(MultiPosParamTests, VisitsEachValue)
+    {
+        std::deque<std::string> args{ mediaFileName1, stdinArgument, 
+            mediaFileName2 };
+        ASSERT_TRUE(searchFilesMultiPosParam->Populate(args));
+
+        // Without a StdinFormat, "-" is just another value.
+        std::vector<std::string> visited;
+        EXPECT_TRUE(searchFilesMultiPosParam->ForEachValue(
+            [&visited](std::string_view v) { visited.emplace_back(v); }));
+        EXPECT_EQ(visited, searchFilesMultiPosParam->Values());
+    }
+
+#ifndef _WIN32
+    TEST_F(MultiPosParamTests, StreamsStdinInPlaceOfDash)
+    {
+        MultiPosParam::Definition d = searchFilesDef;
+        d.stdinFormat = MultiPosParam::StdinFormat::NullTerminated;
+        MultiPosParam files{ d };
+
+        std::deque<std::string> args{ mediaFileName1, stdinArgument, 
+            stdinArgument };
+        ASSERT_TRUE(files.Populate(args));
+
+        int fds[2];
+        ASSERT_EQ(pipe(fds), 0);
+        std::string piped = std::string{ "a.mp3" } + '\0' + "b.mp3" + '\0';
+        ASSERT_EQ(write(fds[1], piped.data(), piped.size()), 
+            static_cast<ssize_t>(piped.size()));
+        close(fds[1]);
+
+        // Only the first "-" reads standard input.
+        std::vector<std::string> visited;
+        EXPECT_TRUE(files.ForEachValue(
+            [&visited](std::string_view v) { visited.emplace_back(v); }, 
+            fds[0]));
+        close(fds[0]);
+
+        std::vector<std::string> expected
+        { 
+            mediaFileName1, "a.mp3", "b.mp3", stdinArgument 
+        };
+        EXPECT_EQ(visited, expected);
+
+        EXPECT_FALSE(files.ForEachValue([](std::string_view) { }, -1));
+    }
+#endif
 }
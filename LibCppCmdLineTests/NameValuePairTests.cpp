@@ -43,9 +43,11 @@ namespace CmdLine
     {
         EXPECT_NO_THROW(NameValuePair{ albumNameValuePairArg });
         EXPECT_NO_THROW(NameValuePair{ songOptionParamName });
-        EXPECT_THROW(NameValuePair{ "" }, NameValuePair::InvalidPair);
-        EXPECT_THROW(NameValuePair{ missingNameValuePairArg }, 
-            NameValuePair::InvalidPair);
+        EXPECT_CMD_LINE_ERROR(NameValuePair{ "" }.ConstructionError(), 
+            NameValuePair::InvalidPair, ErrorCode::InvalidPair);
+        EXPECT_CMD_LINE_ERROR(
+            NameValuePair{ missingNameValuePairArg }.ConstructionError(), 
+            NameValuePair::InvalidPair, ErrorCode::InvalidPair);
         
         TestNameBundle test = GenerateTestNames(
             NameGenerationMode::NameValuePair);
@@ -54,7 +56,10 @@ namespace CmdLine
             ASSERT_NO_THROW(NameValuePair{ name });
 
         for (auto name : test.invalidNames)
-            ASSERT_THROW(NameValuePair{ name }, NameValuePair::InvalidPair);
+        {
+            ASSERT_CMD_LINE_ERROR(NameValuePair{ name }.ConstructionError(), 
+                NameValuePair::InvalidPair, ErrorCode::InvalidPair);
+        }
     }
 
     TEST_F(NameValuePairTests, ProperlyChecksNameValuePair)
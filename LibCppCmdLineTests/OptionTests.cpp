@@ -269,6 +269,19 @@ namespace CmdLine
         EXPECT_EQ(windowsVerboseOption->CanPopulate(emptyArgs), false);
     }
 
+    TEST_F(OptionTests, MatchesPrefixedNamesProperly)
+    {
+        EXPECT_EQ(unixVerboseOption->Matches(unixVerboseOptionShortName), true);
+        EXPECT_EQ(unixVerboseOption->Matches(unixVerboseOptionLongName), true);
+        EXPECT_EQ(unixVerboseOption->Matches(windowsVerboseOptionShortName), false);
+        EXPECT_EQ(unixVerboseOption->Matches(fullFilePath), false);
+        EXPECT_EQ(unixVerboseOption->Matches(""), false);
+
+        EXPECT_EQ(windowsVerboseOption->Matches(windowsVerboseOptionShortName), true);
+        EXPECT_EQ(windowsVerboseOption->Matches(windowsVerboseOptionLongName), true);
+        EXPECT_EQ(windowsVerboseOption->Matches(unixVerboseOptionLongName), false);
+    }
+
     TEST_F(OptionTests, DetectsOptionArguemntsProperly)
     {
         EXPECT_EQ(IsOption(unixPrintOptionShortName), true);
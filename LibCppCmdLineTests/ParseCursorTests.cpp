@@ -0,0 +1,146 @@
+// ParseCursorTests.cpp - Defines the ParseCursor tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#include "ParseCursorTests.h"
+
+namespace CmdLine
+{
+    ParseCursorTests::ParseCursorTests()
+    {
+        ProgParam::Definition programDef;
+        programDef.name = mediaProgramName;
+        mediaProgParam = std::make_unique<ProgParam>(programDef);
+
+        Option::Definition verboseDef;
+        verboseDef.shortName = verboseOptionShortName;
+        verboseDef.longName = verboseOptionLongName;
+        verboseOption = std::make_unique<Option>(verboseDef);
+
+        ValueOption::Definition printDef;
+        printDef.shortName = printOptionShortName;
+        printDef.longName = printOptionLongName;
+        printOption = std::make_unique<ValueOption>(printDef);
+
+        mediaParser = std::make_unique<Parser>(mediaProgParam.get(), 
+            std::vector<std::string>{ mediaProgramName });
+        mediaParser->Add(verboseOption.get());
+        mediaParser->Add(printOption.get());
+    }
+
+    TEST_F(ParseCursorTests, PullsEachItemInOrder)
+    {
+        ContainerSource source{ mediaArgs };
+        ParseCursor cursor = mediaParser->Cursor(source);
+        ParsedItem item;
+
+        ASSERT_TRUE(cursor.Next(item));
+        EXPECT_EQ(item.kind, ParsedItem::Kind::Positional);
+        EXPECT_EQ(item.option, nullptr);
+        EXPECT_EQ(item.arg, mediaFileName1);
+        EXPECT_EQ(item.argIndex, 1);
+
+        ASSERT_TRUE(cursor.Next(item));
+        EXPECT_EQ(item.kind, ParsedItem::Kind::Option);
+        EXPECT_EQ(item.option, printOption.get());
+        EXPECT_EQ(item.argIndex, 2);
+
+        ASSERT_TRUE(cursor.Next(item));
+        EXPECT_EQ(item.kind, ParsedItem::Kind::Value);
+        EXPECT_EQ(item.option, printOption.get());
+        EXPECT_EQ(item.arg, songOptionParamName);
+        EXPECT_EQ(item.argIndex, 3);
+
+        ASSERT_TRUE(cursor.Next(item));
+        EXPECT_EQ(item.kind, ParsedItem::Kind::Option);
+        EXPECT_EQ(item.option, verboseOption.get());
+        EXPECT_EQ(item.argIndex, 4);
+
+        EXPECT_FALSE(cursor.Next(item));
+        EXPECT_FALSE(cursor.Next(item));
+        EXPECT_EQ(cursor.LastError().kind, ParseError::Kind::None);
+    }
+
+    TEST_F(ParseCursorTests, SkipsOnlyTheProgramName)
+    {
+        std::vector<std::string> none;
+        ContainerSource empty{ none };
+        ParsedItem item;
+        EXPECT_FALSE(mediaParser->Cursor(empty).Next(item));
+
+        std::vector<std::string> programOnly{ mediaProgramName };
+        ContainerSource source{ programOnly };
+        EXPECT_FALSE(mediaParser->Cursor(source).Next(item));
+    }
+
+    TEST_F(ParseCursorTests, StopsAtInvalidArguments)
+    {
+        std::vector<std::string> args
+        { 
+            mediaProgramName, "--bogus", mediaFileName1 
+        };
+        ContainerSource source{ args };
+        ParseCursor cursor = mediaParser->Cursor(source);
+        ParsedItem item;
+        EXPECT_FALSE(cursor.Next(item));
+        EXPECT_EQ(cursor.LastError().kind, ParseError::Kind::UnknownOption);
+        EXPECT_EQ(cursor.LastError().argIndex, 1);
+        EXPECT_FALSE(cursor.Next(item));
+    }
+
+    TEST_F(ParseCursorTests, ShortCircuitsInvalidArguments)
+    {
+        std::vector<std::string> args
+        { 
+            mediaProgramName, "--bogus", mediaFileName1, "--help" 
+        };
+        ContainerSource source{ args };
+        ParseCursor cursor = mediaParser->Cursor(source);
+        ParsedItem item;
+        ASSERT_TRUE(cursor.Next(item));
+        EXPECT_TRUE(item.option->IsShortCircuit());
+        EXPECT_EQ(item.argIndex, 3);
+        EXPECT_FALSE(cursor.Next(item));
+        EXPECT_EQ(cursor.LastError().kind, ParseError::Kind::None);
+
+        // As with Parse(), operands can't short-circuit.
+        std::vector<std::string> operands
+        { 
+            mediaProgramName, "--bogus", endOfOptionsMarker, "--help" 
+        };
+        ContainerSource operandSource{ operands };
+        ParseCursor operandCursor = mediaParser->Cursor(operandSource);
+        EXPECT_FALSE(operandCursor.Next(item));
+        EXPECT_EQ(operandCursor.LastError().kind, 
+            ParseError::Kind::UnknownOption);
+        EXPECT_EQ(operandCursor.LastError().argIndex, 1);
+    }
+
+    TEST_F(ParseCursorTests, StopsAfterShortCircuitOptions)
+    {
+        std::vector<std::string> args
+        { 
+            mediaProgramName, "-h", mediaFileName1 
+        };
+        ContainerSource source{ args };
+        ParseCursor cursor = mediaParser->Cursor(source);
+        ParsedItem item;
+        ASSERT_TRUE(cursor.Next(item));
+        EXPECT_TRUE(item.option->IsShortCircuit());
+        EXPECT_FALSE(cursor.Next(item));
+        EXPECT_EQ(cursor.LastError().kind, ParseError::Kind::None);
+    }
+}
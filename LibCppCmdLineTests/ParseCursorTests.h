@@ -0,0 +1,63 @@
+// ParseCursorTests.h - Declares the ParseCursor tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_PARSE_CURSOR_TESTS_H
+#define CMD_LINE_PARSE_CURSOR_TESTS_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "ArgSource.h"
+#include "ExampleArguments.h"
+#include "ParseCursor.h"
+#include "Parser.h"
+#include "ProgParam.h"
+#include "ValueOption.h"
+
+namespace CmdLine
+{
+    /// @brief Test fixture for the ParseCursor and ParseGenerator tests.
+    ///
+    /// Pulls the items parsed from the arguments of a hypothetical media 
+    /// program. See ParseCursorTests.cpp and ParseGeneratorTests.cpp for 
+    /// the actual tests.
+    class ParseCursorTests : public ::testing::Test
+    {
+    protected:
+        /// @brief Constructs the ParseCursorTests fixture.
+        ///
+        /// Creates a Parser with the verbose Option and print ValueOption.
+        ParseCursorTests();
+
+        std::vector<std::string> mediaArgs
+        {
+            mediaProgramName,
+            mediaFileName1,
+            unixPrintOptionShortName,
+            songOptionParamName,
+            unixVerboseOptionLongName
+        };
+
+        std::unique_ptr<ProgParam> mediaProgParam;
+        std::unique_ptr<Option> verboseOption;
+        std::unique_ptr<ValueOption> printOption;
+        std::unique_ptr<Parser> mediaParser;
+    };
+}
+
+#endif
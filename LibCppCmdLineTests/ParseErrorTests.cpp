@@ -0,0 +1,186 @@
+// ParseErrorTests.cpp - Defines the ParseError tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include "ParseErrorTests.h"
+
+namespace CmdLine
+{
+    /// @brief A PosParam that can populate from any argument or operand but
+    /// never does.
+    class RefusingPosParam : public PosParam
+    {
+    public:
+        using PosParam::PosParam;
+
+        bool Populate(std::deque<std::string>&) override
+        {
+            return false;
+        }
+
+        bool PopulateOperand(std::deque<std::string>&) override
+        {
+            return false;
+        }
+    };
+
+    ParseErrorTests::ParseErrorTests()
+    {
+        copyProgramDef.name = copyProgramName;
+        copyProgramDef.description = copyProgramDescription;
+
+        verboseDef.shortName = verboseOptionShortName;
+        verboseDef.longName = verboseOptionLongName;
+        verboseDef.description = verboseOptionDescription;
+
+        printDef.shortName = printOptionShortName;
+        printDef.longName = printOptionLongName;
+        printDef.description = printOptionDescription;
+
+        destinationDef.name = copyDestinationPosName;
+        destinationDef.description = copyDestinationPosDescription;
+        destinationDef.isMandatory = true;
+
+        sourceDef.name = copySourceMultiPosName;
+        sourceDef.description = copySourceMultiPosDescription;
+        sourceDef.order = MultiPosParam::ParsingOrder::AfterOptions;
+
+        copyProgParam = std::make_unique<ProgParam>(copyProgramDef);
+        verboseOption = std::make_unique<Option>(verboseDef);
+        printOption = std::make_unique<ValueOption>(printDef);
+        destinationPos = std::make_unique<PosParam>(destinationDef);
+        sourceMultiPos = std::make_unique<MultiPosParam>(sourceDef);
+    }
+
+    std::unique_ptr<Parser> ParseErrorTests::CreateParser(
+        std::vector<std::string> args)
+    {
+        auto parser = std::make_unique<Parser>(copyProgParam.get(), args);
+        parser->Add(verboseOption.get());
+        parser->Add(printOption.get());
+        parser->Add(destinationPos.get());
+        return parser;
+    }
+
+    TEST_F(ParseErrorTests, IsNoneWithoutAFailure)
+    {
+        auto parser = CreateParser({ copyProgramName, 
+            unixVerboseOptionShortName, copyDestinationFileName });
+        EXPECT_EQ(parser->LastError().kind, ParseError::Kind::None);
+
+        ASSERT_EQ(parser->Parse(), Parser::Status::Success);
+        EXPECT_EQ(parser->LastError().kind, ParseError::Kind::None);
+        EXPECT_EQ(parser->LastError().expected, nullptr);
+    }
+
+    TEST_F(ParseErrorTests, ReportsAnUnknownOption)
+    {
+        auto parser = CreateParser({ copyProgramName, 
+            unixVerboseOptionShortName, "-z", copyDestinationFileName });
+
+        ASSERT_EQ(parser->Parse(), Parser::Status::Failure);
+        EXPECT_EQ(parser->LastError().kind, ParseError::Kind::UnknownOption);
+        EXPECT_EQ(parser->LastError().argIndex, 2);
+        EXPECT_EQ(parser->LastError().expected, nullptr);
+    }
+
+    TEST_F(ParseErrorTests, ReportsAMissingOptionValue)
+    {
+        auto parser = CreateParser({ copyProgramName, 
+            copyDestinationFileName, unixPrintOptionShortName });
+
+        ASSERT_EQ(parser->Parse(), Parser::Status::Failure);
+        EXPECT_EQ(parser->LastError().kind, 
+            ParseError::Kind::MissingOptionValue);
+        EXPECT_EQ(parser->LastError().argIndex, 2);
+        EXPECT_EQ(parser->LastError().expected, printOption.get());
+    }
+
+    TEST_F(ParseErrorTests, ReportsAnUnexpectedArgumentWhereItWasGiven)
+    {
+        // The verbose option is parsed before either positional argument,
+        // but the error still refers to the extra argument's position on
+        // the command line.
+        auto parser = CreateParser({ copyProgramName, 
+            copyDestinationFileName, copySourceFileName1, 
+            unixVerboseOptionShortName });
+
+        ASSERT_EQ(parser->Parse(), Parser::Status::Failure);
+        EXPECT_EQ(parser->LastError().kind, 
+            ParseError::Kind::UnexpectedArgument);
+        EXPECT_EQ(parser->LastError().argIndex, 2);
+        EXPECT_EQ(parser->LastError().expected, nullptr);
+    }
+
+    TEST_F(ParseErrorTests, ReportsAFailedPopulateAfterReordering)
+    {
+        // With the AfterOptions order the destination is parsed before the
+        // sources that precede it on the command line.
+        RefusingPosParam refusing{ destinationDef };
+        Parser parser{ copyProgParam.get(), { copyProgramName, 
+            copySourceFileName1, unixVerboseOptionShortName, 
+            copySourceFileName2, copyDestinationFileName } };
+        parser.Add(verboseOption.get());
+        parser.Add(&refusing);
+        parser.Set(sourceMultiPos.get());
+
+        ASSERT_EQ(parser.Parse(), Parser::Status::Failure);
+        EXPECT_EQ(parser.LastError().kind, ParseError::Kind::PopulateFailed);
+        EXPECT_EQ(parser.LastError().argIndex, 4);
+        EXPECT_EQ(parser.LastError().expected, &refusing);
+    }
+
+    TEST_F(ParseErrorTests, ReportsAFailedPopulateFromAnOperand)
+    {
+        RefusingPosParam refusing{ destinationDef };
+        Parser parser{ copyProgParam.get(), { copyProgramName, 
+            unixVerboseOptionShortName, endOfOptionsMarker, 
+            copyDestinationFileName } };
+        parser.Add(verboseOption.get());
+        parser.Add(&refusing);
+
+        ASSERT_EQ(parser.Parse(), Parser::Status::Failure);
+        EXPECT_EQ(parser.LastError().kind, ParseError::Kind::PopulateFailed);
+        EXPECT_EQ(parser.LastError().argIndex, 3);
+        EXPECT_EQ(parser.LastError().expected, &refusing);
+    }
+
+    TEST_F(ParseErrorTests, IsResetByTheNextParse)
+    {
+        auto parser = CreateParser({ copyProgramName, "-z" });
+        ASSERT_EQ(parser->Parse(), Parser::Status::Failure);
+        ASSERT_EQ(parser->LastError().kind, ParseError::Kind::UnknownOption);
+
+        // The same failure is found again rather than the old one lingering.
+        ASSERT_EQ(parser->Parse(), Parser::Status::Failure);
+        EXPECT_EQ(parser->LastError().kind, ParseError::Kind::UnknownOption);
+        EXPECT_EQ(parser->LastError().argIndex, 1);
+    }
+
+    TEST_F(ParseErrorTests, NamesEachKind)
+    {
+        EXPECT_STREQ(ParseErrorKindName(ParseError::Kind::None), "None");
+        EXPECT_STREQ(ParseErrorKindName(ParseError::Kind::UnknownOption), 
+            "UnknownOption");
+        EXPECT_STREQ(ParseErrorKindName(
+            ParseError::Kind::MissingOptionValue), "MissingOptionValue");
+        EXPECT_STREQ(ParseErrorKindName(
+            ParseError::Kind::UnexpectedArgument), "UnexpectedArgument");
+        EXPECT_STREQ(ParseErrorKindName(ParseError::Kind::PopulateFailed), 
+            "PopulateFailed");
+        EXPECT_STREQ(ParseErrorKindName(ParseError::Kind::NoProgress), 
+            "NoProgress");
+    }
+}
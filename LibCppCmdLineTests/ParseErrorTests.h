@@ -0,0 +1,71 @@
+// ParseErrorTests.h - Declares the ParseError test fixture.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_PARSE_ERROR_TESTS_H
+#define CMD_LINE_PARSE_ERROR_TESTS_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "ExampleArguments.h"
+#include "Parser.h"
+#include "ParseError.h"
+#include "MultiPosParam.h"
+#include "Option.h"
+#include "ValueOption.h"
+#include "PosParam.h"
+#include "ProgParam.h"
+
+namespace CmdLine
+{
+    /// @brief Test fixture for the ParseError tests.
+    ///
+    /// Checks the error a Parser reports for each kind of failure, in 
+    /// particular that the argument index refers to the command line 
+    /// rather than the order arguments are parsed in. See 
+    /// ParseErrorTests.cpp for the actual tests.
+    class ParseErrorTests : public ::testing::Test
+    {
+    protected:
+        /// @brief Constructs the ParseErrorTests fixture.
+        ///
+        /// Defines and initializes the Params of a hypothetical copy 
+        /// program.
+        ParseErrorTests();
+
+        /// @brief Creates a Parser for the copy program.
+        ///
+        /// @param args The command line arguments to parse.
+        /// @return The Parser, with the verbose and print options and the
+        /// destination PosParam added.
+        std::unique_ptr<Parser> CreateParser(std::vector<std::string> args);
+
+        ProgParam::Definition copyProgramDef;
+        Option::Definition verboseDef;
+        ValueOption::Definition printDef;
+        PosParam::Definition destinationDef;
+        MultiPosParam::Definition sourceDef;
+
+        std::unique_ptr<ProgParam> copyProgParam;
+        std::unique_ptr<Option> verboseOption;
+        std::unique_ptr<ValueOption> printOption;
+        std::unique_ptr<PosParam> destinationPos;
+        std::unique_ptr<MultiPosParam> sourceMultiPos;
+    };
+}
+
+#endif
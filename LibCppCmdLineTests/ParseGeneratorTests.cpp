@@ -0,0 +1,75 @@
+// ParseGeneratorTests.cpp - Defines the ParseGenerator tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#include "ParseCursorTests.h"
+#include "ParseGenerator.h"
+
+namespace CmdLine
+{
+    TEST_F(ParseCursorTests, GeneratesEachItemLazily)
+    {
+#ifndef CMD_LINE_PARSE_GENERATOR
+        GTEST_SKIP() << "coroutines aren't supported by this build";
+#else
+        ContainerSource source{ mediaArgs };
+        ParseGenerator items = ParseItems(*mediaParser, source);
+
+        // Nothing is parsed until the sequence is advanced.
+        EXPECT_EQ(source.RemainingHint(), mediaArgs.size());
+
+        std::vector<ParsedItem::Kind> kinds;
+        std::vector<std::size_t> argIndexes;
+        for (const ParsedItem& item : items)
+        {
+            kinds.push_back(item.kind);
+            argIndexes.push_back(item.argIndex);
+        }
+
+        std::vector<ParsedItem::Kind> expectedKinds
+        {
+            ParsedItem::Kind::Positional, ParsedItem::Kind::Option, 
+            ParsedItem::Kind::Value, ParsedItem::Kind::Option
+        };
+        EXPECT_EQ(kinds, expectedKinds);
+        EXPECT_EQ(argIndexes, (std::vector<std::size_t>{ 1, 2, 3, 4 }));
+        EXPECT_EQ(items.LastError().kind, ParseError::Kind::None);
+#endif
+    }
+
+    TEST_F(ParseCursorTests, GeneratorsReportInvalidArguments)
+    {
+#ifndef CMD_LINE_PARSE_GENERATOR
+        GTEST_SKIP() << "coroutines aren't supported by this build";
+#else
+        std::vector<std::string> args
+        { 
+            mediaProgramName, mediaFileName1, unixPrintOptionShortName 
+        };
+        ContainerSource source{ args };
+        ParseGenerator items = ParseItems(*mediaParser, source);
+
+        std::size_t count = 0;
+        for (auto i = items.begin(); i != items.end(); i++)
+            count++;
+
+        EXPECT_EQ(count, 2);
+        EXPECT_EQ(items.LastError().kind, 
+            ParseError::Kind::MissingOptionValue);
+        EXPECT_EQ(items.LastError().expected, printOption.get());
+#endif
+    }
+}
@@ -0,0 +1,211 @@
+// ParseHandlerTests.cpp - Defines the ParseHandler tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#include "ParseHandlerTests.h"
+
+#include <charconv>
+
+namespace CmdLine
+{
+    namespace
+    {
+        // Generates "file0", "file1", ... without storing or allocating 
+        // them, as a pipe of paths would.
+        class GeneratedSource : public ArgSource
+        {
+        public:
+            GeneratedSource(std::size_t count) : mCount{ count }, mNext{ 0 }
+            { }
+
+            bool Next(std::string_view& arg) override
+            {
+                if (mNext == mCount)
+                    return false;
+
+                char* end = std::to_chars(mBuffer + 4, 
+                    mBuffer + sizeof(mBuffer), mNext++).ptr;
+                arg = std::string_view{ mBuffer, 
+                    static_cast<std::size_t>(end - mBuffer) };
+                return true;
+            }
+        private:
+            std::size_t mCount;
+            std::size_t mNext;
+            char mBuffer[32]{ 'f', 'i', 'l', 'e' };
+        };
+
+        // Counts positional arguments without keeping them.
+        class CountingHandler : public ParseHandler
+        {
+        public:
+            bool PositionalSeen(std::string_view, std::size_t) override
+            {
+                count++;
+                return true;
+            }
+
+            std::size_t count{ 0 };
+        };
+    }
+
+    bool RecordingHandler::OptionSeen(const Option& o, std::size_t argIndex)
+    {
+        return Record("option " + o.Name() + " " + std::to_string(argIndex));
+    }
+
+    bool RecordingHandler::ValueSeen(const Option& o, std::string_view value,
+        std::size_t argIndex)
+    {
+        return Record("value " + o.Name() + " " + std::string{ value } + " " +
+            std::to_string(argIndex));
+    }
+
+    bool RecordingHandler::PositionalSeen(std::string_view arg, 
+        std::size_t argIndex)
+    {
+        return Record("positional " + std::string{ arg } + " " + 
+            std::to_string(argIndex));
+    }
+
+    bool RecordingHandler::Record(std::string event)
+    {
+        events.push_back(std::move(event));
+        return events.size() < mStopAfter;
+    }
+
+    ParseHandlerTests::ParseHandlerTests()
+    {
+        ProgParam::Definition programDef;
+        programDef.name = mediaProgramName;
+        mediaProgParam = std::make_unique<ProgParam>(programDef);
+
+        Option::Definition verboseDef;
+        verboseDef.shortName = verboseOptionShortName;
+        verboseDef.longName = verboseOptionLongName;
+        verboseOption = std::make_unique<Option>(verboseDef);
+
+        ValueOption::Definition printDef;
+        printDef.shortName = printOptionShortName;
+        printDef.longName = printOptionLongName;
+        printOption = std::make_unique<ValueOption>(printDef);
+
+        mediaParser = std::make_unique<Parser>(mediaProgParam.get(), 
+            std::vector<std::string>{ mediaProgramName });
+        mediaParser->Add(verboseOption.get());
+        mediaParser->Add(printOption.get());
+    }
+
+    Parser::Status ParseHandlerTests::Stream(
+        const std::vector<std::string>& args, ParseHandler& handler)
+    {
+        ContainerSource source{ args };
+        return mediaParser->Parse(source, handler);
+    }
+
+    TEST_F(ParseHandlerTests, ReportsEachArgumentInOrder)
+    {
+        RecordingHandler handler;
+        ASSERT_EQ(Stream({ mediaProgramName, mediaFileName1, 
+            unixPrintOptionShortName, songOptionParamName, 
+            unixVerboseOptionLongName }, handler), Parser::Status::Success);
+
+        std::string print = printOption->Name();
+        std::vector<std::string> expected
+        {
+            "positional " + std::string{ mediaFileName1 } + " 1",
+            "option " + print + " 2",
+            "value " + print + " " + songOptionParamName + " 3",
+            "option " + verboseOption->Name() + " 4"
+        };
+        EXPECT_EQ(handler.events, expected);
+    }
+
+    TEST_F(ParseHandlerTests, StoresNothing)
+    {
+        RecordingHandler handler;
+        ASSERT_EQ(Stream({ mediaProgramName, unixVerboseOptionShortName, 
+            unixPrintOptionShortName, songOptionParamName }, handler), 
+            Parser::Status::Success);
+
+        EXPECT_EQ(handler.events.size(), 3);
+        EXPECT_FALSE(verboseOption->IsSpecified());
+        EXPECT_FALSE(printOption->IsSpecified());
+        EXPECT_TRUE(printOption->Values().empty());
+    }
+
+    TEST_F(ParseHandlerTests, OperandsArePositional)
+    {
+        RecordingHandler handler;
+        ASSERT_EQ(Stream({ mediaProgramName, endOfOptionsMarker, 
+            unixVerboseOptionShortName }, handler), Parser::Status::Success);
+
+        std::vector<std::string> expected
+        {
+            "positional " + std::string{ unixVerboseOptionShortName } + " 2"
+        };
+        EXPECT_EQ(handler.events, expected);
+    }
+
+    TEST_F(ParseHandlerTests, HandlersCanStopParsing)
+    {
+        RecordingHandler handler{ 1 };
+        ASSERT_EQ(Stream({ mediaProgramName, mediaFileName1, mediaFileName2 },
+            handler), Parser::Status::Success);
+        EXPECT_EQ(handler.events.size(), 1);
+    }
+
+    TEST_F(ParseHandlerTests, StopsAfterShortCircuitOptions)
+    {
+        RecordingHandler handler;
+        ASSERT_EQ(Stream({ mediaProgramName, "--help", "--bogus" }, handler),
+            Parser::Status::Success);
+        EXPECT_EQ(handler.events.size(), 1);
+    }
+
+    TEST_F(ParseHandlerTests, ReportsInvalidArguments)
+    {
+        RecordingHandler handler;
+        EXPECT_EQ(Stream({ mediaProgramName, mediaFileName1, "--bogus" }, 
+            handler), Parser::Status::Failure);
+        EXPECT_EQ(mediaParser->LastError().kind, 
+            ParseError::Kind::UnknownOption);
+        EXPECT_EQ(mediaParser->LastError().argIndex, 2);
+
+        EXPECT_EQ(Stream({ mediaProgramName, unixPrintOptionShortName }, 
+            handler), Parser::Status::Failure);
+        EXPECT_EQ(mediaParser->LastError().kind, 
+            ParseError::Kind::MissingOptionValue);
+        EXPECT_EQ(mediaParser->LastError().argIndex, 1);
+        EXPECT_EQ(mediaParser->LastError().expected, printOption.get());
+    }
+
+    TEST_F(ParseHandlerTests, StreamsInConstantMemory)
+    {
+        if (!AllocationTrackingEnabled())
+            GTEST_SKIP() << "allocation tracking is not compiled in";
+
+        GeneratedSource source{ 100000 };
+        CountingHandler handler;
+
+        AllocationScope scope;
+        Parser::Status status = mediaParser->Parse(source, handler);
+        EXPECT_EQ(scope.Stats().allocations, 0);
+
+        ASSERT_EQ(status, Parser::Status::Success);
+        EXPECT_EQ(handler.count, 99999);
+    }
+}
@@ -0,0 +1,96 @@
+// ParseHandlerTests.h - Declares the ParseHandler tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_PARSE_HANDLER_TESTS_H
+#define CMD_LINE_PARSE_HANDLER_TESTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "gtest/gtest.h"
+#include "AllocationTracker.h"
+#include "ArgSource.h"
+#include "ExampleArguments.h"
+#include "ParseHandler.h"
+#include "Parser.h"
+#include "ProgParam.h"
+#include "ValueOption.h"
+
+namespace CmdLine
+{
+    /// @brief A ParseHandler that records each event as text.
+    class RecordingHandler : public ParseHandler
+    {
+    public:
+        /// @brief Constructs a new RecordingHandler.
+        ///
+        /// @param stopAfter How many events to record before stopping
+        /// parsing.
+        RecordingHandler(std::size_t stopAfter = SIZE_MAX)
+            : mStopAfter{ stopAfter }
+        { }
+
+        bool OptionSeen(const Option& o, std::size_t argIndex) override;
+
+        bool ValueSeen(const Option& o, std::string_view value, 
+            std::size_t argIndex) override;
+
+        bool PositionalSeen(std::string_view arg, std::size_t argIndex) 
+            override;
+
+        std::vector<std::string> events;
+    private:
+        std::size_t mStopAfter;
+
+        /// @brief Records an event.
+        ///
+        /// @param event The event.
+        /// @return True until stopAfter events have been recorded.
+        bool Record(std::string event);
+    };
+
+    /// @brief Test fixture for the ParseHandler tests.
+    ///
+    /// Streams the arguments of a hypothetical media program through a
+    /// RecordingHandler. See ParseHandlerTests.cpp for the actual tests.
+    class ParseHandlerTests : public ::testing::Test
+    {
+    protected:
+        /// @brief Constructs the ParseHandlerTests fixture.
+        ///
+        /// Creates a Parser with the verbose Option and print ValueOption.
+        ParseHandlerTests();
+
+        /// @brief Streams arguments through the parser.
+        ///
+        /// @param args The arguments, including the program name.
+        /// @param handler The handler to call.
+        /// @return The result of the parse.
+        Parser::Status Stream(const std::vector<std::string>& args, 
+            ParseHandler& handler);
+
+        std::unique_ptr<ProgParam> mediaProgParam;
+        std::unique_ptr<Option> verboseOption;
+        std::unique_ptr<ValueOption> printOption;
+        std::unique_ptr<Parser> mediaParser;
+    };
+}
+
+#endif
@@ -0,0 +1,213 @@
+// ParseProfilerTests.cpp - Defines the ParseObserver and ParseProfiler tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include "ParseProfilerTests.h"
+
+namespace CmdLine
+{
+    void RecordingObserver::PhaseStarted(ParsePhase p)
+    {
+        notifications.push_back(std::string{ "started " } + 
+            ParsePhaseName(p));
+    }
+
+    void RecordingObserver::PhaseFinished(ParsePhase p)
+    {
+        notifications.push_back(std::string{ "finished " } + 
+            ParsePhaseName(p));
+    }
+
+    void RecordingObserver::PopulateStarted(const ArgParam& p)
+    {
+        notifications.push_back("populating " + p.Name());
+    }
+
+    void RecordingObserver::PopulateFinished(const ArgParam& p, 
+        bool populated)
+    {
+        notifications.push_back((populated ? "populated " : "failed ") +
+            p.Name());
+    }
+
+    ParseProfilerTests::ParseProfilerTests()
+    {
+        copyProgramDef.name = copyProgramName;
+        copyProgramDef.description = copyProgramDescription;
+
+        verboseDef.shortName = verboseOptionShortName;
+        verboseDef.longName = verboseOptionLongName;
+        verboseDef.description = verboseOptionDescription;
+
+        destinationDef.name = copyDestinationPosName;
+        destinationDef.description = copyDestinationPosDescription;
+        destinationDef.isMandatory = true;
+
+        sourceDef.name = copySourceMultiPosName;
+        sourceDef.description = copySourceMultiPosDescription;
+        sourceDef.isMandatory = true;
+        sourceDef.order = MultiPosParam::ParsingOrder::AfterOptions;
+
+        copyProgParam = std::make_unique<ProgParam>(copyProgramDef);
+        verboseOption = std::make_unique<Option>(verboseDef);
+        destinationPos = std::make_unique<PosParam>(destinationDef);
+        sourceMultiPos = std::make_unique<MultiPosParam>(sourceDef);
+
+        copyParser = std::make_unique<Parser>(copyProgParam.get(), copyArgs);
+        copyParser->Add(verboseOption.get());
+        copyParser->Add(destinationPos.get());
+        copyParser->Set(sourceMultiPos.get());
+    }
+
+    void ParseProfilerTests::SetUp()
+    {
+#ifdef CMD_LINE_NO_PARSE_OBSERVERS
+        GTEST_SKIP() << "parse observers are compiled out";
+#endif
+    }
+
+    TEST_F(ParseProfilerTests, NotifiesObserverOfEachPhaseAndPopulate)
+    {
+        RecordingObserver observer;
+        copyParser->Set(&observer);
+
+        ASSERT_EQ(copyParser->Parse(), Parser::Status::Success);
+
+        std::vector<std::string> expected
+        {
+            "started FillArgQueue",
+            "finished FillArgQueue",
+            "started FillArgParamVector",
+            "finished FillArgParamVector",
+            "started PopulateArgParams",
+            "populating " + copyProgParam->Name(),
+            "populated " + copyProgParam->Name(),
+            "populating " + verboseOption->Name(),
+            "populated " + verboseOption->Name(),
+            "populating " + destinationPos->Name(),
+            "populated " + destinationPos->Name(),
+            "populating " + sourceMultiPos->Name(),
+            "populated " + sourceMultiPos->Name(),
+            "finished PopulateArgParams"
+        };
+        EXPECT_EQ(observer.notifications, expected);
+    }
+
+    TEST_F(ParseProfilerTests, NotifiesObserverWhenAPhaseFails)
+    {
+        RecordingObserver observer;
+        Parser parser{ copyProgParam.get(), 
+            { copyProgramName, unixPrintOptionShortName } };
+        parser.Set(&observer);
+
+        ASSERT_EQ(parser.Parse(), Parser::Status::Failure);
+
+        std::vector<std::string> expected
+        {
+            "started FillArgQueue",
+            "finished FillArgQueue"
+        };
+        EXPECT_EQ(observer.notifications, expected);
+    }
+
+    TEST_F(ParseProfilerTests, ParsesTheSameWithoutAnObserver)
+    {
+        RecordingObserver observer;
+        copyParser->Set(&observer);
+        copyParser->Set(static_cast<ParseObserver*>(nullptr));
+
+        EXPECT_EQ(copyParser->Parse(), Parser::Status::Success);
+        EXPECT_TRUE(observer.notifications.empty());
+        EXPECT_TRUE(verboseOption->IsSpecified());
+        EXPECT_EQ(sourceMultiPos->Values().size(), 2);
+    }
+
+    TEST_F(ParseProfilerTests, CountsPopulatesOfEachParam)
+    {
+        ParseProfiler profiler;
+        copyParser->Set(&profiler);
+
+        ASSERT_EQ(copyParser->Parse(), Parser::Status::Success);
+
+        // The MultiPosParam is populated once with every source file.
+        const auto& params = profiler.Params();
+        ASSERT_EQ(params.size(), 4);
+        EXPECT_EQ(params[0].name, copyProgParam->Name());
+        EXPECT_EQ(params[1].name, verboseOption->Name());
+        EXPECT_EQ(params[2].name, destinationPos->Name());
+        EXPECT_EQ(params[3].name, sourceMultiPos->Name());
+        for (const auto& p : params)
+            EXPECT_EQ(p.populateCount, 1) << p.name;
+    }
+
+    TEST_F(ParseProfilerTests, RecordsTimeSpentInEachPhase)
+    {
+        ParseProfiler profiler;
+        copyParser->Set(&profiler);
+
+        ASSERT_EQ(copyParser->Parse(), Parser::Status::Success);
+
+        std::chrono::nanoseconds populateTime{ 0 };
+        for (const auto& p : profiler.Params())
+            populateTime += p.populateTime;
+
+        EXPECT_GT(profiler.PhaseDuration(ParsePhase::FillArgQueue).count(), 
+            0);
+        EXPECT_GE(profiler.PhaseDuration(ParsePhase::PopulateArgParams),
+            populateTime);
+    }
+
+    TEST_F(ParseProfilerTests, ExportsChromeTraceEvents)
+    {
+        ParseProfiler profiler;
+        copyParser->Set(&profiler);
+
+        ASSERT_EQ(copyParser->Parse(), Parser::Status::Success);
+        std::string trace = profiler.ToChromeTrace();
+
+        EXPECT_EQ(trace.find("{\"traceEvents\":["), 0);
+        EXPECT_NE(trace.find("\"name\":\"FillArgQueue\",\"cat\":\"phase\""),
+            std::string::npos);
+        EXPECT_NE(trace.find("\"name\":\"PopulateArgParams\""), 
+            std::string::npos);
+        EXPECT_NE(trace.find("\"name\":\"" + verboseOption->Name() + 
+            "\",\"cat\":\"populate\",\"ph\":\"X\""), std::string::npos);
+        EXPECT_NE(trace.find("\"args\":{\"populated\":true}"), 
+            std::string::npos);
+
+        // One event per phase and one per populate call.
+        std::size_t events = 0;
+        for (std::size_t i = trace.find("\"ph\":\"X\""); 
+            i != std::string::npos; i = trace.find("\"ph\":\"X\"", i + 1))
+        {
+            events++;
+        }
+        EXPECT_EQ(events, parsePhaseCount + 4);
+    }
+
+    TEST_F(ParseProfilerTests, ResetDiscardsRecordedResults)
+    {
+        ParseProfiler profiler;
+        copyParser->Set(&profiler);
+        ASSERT_EQ(copyParser->Parse(), Parser::Status::Success);
+
+        profiler.Reset();
+
+        EXPECT_TRUE(profiler.Params().empty());
+        EXPECT_EQ(profiler.PhaseDuration(ParsePhase::FillArgQueue).count(), 
+            0);
+        EXPECT_EQ(profiler.ToChromeTrace().find("\"ph\""), std::string::npos);
+    }
+}
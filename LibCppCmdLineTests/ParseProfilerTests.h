@@ -0,0 +1,92 @@
+// ParseProfilerTests.h - Declares the ParseProfilerTests fixture.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_PARSE_PROFILER_TESTS_H
+#define CMD_LINE_PARSE_PROFILER_TESTS_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "ExampleArguments.h"
+#include "Parser.h"
+#include "ParseObserver.h"
+#include "ParseProfiler.h"
+#include "Option.h"
+#include "PosParam.h"
+#include "MultiPosParam.h"
+#include "ProgParam.h"
+
+namespace CmdLine
+{
+    /// @brief A ParseObserver that records each notification it receives.
+    class RecordingObserver : public ParseObserver
+    {
+    public:
+        void PhaseStarted(ParsePhase p) override;
+
+        void PhaseFinished(ParsePhase p) override;
+
+        void PopulateStarted(const ArgParam& p) override;
+
+        void PopulateFinished(const ArgParam& p, bool populated) override;
+
+        /// @brief Each notification received, in order, e.g. 
+        /// "started FillArgQueue" or "populated -v".
+        std::vector<std::string> notifications;
+    };
+
+    /// @brief Test fixture for the ParseObserver and ParseProfiler tests.
+    ///
+    /// Checks that a Parser notifies its ParseObserver of each phase and
+    /// populate call, and that a ParseProfiler records and exports them.
+    /// Every test is skipped when the library is built without observers.
+    /// See ParseProfilerTests.cpp for the actual tests.
+    class ParseProfilerTests : public ::testing::Test
+    {
+    protected:
+        /// @brief Constructs the ParseProfilerTests fixture.
+        ///
+        /// Defines and initializes the Params of a hypothetical copy
+        /// program, along with a Parser that has all of them added.
+        ParseProfilerTests();
+
+        /// @brief Skips the test if observers are compiled out.
+        void SetUp() override;
+
+        std::vector<std::string> copyArgs
+        {
+            copyProgramName,
+            unixVerboseOptionShortName,
+            copySourceFileName1,
+            copySourceFileName2,
+            copyDestinationFileName
+        };
+
+        ProgParam::Definition copyProgramDef;
+        Option::Definition verboseDef;
+        PosParam::Definition destinationDef;
+        MultiPosParam::Definition sourceDef;
+
+        std::unique_ptr<ProgParam> copyProgParam;
+        std::unique_ptr<Option> verboseOption;
+        std::unique_ptr<PosParam> destinationPos;
+        std::unique_ptr<MultiPosParam> sourceMultiPos;
+        std::unique_ptr<Parser> copyParser;
+    };
+}
+
+#endif
@@ -0,0 +1,178 @@
+// ParseSnapshotTests.cpp - Defines the ParseSnapshot tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#include "ParseSnapshotTests.h"
+
+#include <cstring>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace CmdLine
+{
+    ParseSnapshotTests::ParseSnapshotTests()
+    {
+        ProgParam::Definition programDef;
+        programDef.name = mediaProgramName;
+        mediaProgParam = std::make_unique<ProgParam>(programDef);
+
+        Option::Definition verboseDef;
+        verboseDef.shortName = verboseOptionShortName;
+        verboseDef.longName = verboseOptionLongName;
+        verboseOption = std::make_unique<Option>(verboseDef);
+
+        ValueOption::Definition printDef;
+        printDef.shortName = printOptionShortName;
+        printDef.longName = printOptionLongName;
+        printOption = std::make_unique<ValueOption>(printDef);
+
+        MultiPosParam::Definition filesDef;
+        filesDef.name = mediaFilesMultiPosName;
+        filesDef.isLazy = true;
+        mediaFiles = std::make_unique<MultiPosParam>(filesDef);
+
+        mediaParser = std::make_unique<Parser>(mediaProgParam.get(), 
+            std::vector<std::string>{ mediaProgramName, 
+                unixPrintOptionShortName, songOptionParamName, 
+                unixPrintOptionLongName, artistOptionParamName,
+                mediaFileName1, mediaFileName2 });
+        mediaParser->Add(verboseOption.get());
+        mediaParser->Add(printOption.get());
+        mediaParser->Set(mediaFiles.get());
+    }
+
+    TEST_F(ParseSnapshotTests, RecordsWhatWasParsed)
+    {
+        ASSERT_EQ(mediaParser->Parse(), Parser::Status::Success);
+        std::vector<char> data = mediaParser->Snapshot();
+
+        ParseSnapshot snapshot{ data.data(), data.size() };
+        ASSERT_EQ(snapshot.ConstructionError().code, ErrorCode::None);
+
+        // The ProgParam, the built-in help Option, the two Options added 
+        // and the MultiPosParam.
+        ASSERT_EQ(snapshot.ParamCount(), 5);
+        EXPECT_EQ(snapshot.Name(0), mediaProgramName);
+        EXPECT_EQ(snapshot.Value(0), mediaProgramName);
+
+        std::size_t verbose = snapshot.Find(verboseOption->Name());
+        ASSERT_LT(verbose, snapshot.ParamCount());
+        EXPECT_FALSE(snapshot.IsSpecified(verbose));
+        EXPECT_EQ(snapshot.ValueCount(verbose), 0);
+
+        std::size_t print = snapshot.Find(printOption->Name());
+        ASSERT_LT(print, snapshot.ParamCount());
+        EXPECT_TRUE(snapshot.IsSpecified(printOption->Name()));
+        ASSERT_EQ(snapshot.ValueCount(print), 2);
+        EXPECT_EQ(snapshot.Value(print, 0), songOptionParamName);
+        EXPECT_EQ(snapshot.Value(print, 1), artistOptionParamName);
+
+        std::size_t files = snapshot.Find(mediaFilesMultiPosName);
+        ASSERT_LT(files, snapshot.ParamCount());
+        EXPECT_TRUE(snapshot.IsSpecified(files));
+        ASSERT_EQ(snapshot.ValueCount(files), 2);
+        EXPECT_EQ(snapshot.Value(files, 1), mediaFileName2);
+
+        EXPECT_EQ(snapshot.Find("missing"), snapshot.ParamCount());
+        EXPECT_FALSE(snapshot.IsSpecified("missing"));
+    }
+
+    TEST_F(ParseSnapshotTests, IsRelocatable)
+    {
+        ASSERT_EQ(mediaParser->Parse(), Parser::Status::Success);
+        std::vector<char> data = mediaParser->Snapshot();
+
+        // Attaching to a copy at an odd address, after the Parser and its
+        // Params are gone, refers only to the copy.
+        std::vector<char> moved{ 'x' };
+        moved.insert(moved.end(), data.begin(), data.end());
+        data.assign(data.size(), 0);
+        mediaParser.reset();
+        mediaFiles.reset();
+
+        ParseSnapshot snapshot{ moved.data() + 1, data.size() };
+        ASSERT_EQ(snapshot.ConstructionError().code, ErrorCode::None);
+        std::size_t files = snapshot.Find(mediaFilesMultiPosName);
+        ASSERT_LT(files, snapshot.ParamCount());
+        std::string_view file = snapshot.Value(files);
+        EXPECT_EQ(file, mediaFileName1);
+        EXPECT_GT(file.data(), moved.data());
+        EXPECT_LT(file.data(), moved.data() + moved.size());
+    }
+
+#ifndef _WIN32
+    TEST_F(ParseSnapshotTests, TravelsThroughAPipe)
+    {
+        ASSERT_EQ(mediaParser->Parse(), Parser::Status::Success);
+        SnapshotWriter writer;
+        writer.Add(*printOption);
+        std::vector<char> data(writer.Size());
+        writer.Write(data.data());
+
+        int fds[2];
+        ASSERT_EQ(pipe(fds), 0);
+        ASSERT_EQ(write(fds[1], data.data(), data.size()), 
+            static_cast<ssize_t>(data.size()));
+        close(fds[1]);
+
+        std::vector<char> received(data.size());
+        ASSERT_EQ(read(fds[0], received.data(), received.size()), 
+            static_cast<ssize_t>(received.size()));
+        close(fds[0]);
+
+        ParseSnapshot snapshot{ received.data(), received.size() };
+        ASSERT_EQ(snapshot.ParamCount(), 1);
+        EXPECT_EQ(snapshot.Value(0, 1), artistOptionParamName);
+    }
+#endif
+
+    TEST_F(ParseSnapshotTests, RejectsInvalidData)
+    {
+        ASSERT_EQ(mediaParser->Parse(), Parser::Status::Success);
+        std::vector<char> data = mediaParser->Snapshot();
+
+        EXPECT_CMD_LINE_ERROR(ParseSnapshot(data.data(), 
+            data.size() - 1).ConstructionError(), ParseSnapshot::Invalid, 
+            ErrorCode::InvalidSnapshot);
+        EXPECT_CMD_LINE_ERROR(ParseSnapshot(nullptr, 0).ConstructionError(),
+            ParseSnapshot::Invalid, ErrorCode::InvalidSnapshot);
+
+        std::vector<char> wrongMagic = data;
+        wrongMagic[0] ^= 1;
+        EXPECT_CMD_LINE_ERROR(ParseSnapshot(wrongMagic.data(), 
+            wrongMagic.size()).ConstructionError(), ParseSnapshot::Invalid, 
+            ErrorCode::InvalidSnapshot);
+
+        // The first ArgParam's name starts at offset 0 of the pool, so 
+        // moving it past the end makes the snapshot inconsistent.
+        std::vector<char> badOffset = data;
+        std::size_t nameOffset = 24 + 8;
+        std::uint32_t pastTheEnd = 0xFFFFFFF0;
+        std::memcpy(badOffset.data() + nameOffset, &pastTheEnd, 
+            sizeof(pastTheEnd));
+        EXPECT_CMD_LINE_ERROR(ParseSnapshot(badOffset.data(), 
+            badOffset.size()).ConstructionError(), ParseSnapshot::Invalid, 
+            ErrorCode::InvalidSnapshot);
+
+#ifdef CMD_LINE_NO_EXCEPTIONS
+        ParseSnapshot invalid{ wrongMagic.data(), wrongMagic.size() };
+        EXPECT_EQ(invalid.ParamCount(), 0);
+        EXPECT_FALSE(invalid.IsSpecified(verboseOption->Name()));
+#endif
+    }
+}
@@ -0,0 +1,53 @@
+// ParseSnapshotTests.h - Declares the ParseSnapshot test fixture.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_PARSE_SNAPSHOT_TESTS_H
+#define CMD_LINE_PARSE_SNAPSHOT_TESTS_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "ExampleArguments.h"
+#include "MultiPosParam.h"
+#include "Option.h"
+#include "ParseSnapshot.h"
+#include "Parser.h"
+#include "ProgParam.h"
+#include "TestAlgorithms.h"
+#include "ValueOption.h"
+
+namespace CmdLine
+{
+    /// @brief Test fixture for the ParseSnapshot tests.
+    ///
+    /// Snapshots what a hypothetical media program parsed. See 
+    /// ParseSnapshotTests.cpp for the actual tests.
+    class ParseSnapshotTests : public ::testing::Test
+    {
+    protected:
+        ParseSnapshotTests();
+
+        std::unique_ptr<ProgParam> mediaProgParam;
+        std::unique_ptr<Option> verboseOption;
+        std::unique_ptr<ValueOption> printOption;
+        std::unique_ptr<MultiPosParam> mediaFiles;
+        std::unique_ptr<Parser> mediaParser;
+    };
+}
+
+#endif
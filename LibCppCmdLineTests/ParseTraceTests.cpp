@@ -0,0 +1,199 @@
+// ParseTraceTests.cpp - Defines the ParseTrace tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include "ParseTraceTests.h"
+
+namespace CmdLine
+{
+    ParseTraceTests::ParseTraceTests()
+    {
+        copyProgramDef.name = copyProgramName;
+        copyProgramDef.description = copyProgramDescription;
+
+        verboseDef.shortName = verboseOptionShortName;
+        verboseDef.longName = verboseOptionLongName;
+        verboseDef.description = verboseOptionDescription;
+
+        printDef.shortName = printOptionShortName;
+        printDef.longName = printOptionLongName;
+        printDef.description = printOptionDescription;
+
+        destinationDef.name = copyDestinationPosName;
+        destinationDef.description = copyDestinationPosDescription;
+        destinationDef.isMandatory = true;
+
+        copyProgParam = std::make_unique<ProgParam>(copyProgramDef);
+        verboseOption = std::make_unique<Option>(verboseDef);
+        printOption = std::make_unique<ValueOption>(printDef);
+        destinationPos = std::make_unique<PosParam>(destinationDef);
+
+        copyParser = std::make_unique<Parser>(copyProgParam.get(), copyArgs);
+        copyParser->Add(verboseOption.get());
+        copyParser->Add(printOption.get());
+        copyParser->Add(destinationPos.get());
+    }
+
+    TEST_F(ParseTraceTests, KeepsDecisionsInRecordedOrder)
+    {
+        ParseTrace trace{ 4 };
+        trace.Record(0, "first", verboseOption.get(), false, 0);
+        trace.Record(1, "second", printOption.get(), true, 2);
+
+        ASSERT_EQ(trace.Size(), 2);
+        EXPECT_EQ(trace.Dropped(), 0);
+        EXPECT_EQ(trace.At(0).argIndex, 0);
+        EXPECT_STREQ(trace.At(0).argument, "first");
+        EXPECT_EQ(trace.At(0).candidate, verboseOption.get());
+        EXPECT_FALSE(trace.At(0).canPopulate);
+        EXPECT_EQ(trace.At(1).argIndex, 1);
+        EXPECT_TRUE(trace.At(1).canPopulate);
+        EXPECT_EQ(trace.At(1).consumes, 2);
+    }
+
+    TEST_F(ParseTraceTests, OverwritesOldestDecisionsWhenFull)
+    {
+        ParseTrace trace{ 3 };
+        for (std::size_t i = 0; i < 5; i++)
+            trace.Record(i, std::to_string(i), nullptr, false, 0);
+
+        ASSERT_EQ(trace.Size(), 3);
+        EXPECT_EQ(trace.Dropped(), 2);
+        EXPECT_EQ(trace.At(0).argIndex, 2);
+        EXPECT_EQ(trace.At(1).argIndex, 3);
+        EXPECT_EQ(trace.At(2).argIndex, 4);
+
+        trace.Clear();
+        EXPECT_EQ(trace.Size(), 0);
+        EXPECT_EQ(trace.Dropped(), 0);
+    }
+
+    TEST_F(ParseTraceTests, TruncatesLongArguments)
+    {
+        ParseTrace trace;
+        std::string exact(ParseDecision::maxArgumentLength, 'a');
+        std::string tooLong(ParseDecision::maxArgumentLength + 10, 'b');
+        trace.Record(0, exact, nullptr, false, 0);
+        trace.Record(1, tooLong, nullptr, false, 0);
+
+        EXPECT_EQ(trace.At(0).argument, exact);
+        EXPECT_FALSE(trace.At(0).truncated);
+        EXPECT_EQ(trace.At(1).argument, 
+            tooLong.substr(0, ParseDecision::maxArgumentLength));
+        EXPECT_TRUE(trace.At(1).truncated);
+    }
+
+    TEST_F(ParseTraceTests, RecordingDoesNotAllocate)
+    {
+        if (!AllocationTrackingEnabled())
+            GTEST_SKIP() << "allocation tracking is not compiled in";
+
+        ParseTrace trace{ 2 };
+        std::string argument(100, 'a');
+
+        AllocationScope scope;
+        for (std::size_t i = 0; i < 10; i++)
+            trace.Record(i, argument, verboseOption.get(), true, 1);
+        EXPECT_EQ(scope.Stats().allocations, 0);
+    }
+
+    TEST_F(ParseTraceTests, DumpsEachDecision)
+    {
+        ParseTrace trace{ 2 };
+        trace.Record(0, "dropped", nullptr, false, 0);
+        trace.Record(3, unixVerboseOptionShortName, printOption.get(), 
+            false, 0);
+        trace.Record(3, unixVerboseOptionShortName, verboseOption.get(), 
+            true, 1);
+
+        std::stringstream dump;
+        trace.Dump(dump);
+
+        std::string expected = 
+            "(1 earlier decisions dropped)\n"
+            "arg 3 \"" + std::string{ unixVerboseOptionShortName } + "\" -> " 
+            + printOption->Name() + ": cannot populate\n"
+            "arg 3 \"" + std::string{ unixVerboseOptionShortName } + "\" -> " 
+            + verboseOption->Name() + ": can populate, consumes 1\n";
+        EXPECT_EQ(dump.str(), expected);
+    }
+
+    TEST_F(ParseTraceTests, ParserRecordsEachCandidateTried)
+    {
+        if (!ParseTraceEnabled())
+            GTEST_SKIP() << "parse tracing is compiled out of this build";
+
+        ParseTrace trace;
+        copyParser->Set(&trace);
+
+        ASSERT_EQ(copyParser->Parse(), Parser::Status::Success);
+
+        // The print option consumes its value too, so the verbose option is
+        // the argument at index 3. Each argument goes to the first
+        // candidate that can populate from it.
+        std::vector<std::string> chosen;
+        for (std::size_t i = 0; i < trace.Size(); i++)
+        {
+            const ParseDecision& d = trace.At(i);
+            if (!d.canPopulate)
+                continue;
+
+            chosen.push_back(std::to_string(d.argIndex) + " " + d.argument +
+                " " + d.candidate->Name() + " " + std::to_string(d.consumes));
+        }
+
+        std::vector<std::string> expected
+        {
+            "0 " + copyProgParam->Name() + " " + copyProgParam->Name() + " 1",
+            "1 " + printOption->Name() + " " + printOption->Name() + " 2",
+            "3 " + verboseOption->Name() + " " + verboseOption->Name() + " 1",
+            "4 " + std::string{ copyDestinationFileName } + " " + 
+                destinationPos->Name() + " 1"
+        };
+        EXPECT_EQ(chosen, expected);
+        EXPECT_EQ(trace.At(trace.Size() - 1).candidate, destinationPos.get());
+    }
+
+    TEST_F(ParseTraceTests, ParserRecordsTheDecisionsBeforeAFailure)
+    {
+        if (!ParseTraceEnabled())
+            GTEST_SKIP() << "parse tracing is compiled out of this build";
+
+        ParseTrace trace;
+        Parser parser{ copyProgParam.get(), 
+            { copyProgramName, copyDestinationFileName, copyProgramName } };
+        parser.Add(destinationPos.get());
+        parser.Set(&trace);
+
+        ASSERT_EQ(parser.Parse(), Parser::Status::Failure);
+
+        // The last argument had no candidate that could populate from it.
+        const ParseDecision& last = trace.At(trace.Size() - 1);
+        EXPECT_EQ(last.argIndex, 2);
+        EXPECT_FALSE(last.canPopulate);
+    }
+
+    TEST_F(ParseTraceTests, ParserRecordsNothingWhenCompiledOut)
+    {
+        if (ParseTraceEnabled())
+            GTEST_SKIP() << "parse tracing is compiled into this build";
+
+        ParseTrace trace;
+        copyParser->Set(&trace);
+
+        ASSERT_EQ(copyParser->Parse(), Parser::Status::Success);
+        EXPECT_EQ(trace.Size(), 0);
+    }
+}
@@ -0,0 +1,72 @@
+// ParseTraceTests.h - Declares the ParseTraceTests fixture.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_PARSE_TRACE_TESTS_H
+#define CMD_LINE_PARSE_TRACE_TESTS_H
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "AllocationTracker.h"
+#include "ExampleArguments.h"
+#include "Parser.h"
+#include "ParseTrace.h"
+#include "Option.h"
+#include "ValueOption.h"
+#include "PosParam.h"
+#include "ProgParam.h"
+
+namespace CmdLine
+{
+    /// @brief Test fixture for the ParseTrace tests.
+    ///
+    /// Checks the ring buffer itself and, when the library records
+    /// decisions, the decisions a Parser records. See ParseTraceTests.cpp
+    /// for the actual tests.
+    class ParseTraceTests : public ::testing::Test
+    {
+    protected:
+        /// @brief Constructs the ParseTraceTests fixture.
+        ///
+        /// Defines and initializes the Params of a hypothetical copy 
+        /// program, along with a Parser that has all of them added.
+        ParseTraceTests();
+
+        std::vector<std::string> copyArgs
+        {
+            copyProgramName,
+            unixPrintOptionShortName,
+            songOptionParamName,
+            unixVerboseOptionShortName,
+            copyDestinationFileName
+        };
+
+        ProgParam::Definition copyProgramDef;
+        Option::Definition verboseDef;
+        ValueOption::Definition printDef;
+        PosParam::Definition destinationDef;
+
+        std::unique_ptr<ProgParam> copyProgParam;
+        std::unique_ptr<Option> verboseOption;
+        std::unique_ptr<ValueOption> printOption;
+        std::unique_ptr<PosParam> destinationPos;
+        std::unique_ptr<Parser> copyParser;
+    };
+}
+
+#endif
@@ -452,9 +452,12 @@ namespace CmdLine
         ProgParam* p = mediaProgParam.get();
 
         EXPECT_NO_THROW(Parser(p, a));
-        EXPECT_THROW(Parser(p, empty), Parser::EmptyArguments);
-        EXPECT_THROW(Parser(nullptr, a), Parser::NullParameter);
-        EXPECT_THROW(Parser(nullptr, empty), Parser::NullParameter);
+        EXPECT_CMD_LINE_ERROR(Parser(p, empty).ConstructionError(), 
+            Parser::EmptyArguments, ErrorCode::EmptyArguments);
+        EXPECT_CMD_LINE_ERROR(Parser(nullptr, a).ConstructionError(), 
+            Parser::NullParameter, ErrorCode::NullParameter);
+        EXPECT_CMD_LINE_ERROR(Parser(nullptr, empty).ConstructionError(), 
+            Parser::NullParameter, ErrorCode::NullParameter);
     }
 
     TEST_F(ParserTests, AddMethodEnforcesInvariantsWithOptions)
@@ -466,10 +469,12 @@ namespace CmdLine
         Option* nullOption = nullptr;
 
         EXPECT_NO_THROW(mediaParser->Add(mediaPrintOption.get()));
-        EXPECT_THROW(mediaParser->Add(dupMediaPrintOption.get()), Parser::DuplicateOption);
+        EXPECT_CMD_LINE_ERROR(mediaParser->Add(dupMediaPrintOption.get()), 
+            Parser::DuplicateOption, ErrorCode::DuplicateOption);
         EXPECT_NO_THROW(mediaParser->Add(mediaEditOption.get()));
         EXPECT_NO_THROW(mediaParser->Add(mediaVerboseOption.get()));
-        EXPECT_THROW(mediaParser->Add(nullOption), Parser::NullParameter);
+        EXPECT_CMD_LINE_ERROR(mediaParser->Add(nullOption), 
+            Parser::NullParameter, ErrorCode::NullParameter);
     }
 
     TEST_F(ParserTests, AddMethodEnforcesInvariantsWithPosParams)
@@ -481,9 +486,11 @@ namespace CmdLine
         PosParam* nullPositional = nullptr;
 
         EXPECT_NO_THROW(copyParser->Add(copyDestinationPos.get()));
-        EXPECT_THROW(copyParser->Add(dupCopyDestinationPos.get()), Parser::DuplicatePosParam);
+        EXPECT_CMD_LINE_ERROR(copyParser->Add(dupCopyDestinationPos.get()), 
+            Parser::DuplicatePosParam, ErrorCode::DuplicatePosParam);
         EXPECT_NO_THROW(searchParser->Add(searchPatternPos.get()));
-        EXPECT_THROW(searchParser->Add(nullPositional), Parser::NullParameter);
+        EXPECT_CMD_LINE_ERROR(searchParser->Add(nullPositional), 
+            Parser::NullParameter, ErrorCode::NullParameter);
     }
 
     TEST_F(ParserTests, ParsesUnixMediaArgumentsProperly)
@@ -617,4 +624,254 @@ namespace CmdLine
         EXPECT_EQ(nameLookupParser->Parse(), Parser::Status::Success);
         EXPECT_FALSE(nameLookupParser->BuiltInHelpOptionIsSpecified());
     }
+
+    TEST_F(ParserTests, ParsesOptionsSpecifiedAfterPositionalArguments)
+    {
+        std::vector<std::string> args
+        {
+            copyProgramName,
+            copySourceFileName1,
+            copySourceFileName2,
+            copyDestinationFileName,
+            unixVerboseOptionShortName
+        };
+
+        Parser parser{ copyProgParam.get(), args };
+        parser.Add(copyVerboseOption.get());
+        parser.Add(copyDestinationPos.get());
+        parser.Set(copySourcePos.get());
+
+        EXPECT_EQ(parser.Parse(), Parser::Status::Success);
+
+        expectedCopyProgramState.isSpecified = true;
+        expectedCopyProgramState.value = copyProgramName;
+        expectedCopyVerboseState.isSpecified = true;
+        expectedCopySourceState.isSpecified = true;
+        expectedCopySourceState.values.push_back(copySourceFileName1);
+        expectedCopySourceState.values.push_back(copySourceFileName2);
+        expectedCopyDestinationState.isSpecified = true;
+        expectedCopyDestinationState.value = copyDestinationFileName;
+
+        TestExpectedStates();
+    }
+
+    TEST_F(ParserTests, AddAcceptsOptionsWithoutLongNames)
+    {
+        Option::Definition firstDef;
+        firstDef.shortName = 'x';
+        Option::Definition secondDef;
+        secondDef.shortName = 'y';
+
+        Option first{ firstDef };
+        Option second{ secondDef };
+        Option dupFirst{ firstDef };
+
+        EXPECT_NO_THROW(mediaParser->Add(&first));
+        EXPECT_NO_THROW(mediaParser->Add(&second));
+        EXPECT_CMD_LINE_ERROR(mediaParser->Add(&dupFirst), 
+            Parser::DuplicateOption, ErrorCode::DuplicateOption);
+    }
+
+    TEST_F(ParserTests, SetStyleChecksDuplicatesAgainstNewNames)
+    {
+        Option::Definition unixDef;
+        unixDef.shortName = 'x';
+        Option::Definition windowsDef;
+        windowsDef.shortName = 'x';
+        windowsDef.style = Option::Style::Windows;
+
+        Option unixOption{ unixDef };
+        Option windowsOption{ windowsDef };
+        Option dupWindowsOption{ windowsDef };
+
+        mediaParser->Add(&unixOption);
+        mediaParser->Set(Option::Style::Windows);
+
+        EXPECT_CMD_LINE_ERROR(mediaParser->Add(&windowsOption), 
+            Parser::DuplicateOption, ErrorCode::DuplicateOption);
+        mediaParser->Set(Option::Style::Unix);
+        EXPECT_NO_THROW(mediaParser->Add(&windowsOption));
+        EXPECT_CMD_LINE_ERROR(mediaParser->Add(&dupWindowsOption), 
+            Parser::DuplicateOption, ErrorCode::DuplicateOption);
+    }
+
+    TEST_F(ParserTests, SetStyleReportsNamesThatCollide)
+    {
+        Option::Definition shortDef;
+        shortDef.shortName = 'x';
+        Option::Definition longDef;
+        longDef.longName = "x";
+        Option::Definition bothDef;
+        bothDef.shortName = 'y';
+        bothDef.longName = "y";
+
+        Option shortOption{ shortDef };
+        Option longOption{ longDef };
+        Option bothOption{ bothDef };
+
+        mediaParser->Add(&bothOption);
+        EXPECT_EQ(mediaParser->Set(Option::Style::Windows).code,
+            ErrorCode::None);
+        mediaParser->Set(Option::Style::Unix);
+
+        mediaParser->Add(&shortOption);
+        mediaParser->Add(&longOption);
+        EXPECT_CMD_LINE_ERROR(mediaParser->Set(Option::Style::Windows), 
+            Parser::DuplicateOption, ErrorCode::DuplicateOption);
+    }
+
+    TEST_F(ParserTests, EndOfOptionsMarkerMakesTheRestPositional)
+    {
+        Parser parser{ searchProgParam.get(), { searchProgramName, 
+            unixVerboseOptionShortName, endOfOptionsMarker, 
+            unixIgnoreCaseOptionShortName, searchFileName1, 
+            unixVerboseOptionLongName } };
+        parser.Add(searchIgnoreCaseOption.get());
+        parser.Add(searchPatternPos.get());
+        parser.Set(searchFilesMultiPos.get());
+
+        // The first argument isn't an Option of the search program, but the
+        // ones after the marker are positional however they look.
+        EXPECT_EQ(parser.Parse(), Parser::Status::Failure);
+        EXPECT_EQ(parser.LastError().kind, ParseError::Kind::UnknownOption);
+
+        Parser operands{ searchProgParam.get(), { searchProgramName, 
+            endOfOptionsMarker, unixIgnoreCaseOptionShortName, 
+            searchFileName1, unixVerboseOptionLongName } };
+        operands.Add(searchIgnoreCaseOption.get());
+        operands.Add(searchPatternPos.get());
+        operands.Set(searchFilesMultiPos.get());
+
+        ASSERT_EQ(operands.Parse(), Parser::Status::Success);
+        EXPECT_FALSE(searchIgnoreCaseOption->IsSpecified());
+        EXPECT_EQ(searchPatternPos->Value(), unixIgnoreCaseOptionShortName);
+
+        std::vector<std::string> files{ searchFileName1, 
+            unixVerboseOptionLongName };
+        EXPECT_EQ(searchFilesMultiPos->Values(), files);
+    }
+
+    TEST_F(ParserTests, EndOfOptionsMarkerKeepsTheParsingOrder)
+    {
+        // Options before the marker are still parsed, and with the 
+        // AfterOptions order the last operand is still the destination.
+        Parser parser{ copyProgParam.get(), { copyProgramName, 
+            unixVerboseOptionShortName, copySourceFileName1, 
+            endOfOptionsMarker, unixVerboseOptionLongName, 
+            copyDestinationFileName } };
+        parser.Add(copyVerboseOption.get());
+        parser.Add(copyDestinationPos.get());
+        parser.Set(copySourcePos.get());
+
+        ASSERT_EQ(parser.Parse(), Parser::Status::Success);
+        EXPECT_TRUE(copyVerboseOption->IsSpecified());
+        EXPECT_EQ(copyDestinationPos->Value(), copyDestinationFileName);
+
+        std::vector<std::string> sources{ copySourceFileName1, 
+            unixVerboseOptionLongName };
+        EXPECT_EQ(copySourcePos->Values(), sources);
+    }
+
+    TEST_F(ParserTests, PositionalsMayBeOnBothSidesOfTheMarker)
+    {
+        // The operand that looks like an Option mustn't stop the file 
+        // before the marker from populating the MultiPosParam.
+        Parser parser{ searchProgParam.get(), { searchProgramName, 
+            searchPatternText, searchFileName1, endOfOptionsMarker, 
+            unixVerboseOptionShortName } };
+        parser.Add(searchPatternPos.get());
+        parser.Set(searchFilesMultiPos.get());
+
+        ASSERT_EQ(searchFilesMultiPos->Order(), 
+            MultiPosParam::ParsingOrder::End);
+        ASSERT_EQ(parser.Parse(), Parser::Status::Success);
+        EXPECT_EQ(searchPatternPos->Value(), searchPatternText);
+
+        std::vector<std::string> files{ searchFileName1, 
+            unixVerboseOptionShortName };
+        EXPECT_EQ(searchFilesMultiPos->Values(), files);
+    }
+
+    TEST_F(ParserTests, EndOfOptionsMarkerAloneIsDropped)
+    {
+        Parser parser{ searchProgParam.get(), { searchProgramName, 
+            searchPatternText, endOfOptionsMarker } };
+        parser.Add(searchPatternPos.get());
+        parser.Set(searchFilesMultiPos.get());
+
+        ASSERT_EQ(parser.Parse(), Parser::Status::Success);
+        EXPECT_EQ(searchPatternPos->Value(), searchPatternText);
+        EXPECT_FALSE(searchFilesMultiPos->IsSpecified());
+    }
+
+    TEST_F(ParserTests, ExtraOperandsAreUnexpected)
+    {
+        Parser parser{ searchProgParam.get(), { searchProgramName, 
+            endOfOptionsMarker, searchPatternText, searchFileName1 } };
+        parser.Add(searchPatternPos.get());
+
+        ASSERT_EQ(parser.Parse(), Parser::Status::Failure);
+        EXPECT_EQ(parser.LastError().kind, 
+            ParseError::Kind::UnexpectedArgument);
+        EXPECT_EQ(parser.LastError().argIndex, 3);
+    }
+
+    TEST_F(ParserTests, HelpShortCircuitsBadArguments)
+    {
+        Parser parser{ searchProgParam.get(), { searchProgramName, "-z", 
+            searchPatternText, unixHelpOptionShortName, searchFileName1 } };
+        parser.Add(searchPatternPos.get());
+
+        // Neither the unknown option nor the extra positional argument stop
+        // help from being shown.
+        ASSERT_EQ(parser.Parse(), Parser::Status::Success);
+        EXPECT_TRUE(parser.BuiltInHelpOptionIsSpecified());
+        EXPECT_TRUE(searchProgParam->IsSpecified());
+        EXPECT_FALSE(searchPatternPos->IsSpecified());
+        EXPECT_EQ(parser.LastError().kind, ParseError::Kind::None);
+    }
+
+    TEST_F(ParserTests, ShortCircuitOptionsStopParsing)
+    {
+        Option::Definition versionDef;
+        versionDef.longName = "version";
+        versionDef.isShortCircuit = true;
+        Option version{ versionDef };
+
+        Parser parser{ searchProgParam.get(), { searchProgramName, 
+            unixIgnoreCaseOptionShortName, "--version", searchPatternText } };
+        parser.Add(searchIgnoreCaseOption.get());
+        parser.Add(&version);
+        parser.Add(searchPatternPos.get());
+
+        ASSERT_EQ(parser.Parse(), Parser::Status::Success);
+        EXPECT_TRUE(version.IsSpecified());
+        EXPECT_FALSE(parser.BuiltInHelpOptionIsSpecified());
+        EXPECT_FALSE(searchIgnoreCaseOption->IsShortCircuit());
+        EXPECT_FALSE(searchIgnoreCaseOption->IsSpecified());
+        EXPECT_FALSE(searchPatternPos->IsSpecified());
+    }
+
+    TEST_F(ParserTests, OperandsDoNotShortCircuit)
+    {
+        Parser parser{ searchProgParam.get(), { searchProgramName, 
+            endOfOptionsMarker, unixHelpOptionShortName } };
+        parser.Add(searchPatternPos.get());
+
+        ASSERT_EQ(parser.Parse(), Parser::Status::Success);
+        EXPECT_FALSE(parser.BuiltInHelpOptionIsSpecified());
+        EXPECT_EQ(searchPatternPos->Value(), unixHelpOptionShortName);
+    }
+
+    TEST_F(ParserTests, BadArgumentsStillFailWithoutAShortCircuit)
+    {
+        Parser parser{ searchProgParam.get(), { searchProgramName, "-z", 
+            endOfOptionsMarker, unixHelpOptionShortName } };
+        parser.Add(searchPatternPos.get());
+
+        ASSERT_EQ(parser.Parse(), Parser::Status::Failure);
+        EXPECT_FALSE(parser.BuiltInHelpOptionIsSpecified());
+        EXPECT_EQ(parser.LastError().kind, ParseError::Kind::UnknownOption);
+        EXPECT_EQ(parser.LastError().argIndex, 1);
+    }
 }
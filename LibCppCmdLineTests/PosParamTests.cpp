@@ -136,4 +136,19 @@ namespace CmdLine
         EXPECT_EQ(searchPatternPosParam->Consumes(posArgs), 1);
         EXPECT_EQ(copyDestinationPosParam->Consumes(posArgs), 1);
     }
+
+    TEST_F(PosParamTests, PopulatesOperandsThatLookLikeOptions)
+    {
+        std::deque<std::string> operands{ unixVerboseOptionShortName };
+        EXPECT_FALSE(searchPatternPosParam->CanPopulate(operands));
+
+        EXPECT_TRUE(searchPatternPosParam->PopulateOperand(operands));
+        EXPECT_TRUE(searchPatternPosParam->IsSpecified());
+        EXPECT_EQ(searchPatternPosParam->Value(), unixVerboseOptionShortName);
+        EXPECT_TRUE(operands.empty());
+
+        operands.push_back(searchPatternText);
+        EXPECT_FALSE(searchPatternPosParam->PopulateOperand(operands));
+        EXPECT_EQ(operands.size(), 1);
+    }
 }
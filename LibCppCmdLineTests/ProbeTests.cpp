@@ -0,0 +1,117 @@
+// ProbeTests.cpp - Defines the Probe tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include "ProbeTests.h"
+
+namespace CmdLine
+{
+    ProbeTests::ProbeTests()
+    {
+        verboseDef.shortName = verboseOptionShortName;
+        verboseDef.longName = verboseOptionLongName;
+        verboseDef.description = verboseOptionDescription;
+
+        printDef.shortName = printOptionShortName;
+        printDef.longName = printOptionLongName;
+        printDef.description = printOptionDescription;
+    }
+
+    TEST_F(ProbeTests, FindsAnOptionByEitherName)
+    {
+        ProbeResult verbose = Probe(mediaArgs, verboseDef);
+        EXPECT_TRUE(verbose.isSpecified);
+        EXPECT_EQ(verbose.argIndex, 4);
+        EXPECT_TRUE(verbose.value.empty());
+
+        ProbeResult print = Probe(mediaArgs, printDef);
+        EXPECT_TRUE(print.isSpecified);
+        EXPECT_EQ(print.argIndex, 1);
+        EXPECT_EQ(print.value, songOptionParamName);
+    }
+
+    TEST_F(ProbeTests, ProbesArgumentsAsPassedToMain)
+    {
+        const char* argv[]
+        { 
+            mediaProgramName, unixVerboseOptionShortName, 
+            unixPrintOptionLongName, songOptionParamName 
+        };
+        int argc = sizeof(argv) / sizeof(argv[0]);
+
+        EXPECT_TRUE(Probe(argc, argv, verboseDef).isSpecified);
+        EXPECT_EQ(Probe(argc, argv, printDef).value, songOptionParamName);
+        EXPECT_FALSE(Probe(0, nullptr, verboseDef).isSpecified);
+    }
+
+    TEST_F(ProbeTests, ReportsTheLastValue)
+    {
+        mediaArgs.push_back(unixPrintOptionLongName);
+        mediaArgs.push_back(artistOptionParamName);
+
+        ProbeResult print = Probe(mediaArgs, printDef);
+        EXPECT_EQ(print.argIndex, 5);
+        EXPECT_EQ(print.value, artistOptionParamName);
+
+        // A final occurrence without a value doesn't count.
+        mediaArgs.push_back(unixPrintOptionShortName);
+        EXPECT_EQ(Probe(mediaArgs, printDef).argIndex, 5);
+    }
+
+    TEST_F(ProbeTests, IgnoresTheProgramNameAndOperands)
+    {
+        std::vector<std::string> args
+        { 
+            unixVerboseOptionShortName, endOfOptionsMarker, 
+            unixVerboseOptionLongName 
+        };
+        EXPECT_FALSE(Probe(args, verboseDef).isSpecified);
+    }
+
+    TEST_F(ProbeTests, RespectsTheOptionStyle)
+    {
+        verboseDef.style = Option::Style::Windows;
+        EXPECT_FALSE(Probe(mediaArgs, verboseDef).isSpecified);
+
+        mediaArgs.push_back(windowsVerboseOptionShortName);
+        EXPECT_TRUE(Probe(mediaArgs, verboseDef).isSpecified);
+    }
+
+    TEST_F(ProbeTests, MatchesOnlyWholeNames)
+    {
+        Option::Definition shortOnly;
+        shortOnly.shortName = verboseOptionShortName;
+
+        EXPECT_TRUE(MatchesOption(unixVerboseOptionShortName, shortOnly));
+        EXPECT_FALSE(MatchesOption("", shortOnly));
+        EXPECT_FALSE(MatchesOption(unixVerboseOptionLongName, shortOnly));
+        EXPECT_FALSE(MatchesOption("-vv", verboseDef));
+        EXPECT_FALSE(MatchesOption("--verbos", verboseDef));
+        EXPECT_FALSE(MatchesOption("--verbosee", verboseDef));
+        EXPECT_FALSE(MatchesOption("/verbose", verboseDef));
+    }
+
+    TEST_F(ProbeTests, DoesNotAllocate)
+    {
+        if (!AllocationTrackingEnabled())
+            GTEST_SKIP() << "allocation tracking is not compiled in";
+
+        AllocationScope scope;
+        ProbeResult verbose = Probe(mediaArgs, verboseDef);
+        ProbeResult print = Probe(mediaArgs, printDef);
+        EXPECT_EQ(scope.Stats().allocations, 0);
+        EXPECT_TRUE(verbose.isSpecified && print.isSpecified);
+    }
+}
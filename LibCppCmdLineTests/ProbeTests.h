@@ -0,0 +1,57 @@
+// ProbeTests.h - Declares the Probe test fixture.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_PROBE_TESTS_H
+#define CMD_LINE_PROBE_TESTS_H
+
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "AllocationTracker.h"
+#include "ExampleArguments.h"
+#include "Probe.h"
+#include "Option.h"
+#include "ValueOption.h"
+
+namespace CmdLine
+{
+    /// @brief Test fixture for the Probe tests.
+    ///
+    /// Probes the arguments of a hypothetical media program for its verbose
+    /// and print options. See ProbeTests.cpp for the actual tests.
+    class ProbeTests : public ::testing::Test
+    {
+    protected:
+        /// @brief Constructs the ProbeTests fixture.
+        ///
+        /// Defines the verbose Option and the print ValueOption.
+        ProbeTests();
+
+        std::vector<std::string> mediaArgs
+        {
+            mediaProgramName,
+            unixPrintOptionShortName,
+            songOptionParamName,
+            mediaFileName1,
+            unixVerboseOptionLongName
+        };
+
+        Option::Definition verboseDef;
+        ValueOption::Definition printDef;
+    };
+}
+
+#endif
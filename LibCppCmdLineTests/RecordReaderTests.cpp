@@ -0,0 +1,197 @@
+// RecordReaderTests.cpp - Defines the RecordReader tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#include "RecordReaderTests.h"
+
+#include <algorithm>
+#include <thread>
+
+#ifndef _WIN32
+#include <unistd.h>
+
+namespace CmdLine
+{
+    RecordReaderTests::~RecordReaderTests()
+    {
+        for (int fd : openFds)
+            close(fd);
+    }
+
+    void RecordReaderTests::OpenPipe(int& readFd, int& writeFd)
+    {
+        int fds[2];
+        ASSERT_EQ(pipe(fds), 0);
+        readFd = fds[0];
+        writeFd = fds[1];
+        openFds.push_back(readFd);
+        openFds.push_back(writeFd);
+    }
+
+    void RecordReaderTests::Write(int fd, std::string_view data)
+    {
+        while (!data.empty())
+        {
+            ssize_t count = write(fd, data.data(), data.size());
+            ASSERT_GT(count, 0);
+            data.remove_prefix(static_cast<std::size_t>(count));
+        }
+    }
+
+    void RecordReaderTests::Close(int fd)
+    {
+        close(fd);
+        openFds.erase(std::find(openFds.begin(), openFds.end(), fd));
+    }
+
+    std::vector<std::string> RecordReaderTests::ReadAll(RecordReader& reader)
+    {
+        std::vector<std::string> records;
+        std::string_view record;
+        while (reader.Next(record))
+            records.emplace_back(record);
+
+        return records;
+    }
+
+    TEST_F(RecordReaderTests, ReadsNullTerminatedRecords)
+    {
+        int readFd, writeFd;
+        OpenPipe(readFd, writeFd);
+        Write(writeFd, std::string{ mediaFileName1 } + '\0' + "My Song.mp3" + 
+            '\0' + '\0' + mediaFileName2);
+        Close(writeFd);
+
+        RecordReader reader{ readFd, '\0' };
+        std::vector<std::string> expected
+        { 
+            mediaFileName1, "My Song.mp3", mediaFileName2 
+        };
+        EXPECT_EQ(ReadAll(reader), expected);
+        EXPECT_FALSE(reader.Failed());
+    }
+
+    TEST_F(RecordReaderTests, KeepsEmptyRecordsWhenAsked)
+    {
+        int readFd, writeFd;
+        OpenPipe(readFd, writeFd);
+        Write(writeFd, std::string{ mediaProgramName } + '\0' + '\0' + 
+            mediaFileName1 + '\0');
+        Close(writeFd);
+
+        // The input ending after the last delimiter isn't another record.
+        RecordReader reader{ readFd, '\0', defaultRecordChunkSize, true };
+        std::vector<std::string> expected
+        { 
+            mediaProgramName, "", mediaFileName1 
+        };
+        EXPECT_EQ(ReadAll(reader), expected);
+    }
+
+    TEST_F(RecordReaderTests, ReadsLines)
+    {
+        int readFd, writeFd;
+        OpenPipe(readFd, writeFd);
+        Write(writeFd, std::string{ mediaFileName1 } + "\r\n\n" + 
+            mediaFileName2 + "\n");
+        Close(writeFd);
+
+        RecordReader reader{ readFd, '\n' };
+        std::vector<std::string> expected{ mediaFileName1, mediaFileName2 };
+        EXPECT_EQ(ReadAll(reader), expected);
+    }
+
+    TEST_F(RecordReaderTests, ReadsRecordsLongerThanAChunk)
+    {
+        int readFd, writeFd;
+        OpenPipe(readFd, writeFd);
+
+        std::vector<std::string> expected;
+        std::string data;
+        for (std::size_t length = 1; length < 40; length += 3)
+        {
+            expected.push_back(std::string(length, 'a' + length % 26));
+            data += expected.back() + '\0';
+        }
+
+        Write(writeFd, data);
+        Close(writeFd);
+
+        RecordReader reader{ readFd, '\0', 4 };
+        EXPECT_EQ(ReadAll(reader), expected);
+    }
+
+    TEST_F(RecordReaderTests, DeliversRecordsBeforeTheInputEnds)
+    {
+        int readFd, writeFd;
+        OpenPipe(readFd, writeFd);
+        RecordReader reader{ readFd, '\0' };
+        std::string_view record;
+
+        // The pipe is still open, so each record must be handed out as soon
+        // as it is complete rather than once the input ends.
+        Write(writeFd, std::string{ mediaFileName1 } + '\0');
+        ASSERT_TRUE(reader.Next(record));
+        EXPECT_EQ(record, mediaFileName1);
+
+        Write(writeFd, mediaFileName2);
+        Close(writeFd);
+        ASSERT_TRUE(reader.Next(record));
+        EXPECT_EQ(record, mediaFileName2);
+        EXPECT_FALSE(reader.Next(record));
+    }
+
+    TEST_F(RecordReaderTests, StreamsMoreThanThePipeHolds)
+    {
+        int readFd, writeFd;
+        OpenPipe(readFd, writeFd);
+
+        const std::size_t recordCount = 100000;
+        std::thread writer{ [this, writeFd, recordCount] 
+        {
+            for (std::size_t i = 0; i < recordCount; i++)
+                Write(writeFd, "src/file" + std::to_string(i) + ".cpp\n");
+
+            close(writeFd);
+        } };
+
+        RecordReader reader{ readFd, '\n' };
+        std::size_t count = 0;
+        std::string_view record;
+        bool inOrder = true;
+        while (reader.Next(record))
+        {
+            inOrder = inOrder && 
+                record == "src/file" + std::to_string(count) + ".cpp";
+            count++;
+        }
+
+        writer.join();
+        openFds.erase(std::find(openFds.begin(), openFds.end(), writeFd));
+        EXPECT_EQ(count, recordCount);
+        EXPECT_TRUE(inOrder);
+    }
+
+    TEST_F(RecordReaderTests, ReportsFailedReads)
+    {
+        RecordReader reader{ -1, '\0' };
+        std::string_view record;
+        EXPECT_FALSE(reader.Next(record));
+        EXPECT_TRUE(reader.Failed());
+    }
+}
+
+#endif
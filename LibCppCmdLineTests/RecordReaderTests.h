@@ -0,0 +1,68 @@
+// RecordReaderTests.h - Declares the RecordReader tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_RECORD_READER_TESTS_H
+#define CMD_LINE_RECORD_READER_TESTS_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "gtest/gtest.h"
+#include "ExampleArguments.h"
+#include "RecordReader.h"
+
+namespace CmdLine
+{
+    /// @brief Test fixture for the RecordReader tests.
+    ///
+    /// Feeds records to a RecordReader through a pipe, as a pipeline would
+    /// feed them to a program's standard input. See RecordReaderTests.cpp
+    /// for the actual tests.
+    class RecordReaderTests : public ::testing::Test
+    {
+    protected:
+        /// @brief Closes the pipes opened by the test.
+        ~RecordReaderTests();
+
+        /// @brief Opens a pipe.
+        ///
+        /// @param readFd Set to the descriptor of the read end.
+        /// @param writeFd Set to the descriptor of the write end.
+        void OpenPipe(int& readFd, int& writeFd);
+
+        /// @brief Writes to a pipe.
+        ///
+        /// @param fd The descriptor of the write end of the pipe.
+        /// @param data The data to write.
+        void Write(int fd, std::string_view data);
+
+        /// @brief Closes one end of a pipe.
+        ///
+        /// @param fd The descriptor to close.
+        void Close(int fd);
+
+        /// @brief Reads every record.
+        ///
+        /// @param reader The RecordReader to read with.
+        /// @return The records, in order.
+        std::vector<std::string> ReadAll(RecordReader& reader);
+
+        std::vector<int> openFds;
+    };
+}
+
+#endif
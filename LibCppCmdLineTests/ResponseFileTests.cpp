@@ -0,0 +1,163 @@
+// ResponseFileTests.cpp - Defines the ResponseFile tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#include "ResponseFileTests.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace CmdLine
+{
+    ResponseFileTests::~ResponseFileTests()
+    {
+        for (auto& path : writtenFiles)
+            std::remove(path.c_str());
+    }
+
+    std::string ResponseFileTests::WriteFile(const std::string& name, 
+        const std::string& contents)
+    {
+        // Tests may run in parallel, so each test's files are named after it.
+        std::string test = 
+            ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        std::filesystem::path path = std::filesystem::temp_directory_path() / 
+            ("libcppcmdtests_" + test + "_" + name);
+
+        std::ofstream file{ path, std::ios::binary };
+        file << contents;
+        writtenFiles.push_back(path.string());
+        return path.string();
+    }
+
+    TEST_F(ResponseFileTests, ReadsOneArgumentPerLine)
+    {
+        std::string path = WriteFile("media.rsp", 
+            std::string{ mediaFileName1 } + "\n" + mediaFileName2 + "\n");
+
+        ResponseFile file{ path };
+        ASSERT_EQ(file.ConstructionError().code, ErrorCode::None);
+        ASSERT_EQ(file.Args().size(), 2);
+        EXPECT_EQ(file.Args()[0], mediaFileName1);
+        EXPECT_EQ(file.Args()[1], mediaFileName2);
+    }
+
+    TEST_F(ResponseFileTests, KeepsSpacesAndIgnoresEmptyLines)
+    {
+        std::string path = WriteFile("media.rsp", 
+            "My Song.mp3\r\n\r\n\n-v\nlast line");
+
+        ResponseFile file{ path };
+        ASSERT_EQ(file.Args().size(), 3);
+        EXPECT_EQ(file.Args()[0], "My Song.mp3");
+        EXPECT_EQ(file.Args()[1], "-v");
+        EXPECT_EQ(file.Args()[2], "last line");
+
+        ResponseFile empty{ WriteFile("empty.rsp", "") };
+        EXPECT_EQ(empty.ConstructionError().code, ErrorCode::None);
+        EXPECT_TRUE(empty.Args().empty());
+    }
+
+    TEST_F(ResponseFileTests, MissingFilesAreUnreadable)
+    {
+        std::string missing = (std::filesystem::temp_directory_path() / 
+            "libcppcmdtests_missing.rsp").string();
+
+        EXPECT_CMD_LINE_ERROR(ResponseFile{ missing }.ConstructionError(), 
+            ResponseFile::Unreadable, ErrorCode::UnreadableResponseFile);
+        EXPECT_CMD_LINE_ERROR(ResponseFile{ 
+            std::filesystem::temp_directory_path().string() 
+        }.ConstructionError(), ResponseFile::Unreadable, 
+            ErrorCode::UnreadableResponseFile);
+
+        std::vector<std::string> args{ mediaProgramName, "@" + missing };
+        std::vector<std::string> original = args;
+        EXPECT_CMD_LINE_ERROR(ExpandResponseFiles(args), 
+            ResponseFile::Unreadable, ErrorCode::UnreadableResponseFile);
+        EXPECT_EQ(args, original);
+    }
+
+    TEST_F(ResponseFileTests, ExpandsResponseFilesInPlace)
+    {
+        std::string first = WriteFile("first.rsp", 
+            std::string{ mediaFileName1 } + "\n");
+        std::string second = WriteFile("second.rsp", 
+            std::string{ mediaFileName2 } + "\n" + mediaFileName1 + "\n");
+
+        std::vector<std::string> args
+        { 
+            mediaProgramName, "@" + first, unixVerboseOptionShortName, 
+            "@" + second
+        };
+        ASSERT_EQ(ExpandResponseFiles(args).code, ErrorCode::None);
+
+        std::vector<std::string> expected
+        {
+            mediaProgramName, mediaFileName1, unixVerboseOptionShortName,
+            mediaFileName2, mediaFileName1
+        };
+        EXPECT_EQ(args, expected);
+    }
+
+    TEST_F(ResponseFileTests, LeavesOtherArgumentsAlone)
+    {
+        std::string path = WriteFile("media.rsp", 
+            std::string{ "@" } + mediaFileName1 + "\n");
+
+        // The program name, a lone prefix, arguments after the 
+        // end-of-options marker and arguments read from a file are never
+        // expanded.
+        std::vector<std::string> args
+        { 
+            "@" + path, "@", "@" + path, endOfOptionsMarker, "@" + path
+        };
+        ASSERT_EQ(ExpandResponseFiles(args).code, ErrorCode::None);
+
+        std::vector<std::string> expected
+        {
+            "@" + path, "@", std::string{ "@" } + mediaFileName1, 
+            endOfOptionsMarker, "@" + path
+        };
+        EXPECT_EQ(args, expected);
+    }
+
+    TEST_F(ResponseFileTests, ExpandedArgumentsParse)
+    {
+        std::string contents;
+        for (int i = 0; i < 1000; i++)
+            contents += "song" + std::to_string(i) + ".mp3\n";
+        std::string path = WriteFile("songs.rsp", contents);
+
+        ProgParam::Definition programDef;
+        programDef.name = mediaProgramName;
+        ProgParam program{ programDef };
+
+        MultiPosParam::Definition songsDef;
+        songsDef.name = "SONGS";
+        MultiPosParam songs{ songsDef };
+
+        std::vector<std::string> args{ mediaProgramName, "@" + path };
+        ASSERT_EQ(ExpandResponseFiles(args).code, ErrorCode::None);
+
+        Parser parser{ &program, args };
+        parser.Set(&songs);
+        ASSERT_EQ(parser.Parse(), Parser::Status::Success);
+        ASSERT_EQ(songs.Values().size(), 1000);
+        EXPECT_EQ(songs.Values().front(), "song0.mp3");
+        EXPECT_EQ(songs.Values().back(), "song999.mp3");
+    }
+}
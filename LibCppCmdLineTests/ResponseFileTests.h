@@ -0,0 +1,55 @@
+// ResponseFileTests.h - Declares the ResponseFile tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_RESPONSE_FILE_TESTS_H
+#define CMD_LINE_RESPONSE_FILE_TESTS_H
+
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "ExampleArguments.h"
+#include "MultiPosParam.h"
+#include "Parser.h"
+#include "ProgParam.h"
+#include "ResponseFile.h"
+#include "TestAlgorithms.h"
+
+namespace CmdLine
+{
+    /// @brief Test fixture for the ResponseFile tests.
+    ///
+    /// Writes response files for a hypothetical media program to a 
+    /// temporary directory. See ResponseFileTests.cpp for the actual tests.
+    class ResponseFileTests : public ::testing::Test
+    {
+    protected:
+        /// @brief Removes the response files written by the test.
+        ~ResponseFileTests();
+
+        /// @brief Writes a response file.
+        ///
+        /// @param name The name of the file in the temporary directory.
+        /// @param contents The contents of the file.
+        /// @return The path of the file.
+        std::string WriteFile(const std::string& name, 
+            const std::string& contents);
+
+        std::vector<std::string> writtenFiles;
+    };
+}
+
+#endif
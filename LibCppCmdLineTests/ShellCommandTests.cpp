@@ -0,0 +1,161 @@
+// ShellCommandTests.cpp - Defines the ShellCommand tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#include "ShellCommandTests.h"
+
+namespace CmdLine
+{
+    std::vector<std::string> ShellCommandTests::Split(
+        std::string_view command)
+    {
+        ShellCommand shellCommand{ command };
+        return std::vector<std::string>{ shellCommand.Args().begin(), 
+            shellCommand.Args().end() };
+    }
+
+    bool ShellCommandTests::IsViewOf(std::string_view arg, 
+        std::string_view command)
+    {
+        return arg.data() >= command.data() && 
+            arg.data() + arg.size() <= command.data() + command.size();
+    }
+
+    TEST_F(ShellCommandTests, SplitsOnBlanks)
+    {
+        using Args = std::vector<std::string>;
+        EXPECT_EQ(Split("cp -v a.mp3"), (Args{ "cp", "-v", "a.mp3" }));
+        EXPECT_EQ(Split("  cp\t-v \n\n a.mp3  \t"), 
+            (Args{ "cp", "-v", "a.mp3" }));
+        EXPECT_TRUE(Split("").empty());
+        EXPECT_TRUE(Split(" \t\n ").empty());
+
+        // Carriage returns aren't blanks to a POSIX shell.
+        EXPECT_EQ(Split("cp\r a"), (Args{ "cp\r", "a" }));
+    }
+
+    TEST_F(ShellCommandTests, RemovesQuotes)
+    {
+        using Args = std::vector<std::string>;
+        EXPECT_EQ(Split("cp 'My Song.mp3' \"My Album\""), 
+            (Args{ "cp", "My Song.mp3", "My Album" }));
+        EXPECT_EQ(Split("a'b c'\"d e\"f"), (Args{ "ab cd ef" }));
+        EXPECT_EQ(Split("'' \"\" x''"), (Args{ "", "", "x" }));
+        EXPECT_EQ(Split("'\"' \"'\""), (Args{ "\"", "'" }));
+        EXPECT_EQ(Split("'a\\b' 'line\nbreak'"), 
+            (Args{ "a\\b", "line\nbreak" }));
+    }
+
+    TEST_F(ShellCommandTests, RemovesEscapes)
+    {
+        using Args = std::vector<std::string>;
+        EXPECT_EQ(Split("My\\ Song.mp3 \\'q\\\" \\\\ \\x"), 
+            (Args{ "My Song.mp3", "'q\"", "\\", "x" }));
+
+        // A backslash before a newline continues the line.
+        EXPECT_EQ(Split("cp a\\\nb \\\n c"), (Args{ "cp", "ab", "c" }));
+
+        // Inside double quotes only $, `, ", \ and a newline are quoted.
+        EXPECT_EQ(Split("\"\\$x \\` \\\" \\\\ \\q \\\nend\""), 
+            (Args{ "$x ` \" \\ \\q end" }));
+
+        // A backslash ending the command is kept.
+        EXPECT_EQ(Split("cp a\\"), (Args{ "cp", "a\\" }));
+    }
+
+    TEST_F(ShellCommandTests, ExpandsNothing)
+    {
+        using Args = std::vector<std::string>;
+        EXPECT_EQ(Split("echo $HOME ~ *.mp3 `id` a;b | # c"), 
+            (Args{ "echo", "$HOME", "~", "*.mp3", "`id`", "a;b", "|", "#", 
+                "c" }));
+    }
+
+    TEST_F(ShellCommandTests, FindsSpecialsAtEveryOffset)
+    {
+        // Arguments longer than a 16 byte block, with the byte that needs 
+        // unescaping at every offset across a block boundary.
+        for (std::size_t offset = 0; offset < 40; offset++)
+        {
+            std::string prefix(offset, 'a');
+            std::string command = "cp " + prefix + "\\ b \"" + prefix + 
+                "\\\"\" '" + prefix + "'";
+
+            std::vector<std::string> args = Split(command);
+            ASSERT_EQ(args.size(), 4) << command;
+            EXPECT_EQ(args[1], prefix + " b");
+            EXPECT_EQ(args[2], prefix + "\"");
+            EXPECT_EQ(args[3], prefix);
+        }
+    }
+
+    TEST_F(ShellCommandTests, OnlyCopiesUnescapedArguments)
+    {
+        std::string command{ "cp -v 'My Song.mp3' \"My Album\" My\\ Song" };
+        ShellCommand shellCommand{ command };
+        const std::vector<std::string_view>& args = shellCommand.Args();
+        ASSERT_EQ(args.size(), 5);
+        EXPECT_TRUE(IsViewOf(args[0], command));
+        EXPECT_TRUE(IsViewOf(args[1], command));
+        EXPECT_TRUE(IsViewOf(args[2], command));
+        EXPECT_TRUE(IsViewOf(args[3], command));
+        EXPECT_FALSE(IsViewOf(args[4], command));
+        EXPECT_EQ(args[4], "My Song");
+    }
+
+    TEST_F(ShellCommandTests, RejectsUnterminatedQuotes)
+    {
+        EXPECT_CMD_LINE_ERROR(ShellCommand{ "cp 'a b" }.ConstructionError(), 
+            ShellCommand::UnterminatedQuote, ErrorCode::UnterminatedQuote);
+        EXPECT_CMD_LINE_ERROR(ShellCommand{ "cp \"a b" }.ConstructionError(),
+            ShellCommand::UnterminatedQuote, ErrorCode::UnterminatedQuote);
+        EXPECT_CMD_LINE_ERROR(ShellCommand{ "cp \"a\\" }.ConstructionError(),
+            ShellCommand::UnterminatedQuote, ErrorCode::UnterminatedQuote);
+        EXPECT_CMD_LINE_ERROR(ShellCommand{ "cp \"'\" '" }.ConstructionError(),
+            ShellCommand::UnterminatedQuote, ErrorCode::UnterminatedQuote);
+
+#ifdef CMD_LINE_NO_EXCEPTIONS
+        ShellCommand unterminated{ "cp a 'b" };
+        EXPECT_TRUE(unterminated.Args().empty());
+#endif
+    }
+
+    TEST_F(ShellCommandTests, FeedsParsers)
+    {
+        ProgParam::Definition programDef;
+        programDef.name = mediaProgramName;
+        ProgParam program{ programDef };
+
+        ValueOption::Definition printDef;
+        printDef.shortName = printOptionShortName;
+        printDef.longName = printOptionLongName;
+        ValueOption print{ printDef };
+
+        std::string command = std::string{ mediaProgramName } + " " + 
+            unixPrintOptionLongName + " 'Song Title' " + 
+            unixPrintOptionShortName + " \"Artist Name\"";
+        ShellCommand shellCommand{ command };
+        ShellCommandSource source{ shellCommand };
+        EXPECT_EQ(source.RemainingHint(), 5);
+
+        Parser parser{ &program, source };
+        parser.Add(&print);
+        ASSERT_EQ(parser.Parse(), Parser::Status::Success);
+        ASSERT_EQ(print.Values().size(), 2);
+        EXPECT_EQ(print.Values()[0], "Song Title");
+        EXPECT_EQ(print.Values()[1], "Artist Name");
+    }
+}
@@ -0,0 +1,56 @@
+// ShellCommandTests.h - Declares the ShellCommand test fixture.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_SHELL_COMMAND_TESTS_H
+#define CMD_LINE_SHELL_COMMAND_TESTS_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "gtest/gtest.h"
+#include "ArgSource.h"
+#include "ExampleArguments.h"
+#include "Parser.h"
+#include "ProgParam.h"
+#include "ShellCommand.h"
+#include "TestAlgorithms.h"
+#include "ValueOption.h"
+
+namespace CmdLine
+{
+    /// @brief Test fixture for the ShellCommand tests.
+    ///
+    /// See ShellCommandTests.cpp for the actual tests.
+    class ShellCommandTests : public ::testing::Test
+    {
+    protected:
+        /// @brief Splits a command into arguments.
+        ///
+        /// @param command The command to split.
+        /// @return A copy of each argument, in order.
+        std::vector<std::string> Split(std::string_view command);
+
+        /// @brief Determines if an argument is a view of a command.
+        ///
+        /// @param arg The argument.
+        /// @param command The command.
+        /// @return True if the argument's characters are in the command.
+        bool IsViewOf(std::string_view arg, std::string_view command);
+    };
+}
+
+#endif
@@ -0,0 +1,408 @@
+// SyntheticCli.cpp - Defines the synthetic CLI schema and argument generator.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include "SyntheticCli.h"
+
+namespace CmdLine
+{
+    namespace
+    {
+        // Common option words, so generated help and arguments look like
+        // those of a real program. Once they run out, they are reused with
+        // a numeric suffix (e.g. "verbose-2"), which keeps every name unique.
+        const char* optionWords[]
+        {
+            "verbose", "quiet", "output", "input", "recursive", "force",
+            "dry-run", "config", "format", "level", "jobs", "timeout",
+            "exclude", "include", "color", "no-color", "debug", "trace",
+            "log-file", "retry", "limit", "depth", "sort", "reverse",
+            "user", "group", "mode", "interactive", "backup", "suffix",
+            "preserve", "strict", "parallel", "cache-dir", "no-cache",
+            "profile", "target", "prefix", "encoding", "all"
+        };
+
+        const char* optionParamWords[]
+        {
+            "name", "value", "path", "mode", "level", "size", "count",
+            "format", "user", "key", "type", "limit"
+        };
+
+        const char* posParamWords[]
+        {
+            "destination", "pattern", "host", "target", "command", "archive"
+        };
+
+        const char* directories[]
+        {
+            "src", "include", "docs", "tests", "data", "build/out"
+        };
+
+        const char* extensions[]
+        {
+            ".cpp", ".h", ".txt", ".json", ".md", ".tar.gz"
+        };
+
+        // Every letter and digit except the built-in help Option's 'h'.
+        const std::string shortNamePool
+        {
+            "abcdefgijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+        };
+
+        template <typename T, std::size_t N>
+        constexpr std::size_t CountOf(const T (&)[N])
+        {
+            return N;
+        }
+
+        std::string NumberedWord(const char* const* words, std::size_t count,
+            std::size_t i)
+        {
+            std::string word = words[i % count];
+            std::size_t round = i / count;
+            if (round > 0)
+            {
+                word += '-';
+                word += std::to_string(round + 1);
+            }
+
+            return word;
+        }
+
+        char TakeShortName(std::string& available, char preferred)
+        {
+            if (available.empty())
+                return 0;
+
+            // Prefer the first letter of the long name, like most programs.
+            std::size_t i = available.find(preferred);
+            if (i == std::string::npos)
+                i = 0;
+
+            char shortName = available[i];
+            available.erase(i, 1);
+            return shortName;
+        }
+
+        std::string GenerateFilePath(SyntheticRandom& r)
+        {
+            std::string path = directories[r.Below(CountOf(directories))];
+            path += "/file" + std::to_string(r.Below(10000));
+            path += extensions[r.Below(CountOf(extensions))];
+            return path;
+        }
+
+        std::string GenerateOptionValue(const SyntheticOption& o,
+            SyntheticRandom& r, const SyntheticArgsSpec& s)
+        {
+            if (!o.params.empty() && r.Chance(s.nameValuePercent))
+            {
+                const auto& p = o.params[r.Below(o.params.size())];
+                return p->Name() + "=v" + std::to_string(r.Below(1000));
+            }
+
+            // Plain values are numbers, words or paths, as in real programs.
+            switch (r.Below(3))
+            {
+                case 0:
+                    return std::to_string(r.Below(100000));
+                case 1:
+                    return "value" + std::to_string(r.Below(1000));
+                default:
+                    return GenerateFilePath(r);
+            }
+        }
+    }
+
+    std::uint64_t SyntheticRandom::Next()
+    {
+        // splitmix64, see https://prng.di.unimi.it/splitmix64.c
+        std::uint64_t z = (mState += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    std::size_t SyntheticRandom::Below(std::size_t n)
+    {
+        if (n == 0)
+            return 0;
+
+        // The slight bias towards low numbers doesn't matter here.
+        return static_cast<std::size_t>(Next() % n);
+    }
+
+    std::size_t SyntheticRandom::Skewed(std::size_t n)
+    {
+        if (n == 0)
+            return 0;
+
+        // Squaring a uniform number in [0, 1) makes low numbers more likely.
+        // The top 53 bits convert to a double exactly on every platform.
+        double u = static_cast<double>(Next() >> 11) / 9007199254740992.0;
+        std::size_t i = static_cast<std::size_t>(u * u * n);
+        return i < n ? i : n - 1;
+    }
+
+    bool SyntheticRandom::Chance(std::size_t percent)
+    {
+        return Below(100) < percent;
+    }
+
+    SyntheticSchema GenerateSyntheticSchema(const SyntheticSchemaSpec& s)
+    {
+        SyntheticRandom r{ s.seed };
+        SyntheticSchema schema;
+
+        ProgParam::Definition programDef;
+        programDef.name = "synthetic";
+        programDef.description = "a synthetic program";
+        schema.program = std::make_unique<ProgParam>(programDef);
+
+        std::string availableShortNames = shortNamePool;
+        std::size_t paramCount = s.optionParamsPerValueOption;
+        if (paramCount > CountOf(optionParamWords))
+            paramCount = CountOf(optionParamWords);
+
+        schema.options.reserve(s.optionCount);
+        for (std::size_t i = 0; i < s.optionCount; i++)
+        {
+            SyntheticOption o;
+            std::string longName = NumberedWord(optionWords, 
+                CountOf(optionWords), i);
+
+            char shortName = 0;
+            if (r.Chance(s.shortNamePercent))
+                shortName = TakeShortName(availableShortNames, longName[0]);
+
+            // ValueOptions are spread evenly through the defined Options so
+            // that any run of Options has the requested ratio of them.
+            const std::size_t percent = s.valueOptionPercent;
+            o.takesValue = (i * percent) / 100 != ((i + 1) * percent) / 100;
+
+            if (o.takesValue)
+            {
+                ValueOption::Definition d;
+                d.shortName = shortName;
+                d.longName = longName;
+                d.description = "sets the " + longName;
+                d.style = s.style;
+                auto valueOption = std::make_unique<ValueOption>(d);
+
+                for (std::size_t p = 0; p < paramCount; p++)
+                {
+                    OptionParam::Definition paramDef;
+                    paramDef.name = optionParamWords[p];
+                    paramDef.description = "sets the " + paramDef.name;
+                    o.params.push_back(
+                        std::make_unique<OptionParam>(paramDef));
+                    valueOption->Add(o.params.back().get());
+                }
+
+                o.option = std::move(valueOption);
+            }
+            else
+            {
+                Option::Definition d;
+                d.shortName = shortName;
+                d.longName = longName;
+                d.description = "enables " + longName;
+                d.style = s.style;
+                o.option = std::make_unique<Option>(d);
+            }
+
+            schema.options.push_back(std::move(o));
+        }
+
+        for (std::size_t i = 0; i < s.posParamCount; i++)
+        {
+            PosParam::Definition d;
+            d.name = NumberedWord(posParamWords, CountOf(posParamWords), i);
+            d.description = "the " + d.name;
+            d.isMandatory = true;
+            schema.posParams.push_back(std::make_unique<PosParam>(d));
+        }
+
+        if (s.hasMultiPosParam)
+        {
+            MultiPosParam::Definition d;
+            d.name = "sources";
+            d.description = "the sources";
+            d.isMandatory = true;
+            d.order = s.order;
+            schema.multiPosParam = std::make_unique<MultiPosParam>(d);
+        }
+
+        return schema;
+    }
+
+    std::unique_ptr<Parser> CreateSyntheticParser(SyntheticSchema& schema,
+        std::vector<std::string> args)
+    {
+        auto parser = std::make_unique<Parser>(schema.program.get(), args);
+        for (auto& o : schema.options)
+            parser->Add(o.option.get());
+        for (auto& p : schema.posParams)
+            parser->Add(p.get());
+        parser->Set(schema.multiPosParam.get());
+        return parser;
+    }
+
+    std::vector<std::string> GenerateSyntheticArgs(
+        const SyntheticSchema& schema, const SyntheticArgsSpec& s)
+    {
+        using Placement = SyntheticArgsSpec::OptionPlacement;
+
+        SyntheticRandom r{ s.seed };
+        const bool hasMultiPos = schema.multiPosParam != nullptr;
+        const std::size_t posCount = schema.posParams.size();
+        const std::size_t minPositional = posCount + (hasMultiPos ? 1 : 0);
+        const std::size_t maxOptionArgs = s.argCount > minPositional ?
+            s.argCount - minPositional : 0;
+
+        // Without a MultiPosParam, any arguments not needed by the PosParams
+        // have to be options, otherwise parsing would fail.
+        std::size_t optionArgBudget = s.argCount * s.optionPercent / 100;
+        if (!hasMultiPos || optionArgBudget > maxOptionArgs)
+            optionArgBudget = maxOptionArgs;
+
+        // A ValueOption and its value must stay together, so each option
+        // argument is generated as a group of one or two arguments.
+        std::vector<std::vector<std::string>> optionGroups;
+        std::size_t optionArgs = 0;
+        while (optionArgs < optionArgBudget && !schema.options.empty())
+        {
+            std::size_t i = r.Skewed(schema.options.size());
+
+            // With room for only one more argument, a ValueOption won't fit,
+            // so either use the next plain Option or leave the argument to
+            // the MultiPosParam.
+            if (optionArgBudget - optionArgs == 1)
+            {
+                std::size_t tried = 0;
+                while (tried < schema.options.size() &&
+                    schema.options[i].takesValue)
+                {
+                    i = (i + 1) % schema.options.size();
+                    tried++;
+                }
+
+                if (schema.options[i].takesValue && hasMultiPos)
+                    break;
+            }
+
+            const SyntheticOption& o = schema.options[i];
+            std::vector<std::string> group;
+            bool hasShortName = o.option->Name() != o.option->LongName();
+            if (hasShortName && !r.Chance(s.longNamePercent))
+                group.push_back(o.option->Name());
+            else
+                group.push_back(o.option->LongName());
+
+            if (o.takesValue)
+                group.push_back(GenerateOptionValue(o, r, s));
+
+            optionArgs += group.size();
+            optionGroups.push_back(std::move(group));
+        }
+
+        // Users type the MultiPosParam arguments where the ParsingOrder 
+        // expects them: before the PosParam arguments for AfterOptions.
+        const std::size_t multiPosCount = s.argCount > optionArgs + posCount ?
+            s.argCount - optionArgs - posCount : 0;
+        std::vector<std::string> posArgs;
+        std::vector<std::string> multiPosArgs;
+        for (std::size_t i = 0; i < posCount; i++)
+            posArgs.push_back(GenerateFilePath(r));
+        for (std::size_t i = 0; hasMultiPos && i < multiPosCount; i++)
+            multiPosArgs.push_back(GenerateFilePath(r));
+
+        std::vector<std::string> positionalArgs;
+        positionalArgs.reserve(posArgs.size() + multiPosArgs.size());
+        if (hasMultiPos && 
+            schema.multiPosParam->Order() == 
+            MultiPosParam::ParsingOrder::AfterOptions)
+        {
+            positionalArgs.insert(positionalArgs.end(), multiPosArgs.begin(),
+                multiPosArgs.end());
+            positionalArgs.insert(positionalArgs.end(), posArgs.begin(), 
+                posArgs.end());
+        }
+        else
+        {
+            positionalArgs.insert(positionalArgs.end(), posArgs.begin(), 
+                posArgs.end());
+            positionalArgs.insert(positionalArgs.end(), multiPosArgs.begin(),
+                multiPosArgs.end());
+        }
+
+        std::vector<std::string> args{ schema.program->Name() };
+        args.reserve(optionArgs + positionalArgs.size() + 1);
+
+        std::size_t nextGroup = 0;
+        std::size_t nextPositional = 0;
+        while (nextGroup < optionGroups.size() || 
+            nextPositional < positionalArgs.size())
+        {
+            const std::size_t groupsLeft = optionGroups.size() - nextGroup;
+            const std::size_t positionalLeft = 
+                positionalArgs.size() - nextPositional;
+
+            bool takeGroup = false;
+            if (s.placement == Placement::First)
+                takeGroup = groupsLeft > 0;
+            else if (s.placement == Placement::Last)
+                takeGroup = positionalLeft == 0;
+            else
+                takeGroup = r.Below(groupsLeft + positionalLeft) < groupsLeft;
+
+            if (takeGroup)
+            {
+                const auto& group = optionGroups[nextGroup++];
+                args.insert(args.end(), group.begin(), group.end());
+            }
+            else
+            {
+                args.push_back(positionalArgs[nextPositional++]);
+            }
+        }
+
+        return args;
+    }
+
+    std::vector<std::vector<std::string>> GenerateSyntheticCorpus(
+        const SyntheticSchema& schema, const SyntheticArgsSpec& s,
+        std::size_t count)
+    {
+        SyntheticRandom r{ s.seed };
+        const std::size_t minArgCount = schema.posParams.size() + 
+            (schema.multiPosParam != nullptr ? 1 : 0);
+
+        std::vector<std::vector<std::string>> corpus;
+        corpus.reserve(count);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            SyntheticArgsSpec invocation = s;
+            invocation.seed = r.Next();
+            invocation.argCount = minArgCount;
+            if (s.argCount > minArgCount)
+                invocation.argCount += r.Skewed(s.argCount - minArgCount + 1);
+
+            corpus.push_back(GenerateSyntheticArgs(schema, invocation));
+        }
+
+        return corpus;
+    }
+}
@@ -0,0 +1,243 @@
+// SyntheticCli.h - Declares the synthetic CLI schema and argument generator.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_SYNTHETIC_CLI_H
+#define CMD_LINE_SYNTHETIC_CLI_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Parser.h"
+#include "ProgParam.h"
+#include "Option.h"
+#include "ValueOption.h"
+#include "OptionParam.h"
+#include "PosParam.h"
+#include "MultiPosParam.h"
+
+namespace CmdLine
+{
+    /// @brief A small, seedable pseudo-random number generator.
+    ///
+    /// Implements splitmix64 rather than using the standard library
+    /// distributions, whose results differ between standard library
+    /// implementations. The same seed therefore produces exactly the same
+    /// sequence on every platform and compiler.
+    class SyntheticRandom
+    {
+    public:
+        /// @brief Constructs a SyntheticRandom from a seed.
+        ///
+        /// @param seed The seed that determines the sequence produced.
+        SyntheticRandom(std::uint64_t seed) : mState{ seed } { }
+
+        /// @brief Gets the next number in the sequence.
+        ///
+        /// @return A number uniformly distributed over all 64-bit values.
+        std::uint64_t Next();
+
+        /// @brief Gets a number in the range [0, n).
+        ///
+        /// @param n The upper bound of the range (exclusive).
+        /// @return A number less than n, or 0 if n is 0.
+        std::size_t Below(std::size_t n);
+
+        /// @brief Gets a number in the range [0, n) favouring low numbers.
+        ///
+        /// Real programs have a handful of popular options that are used far
+        /// more often than the rest. Using this to pick an Option makes the
+        /// first Options in a schema the popular ones.
+        ///
+        /// @param n The upper bound of the range (exclusive).
+        /// @return A number less than n, or 0 if n is 0.
+        std::size_t Skewed(std::size_t n);
+
+        /// @brief Determines the outcome of an event with some probability.
+        ///
+        /// @param percent The chance of the event happening (0 to 100).
+        /// @return True if the event happens, otherwise false.
+        bool Chance(std::size_t percent);
+    private:
+        std::uint64_t mState;
+    };
+
+    /// @brief Describes the schema of a synthetic program.
+    struct SyntheticSchemaSpec
+    {
+        /// @brief The seed that determines every random choice.
+        std::uint64_t seed = 1;
+
+        /// @brief The number of Options (and ValueOptions) to define.
+        ///
+        /// Does not include the Parser's built-in help Option.
+        std::size_t optionCount = 10;
+
+        /// @brief The percentage of defined Options that are ValueOptions.
+        std::size_t valueOptionPercent = 25;
+
+        /// @brief The percentage of Options that also have a short name.
+        ///
+        /// Only 61 short names are available (every letter and digit except
+        /// the built-in help Option's), so large schemas run out of them.
+        std::size_t shortNamePercent = 30;
+
+        /// @brief The number of OptionParams added to each ValueOption.
+        std::size_t optionParamsPerValueOption = 2;
+
+        /// @brief The number of single-value PosParams to add.
+        std::size_t posParamCount = 1;
+
+        /// @brief Determines if a MultiPosParam is set on the Parser.
+        bool hasMultiPosParam = true;
+
+        /// @brief The ParsingOrder of the MultiPosParam.
+        MultiPosParam::ParsingOrder order = MultiPosParam::ParsingOrder::End;
+
+        /// @brief The Option::Style of every Option.
+        Option::Style style = Option::Style::Unix;
+    };
+
+    /// @brief An Option of a synthetic schema and what it accepts.
+    struct SyntheticOption
+    {
+        /// @brief The Option (or ValueOption) itself.
+        std::unique_ptr<Option> option;
+
+        /// @brief Determines if the Option is a ValueOption.
+        bool takesValue = false;
+
+        /// @brief The OptionParams added to the ValueOption, if any.
+        std::vector<std::unique_ptr<OptionParam>> params;
+    };
+
+    /// @brief The Params of a synthetic program.
+    ///
+    /// Owns every Param, so a Parser created from the schema remains valid
+    /// for as long as the schema does. A Param can only be populated once,
+    /// so a schema should only be parsed once.
+    struct SyntheticSchema
+    {
+        /// @brief The ProgParam populated with the program name.
+        std::unique_ptr<ProgParam> program;
+
+        /// @brief The Options (and ValueOptions) to add to the Parser.
+        std::vector<SyntheticOption> options;
+
+        /// @brief The single-value PosParams to add to the Parser.
+        std::vector<std::unique_ptr<PosParam>> posParams;
+
+        /// @brief The MultiPosParam to set on the Parser, if any.
+        std::unique_ptr<MultiPosParam> multiPosParam;
+    };
+
+    /// @brief Describes the arguments of one synthetic invocation.
+    struct SyntheticArgsSpec
+    {
+        /// @brief Where option arguments appear in the argument list.
+        enum class OptionPlacement
+        {
+            /// @brief All option arguments come before positional arguments.
+            First,
+
+            /// @brief Option arguments are mixed in with positional ones.
+            Interleaved,
+
+            /// @brief All option arguments come after positional arguments.
+            Last
+        };
+
+        /// @brief The seed that determines every random choice.
+        std::uint64_t seed = 1;
+
+        /// @brief The number of arguments, not including the program name.
+        std::size_t argCount = 10;
+
+        /// @brief The percentage of arguments that are options or values.
+        std::size_t optionPercent = 25;
+
+        /// @brief The percentage of option values that are name-value pairs.
+        ///
+        /// Name-value pairs name one of the ValueOption's OptionParams, so
+        /// they also populate it.
+        std::size_t nameValuePercent = 50;
+
+        /// @brief The percentage of options specified by their long name.
+        ///
+        /// Options without a short name always use their long name.
+        std::size_t longNamePercent = 70;
+
+        /// @brief Where the option arguments appear.
+        OptionPlacement placement = OptionPlacement::Interleaved;
+    };
+
+    /// @brief Generates the schema of a synthetic program.
+    ///
+    /// Options are named after common command line option words (numbered
+    /// once the words run out) and ValueOptions are spread evenly through
+    /// them. The seed decides which Options have short names. The same spec
+    /// always generates the same schema.
+    ///
+    /// @param s The spec describing the schema.
+    /// @return The generated schema.
+    SyntheticSchema GenerateSyntheticSchema(const SyntheticSchemaSpec& s);
+
+    /// @brief Creates a Parser with every Param of a synthetic schema.
+    ///
+    /// @param schema The schema to create the Parser for.
+    /// @param args The arguments to create the Parser with.
+    /// @return The Parser, ready to parse.
+    std::unique_ptr<Parser> CreateSyntheticParser(SyntheticSchema& schema,
+        std::vector<std::string> args);
+
+    /// @brief Generates the arguments of a synthetic invocation.
+    ///
+    /// The arguments start with the program name followed by option 
+    /// arguments (favouring the first Options of the schema, each 
+    /// ValueOption followed by a plain value or a name-value pair) and
+    /// positional file paths. There is always exactly one positional
+    /// argument per PosParam; the rest populate the MultiPosParam, or are
+    /// options if the schema has no MultiPosParam. The arguments are always
+    /// valid for the schema, so parsing them succeeds, and the same schema
+    /// and spec always generate the same arguments.
+    ///
+    /// @param schema The schema the arguments are for.
+    /// @param s The spec describing the arguments.
+    /// @return The generated arguments.
+    /// @pre The spec has an argCount of at least the number of PosParams,
+    /// plus one if the schema has a MultiPosParam.
+    /// @pre The schema has Options if any option arguments are needed.
+    std::vector<std::string> GenerateSyntheticArgs(
+        const SyntheticSchema& schema, const SyntheticArgsSpec& s);
+
+    /// @brief Generates a corpus of synthetic invocations.
+    ///
+    /// Real programs are mostly invoked with a few arguments and only
+    /// occasionally with many, so the argument count of each invocation
+    /// favours short invocations, up to the spec's argCount. Each
+    /// invocation uses its own seed derived from the spec's seed.
+    ///
+    /// @param schema The schema the arguments are for.
+    /// @param s The spec describing the largest invocation.
+    /// @param count The number of invocations to generate.
+    /// @return The arguments of each invocation.
+    std::vector<std::vector<std::string>> GenerateSyntheticCorpus(
+        const SyntheticSchema& schema, const SyntheticArgsSpec& s,
+        std::size_t count);
+}
+
+#endif
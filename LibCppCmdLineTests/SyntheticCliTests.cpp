@@ -0,0 +1,243 @@
+// SyntheticCliTests.cpp - Defines the synthetic CLI generator tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#include <set>
+#include "SyntheticCliTests.h"
+
+namespace CmdLine
+{
+    SyntheticCliTests::SyntheticCliTests()
+    {
+        largeSchemaSpec.optionCount = 2000;
+        largeSchemaSpec.valueOptionPercent = 40;
+        largeSchemaSpec.optionParamsPerValueOption = 4;
+        largeSchemaSpec.posParamCount = 3;
+
+        largeArgsSpec.argCount = 2000;
+    }
+
+    void SyntheticCliTests::ExpectGeneratedArgsParsed(
+        const SyntheticSchemaSpec& schemaSpec, 
+        const SyntheticArgsSpec& argsSpec)
+    {
+        SyntheticSchema schema = GenerateSyntheticSchema(schemaSpec);
+        auto args = GenerateSyntheticArgs(schema, argsSpec);
+        auto parser = CreateSyntheticParser(schema, args);
+
+        ASSERT_EQ(parser->Parse(), Parser::Status::Success);
+        EXPECT_TRUE(parser->AllMandatoryParamsSpecified());
+
+        std::size_t positionalCount = 0;
+        for (const auto& arg : args)
+        {
+            if (!IsOption(arg))
+                positionalCount++;
+        }
+
+        // Discount the program name and every option value.
+        positionalCount--;
+        for (const auto& o : schema.options)
+        {
+            if (o.takesValue)
+            {
+                auto* v = static_cast<ValueOption*>(o.option.get());
+                positionalCount -= v->Values().size();
+            }
+        }
+
+        for (const auto& p : schema.posParams)
+            EXPECT_TRUE(p->IsSpecified());
+
+        std::size_t multiPosCount = positionalCount - schema.posParams.size();
+        if (schema.multiPosParam != nullptr)
+            EXPECT_EQ(schema.multiPosParam->Values().size(), multiPosCount);
+        else
+            EXPECT_EQ(multiPosCount, 0);
+    }
+
+    std::vector<std::string> SyntheticCliTests::OptionNames(
+        const SyntheticSchema& schema)
+    {
+        std::vector<std::string> names;
+        for (const auto& o : schema.options)
+        {
+            names.push_back(o.option->Name());
+            names.push_back(o.option->LongName());
+        }
+
+        return names;
+    }
+
+    TEST_F(SyntheticCliTests, RandomSequenceIsTheSameOnEveryPlatform)
+    {
+        // The first outputs of splitmix64 seeded with 0.
+        SyntheticRandom r{ 0 };
+        EXPECT_EQ(r.Next(), 0xe220a8397b1dcdafull);
+        EXPECT_EQ(r.Next(), 0x6e789e6aa1b965f4ull);
+        EXPECT_EQ(r.Next(), 0x06c45d188009454full);
+    }
+
+    TEST_F(SyntheticCliTests, RandomNumbersStayInRange)
+    {
+        SyntheticRandom r{ 42 };
+        for (int i = 0; i < 1000; i++)
+        {
+            EXPECT_LT(r.Below(7), 7);
+            EXPECT_LT(r.Skewed(7), 7);
+        }
+
+        EXPECT_EQ(r.Below(0), 0);
+        EXPECT_EQ(r.Skewed(0), 0);
+        EXPECT_FALSE(r.Chance(0));
+        EXPECT_TRUE(r.Chance(100));
+    }
+
+    TEST_F(SyntheticCliTests, SameSeedGeneratesSameSchemaAndArgs)
+    {
+        SyntheticSchema first = GenerateSyntheticSchema(largeSchemaSpec);
+        SyntheticSchema second = GenerateSyntheticSchema(largeSchemaSpec);
+
+        EXPECT_EQ(OptionNames(first), OptionNames(second));
+        EXPECT_EQ(GenerateSyntheticArgs(first, largeArgsSpec),
+            GenerateSyntheticArgs(second, largeArgsSpec));
+        EXPECT_EQ(GenerateSyntheticCorpus(first, largeArgsSpec, 10),
+            GenerateSyntheticCorpus(second, largeArgsSpec, 10));
+    }
+
+    TEST_F(SyntheticCliTests, DifferentSeedsGenerateDifferentSchemasAndArgs)
+    {
+        SyntheticSchemaSpec otherSchemaSpec = largeSchemaSpec;
+        otherSchemaSpec.seed++;
+        SyntheticArgsSpec otherArgsSpec = largeArgsSpec;
+        otherArgsSpec.seed++;
+
+        SyntheticSchema schema = GenerateSyntheticSchema(largeSchemaSpec);
+        SyntheticSchema other = GenerateSyntheticSchema(otherSchemaSpec);
+
+        EXPECT_NE(OptionNames(schema), OptionNames(other));
+        EXPECT_NE(GenerateSyntheticArgs(schema, largeArgsSpec),
+            GenerateSyntheticArgs(schema, otherArgsSpec));
+    }
+
+    TEST_F(SyntheticCliTests, GeneratesSchemaOfRequestedShape)
+    {
+        SyntheticSchema schema = GenerateSyntheticSchema(largeSchemaSpec);
+
+        ASSERT_EQ(schema.options.size(), largeSchemaSpec.optionCount);
+        EXPECT_EQ(schema.posParams.size(), largeSchemaSpec.posParamCount);
+        EXPECT_NE(schema.multiPosParam, nullptr);
+
+        std::size_t valueOptions = 0;
+        for (const auto& o : schema.options)
+        {
+            if (o.takesValue)
+            {
+                valueOptions++;
+                EXPECT_EQ(o.params.size(), 
+                    largeSchemaSpec.optionParamsPerValueOption);
+            }
+            else
+            {
+                EXPECT_TRUE(o.params.empty());
+            }
+        }
+
+        EXPECT_EQ(valueOptions, largeSchemaSpec.optionCount * 
+            largeSchemaSpec.valueOptionPercent / 100);
+    }
+
+    TEST_F(SyntheticCliTests, GeneratesUniqueOptionNames)
+    {
+        SyntheticSchema schema = GenerateSyntheticSchema(largeSchemaSpec);
+
+        // Adding every Option to a Parser throws on any duplicate.
+        EXPECT_NO_THROW(CreateSyntheticParser(schema, { "synthetic" }));
+    }
+
+    TEST_F(SyntheticCliTests, GeneratesRequestedNumberOfArgs)
+    {
+        SyntheticSchema schema = GenerateSyntheticSchema(largeSchemaSpec);
+
+        for (std::size_t count : { 4, 5, 10, 1000 })
+        {
+            SyntheticArgsSpec s;
+            s.argCount = count;
+            EXPECT_EQ(GenerateSyntheticArgs(schema, s).size(), count + 1);
+        }
+    }
+
+    TEST_F(SyntheticCliTests, ParsesGeneratedArgsWithEveryPlacement)
+    {
+        using Placement = SyntheticArgsSpec::OptionPlacement;
+
+        for (auto placement : 
+            { Placement::First, Placement::Interleaved, Placement::Last })
+        {
+            largeArgsSpec.placement = placement;
+            ExpectGeneratedArgsParsed(largeSchemaSpec, largeArgsSpec);
+        }
+    }
+
+    TEST_F(SyntheticCliTests, ParsesGeneratedArgsWithEveryParsingOrder)
+    {
+        largeSchemaSpec.order = MultiPosParam::ParsingOrder::End;
+        ExpectGeneratedArgsParsed(largeSchemaSpec, largeArgsSpec);
+
+        largeSchemaSpec.order = MultiPosParam::ParsingOrder::AfterOptions;
+        ExpectGeneratedArgsParsed(largeSchemaSpec, largeArgsSpec);
+    }
+
+    TEST_F(SyntheticCliTests, ParsesGeneratedWindowsArgs)
+    {
+        largeSchemaSpec.style = Option::Style::Windows;
+        ExpectGeneratedArgsParsed(largeSchemaSpec, largeArgsSpec);
+    }
+
+    TEST_F(SyntheticCliTests, ParsesGeneratedArgsWithoutMultiPosParam)
+    {
+        largeSchemaSpec.hasMultiPosParam = false;
+        ExpectGeneratedArgsParsed(largeSchemaSpec, largeArgsSpec);
+    }
+
+    TEST_F(SyntheticCliTests, ParsesGeneratedCorpus)
+    {
+        const std::size_t invocations = 20;
+        SyntheticSchema schema = GenerateSyntheticSchema(largeSchemaSpec);
+        auto corpus = GenerateSyntheticCorpus(schema, largeArgsSpec,
+            invocations);
+
+        ASSERT_EQ(corpus.size(), invocations);
+
+        // Short invocations should be far more common than long ones.
+        std::size_t shortInvocations = 0;
+        for (const auto& args : corpus)
+        {
+            EXPECT_LE(args.size(), largeArgsSpec.argCount + 1);
+            if (args.size() <= largeArgsSpec.argCount / 2)
+                shortInvocations++;
+        }
+
+        EXPECT_GT(shortInvocations, invocations / 2);
+
+        // A schema can only be parsed once, so each invocation needs its own.
+        for (const auto& args : corpus)
+        {
+            SyntheticSchema fresh = GenerateSyntheticSchema(largeSchemaSpec);
+            auto parser = CreateSyntheticParser(fresh, args);
+            EXPECT_EQ(parser->Parse(), Parser::Status::Success);
+        }
+    }
+}
@@ -0,0 +1,65 @@
+// SyntheticCliTests.h - Declares the SyntheticCliTests fixture.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+#ifndef CMD_LINE_SYNTHETIC_CLI_TESTS_H
+#define CMD_LINE_SYNTHETIC_CLI_TESTS_H
+
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "SyntheticCli.h"
+#include "Parser.h"
+
+namespace CmdLine
+{
+    /// @brief Test fixture for the synthetic CLI generator tests.
+    ///
+    /// Checks that the generator is deterministic, generates schemas of the
+    /// requested shape and that the generated arguments parse successfully
+    /// at production scale, which also makes these the Parser's stress
+    /// tests. See SyntheticCliTests.cpp for the actual tests.
+    class SyntheticCliTests : public ::testing::Test
+    {
+    protected:
+        /// @brief Generates a schema and arguments and parses them.
+        ///
+        /// Also checks that every argument populated a Param: each
+        /// PosParam, and the MultiPosParam with every remaining positional
+        /// argument.
+        ///
+        /// @param schemaSpec The spec of the schema to generate.
+        /// @param argsSpec The spec of the arguments to generate.
+        void ExpectGeneratedArgsParsed(const SyntheticSchemaSpec& schemaSpec,
+            const SyntheticArgsSpec& argsSpec);
+
+        /// @brief Gets the prefixed names of every Option in a schema.
+        ///
+        /// @param schema The schema to get the Option names from.
+        /// @return The Name() and LongName() of each Option, in order.
+        std::vector<std::string> OptionNames(const SyntheticSchema& schema);
+
+        /// @brief A schema the size of a large real program.
+        SyntheticSchemaSpec largeSchemaSpec;
+
+        /// @brief Arguments the size of a large real invocation.
+        SyntheticArgsSpec largeArgsSpec;
+
+        /// @brief Constructs the SyntheticCliTests fixture.
+        SyntheticCliTests();
+    };
+}
+
+#endif
@@ -31,6 +31,28 @@
 #include "MultiPosParam.h"
 #include "ProgParam.h"
 #include "Constants.h"
+#include "Error.h"
+
+/// @brief Expects a library error, however the library reports errors.
+///
+/// A library built with exceptions throws the exception; one built without
+/// them returns (or records) an Error with the corresponding ErrorCode, which
+/// the statement must evaluate to.
+///
+/// @param statement The statement that reports the error.
+/// @param exception The exception the statement throws.
+/// @param errorCode The ErrorCode of the Error the statement returns.
+#ifdef CMD_LINE_NO_EXCEPTIONS
+#define EXPECT_CMD_LINE_ERROR(statement, exception, errorCode) \
+    EXPECT_EQ((statement).code, errorCode)
+#define ASSERT_CMD_LINE_ERROR(statement, exception, errorCode) \
+    ASSERT_EQ((statement).code, errorCode)
+#else
+#define EXPECT_CMD_LINE_ERROR(statement, exception, errorCode) \
+    EXPECT_THROW(statement, exception)
+#define ASSERT_CMD_LINE_ERROR(statement, exception, errorCode) \
+    ASSERT_THROW(statement, exception)
+#endif
 
 namespace CmdLine
 {
@@ -375,7 +397,8 @@ namespace CmdLine
         for (auto name : test.invalidNames)
         {
             definition.name = name;
-            EXPECT_THROW(U{ definition }, Param::InvalidDefinition);
+            EXPECT_CMD_LINE_ERROR(U{ definition }.ConstructionError(), 
+                Param::InvalidDefinition, ErrorCode::InvalidDefinition);
         }
     }
 
@@ -409,7 +432,8 @@ namespace CmdLine
         {
             d.shortName = name;
             if (name != 0)
-                ASSERT_THROW(U{ d }, Param::InvalidDefinition);
+                ASSERT_CMD_LINE_ERROR(U{ d }.ConstructionError(), 
+                    Param::InvalidDefinition, ErrorCode::InvalidDefinition);
         }
 
         // Put the short name back so it doesn't interfere with long name tests
@@ -425,7 +449,8 @@ namespace CmdLine
         {
             d.longName = name;
             if (name != "")
-                ASSERT_THROW(U{ d }, Param::InvalidDefinition);
+                ASSERT_CMD_LINE_ERROR(U{ d }.ConstructionError(), 
+                    Param::InvalidDefinition, ErrorCode::InvalidDefinition);
         }
 
         d.longName = "test";
@@ -437,7 +462,8 @@ namespace CmdLine
         d.shortName = 0;
         ASSERT_NO_THROW(U{ d });
         d.longName = "";
-        ASSERT_THROW(U{ d }, Param::InvalidDefinition);
+        ASSERT_CMD_LINE_ERROR(U{ d }.ConstructionError(), 
+            Param::InvalidDefinition, ErrorCode::InvalidDefinition);
         d.longName = "test";
         ASSERT_NO_THROW(U{ d });
     }
@@ -236,12 +236,13 @@ namespace CmdLine
 
         // Use mandatoryOption because we never added parameters to it
         EXPECT_NO_THROW(mandatoryOption->Add(songPrintParam.get()));
-        EXPECT_THROW(mandatoryOption->Add(dupSongPrintParam.get()), 
-            ValueOption::DuplicateOptionParam);
+        EXPECT_CMD_LINE_ERROR(mandatoryOption->Add(dupSongPrintParam.get()), 
+            ValueOption::DuplicateOptionParam, 
+            ErrorCode::DuplicateOptionParam);
         EXPECT_NO_THROW(mandatoryOption->Add(artistPrintParam.get()));
         EXPECT_NO_THROW(mandatoryOption->Add(albumPrintParam.get()));
-        EXPECT_THROW(mandatoryOption->Add(nullParam), 
-            ValueOption::NullOptionParam);
+        EXPECT_CMD_LINE_ERROR(mandatoryOption->Add(nullParam), 
+            ValueOption::NullOptionParam, ErrorCode::NullOptionParam);
     }
 
     TEST_F(ValueOptionTests, ChecksCanPopulateProperly)
@@ -0,0 +1,190 @@
+// ValuePartitionTests.cpp - Defines the ValuePartition tests.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#include "ValuePartitionTests.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#ifdef CMD_LINE_TEST_PARALLEL_ALGORITHMS
+#include <execution>
+#endif
+
+namespace CmdLine
+{
+    ValuePartitionTests::ValuePartitionTests()
+    {
+        for (int i = 0; i < 1000; i++)
+            paths.push_back("src/file" + std::to_string(i) + ".cpp");
+    }
+
+    bool ValuePartitionTests::EachProcessedOnce(
+        const std::vector<int>& counts) const
+    {
+        return std::all_of(counts.begin(), counts.end(), 
+            [](int c) { return c == 1; });
+    }
+
+    std::size_t ValuePartitionTests::IndexOf(std::string_view path) const
+    {
+        // Views of paths point into it, so the index follows from where.
+        for (std::size_t i = 0; i < paths.size(); i++)
+        {
+            if (paths[i].data() == path.data())
+                return i;
+        }
+
+        return paths.size();
+    }
+
+    TEST_F(ValuePartitionTests, SplitsValuesIntoChunks)
+    {
+        ValuePartition partition{ ArgView{ paths }, 300 };
+        ASSERT_EQ(partition.Size(), 4);
+        EXPECT_EQ(partition.ChunkSize(), 300);
+        EXPECT_EQ(partition[0].Size(), 300);
+        EXPECT_EQ(partition[3].Size(), 100);
+        EXPECT_EQ(partition[3][99].data(), paths.back().data());
+        EXPECT_EQ(partition.end() - partition.begin(), 4);
+
+        std::size_t total = 0;
+        for (ArgView chunk : partition)
+            total += chunk.Size();
+        EXPECT_EQ(total, paths.size());
+
+        ValuePartition byDefault{ ArgView{ paths } };
+        EXPECT_GE(byDefault.ChunkSize(), 1);
+        EXPECT_EQ(byDefault[0][0].data(), paths[0].data());
+
+        EXPECT_EQ(ValuePartition{ ArgView{} }.Size(), 0);
+    }
+
+    TEST_F(ValuePartitionTests, PartitionsMultiPosParamValues)
+    {
+        MultiPosParam::Definition filesDef;
+        filesDef.name = "FILES";
+        filesDef.isLazy = true;
+        MultiPosParam files{ filesDef };
+        ASSERT_TRUE(files.PopulateView(ArgView{ paths }));
+
+        ValuePartition partition = files.Partition(100);
+        ASSERT_EQ(partition.Size(), 10);
+        EXPECT_EQ(partition[9][0].data(), paths[900].data());
+    }
+
+    TEST_F(ValuePartitionTests, WorksWithParallelAlgorithms)
+    {
+        ValuePartition partition{ ArgView{ paths }, 64 };
+        std::vector<std::atomic<int>> counts(paths.size());
+        auto process = [&](ArgView chunk)
+        {
+            for (std::string_view path : chunk)
+                counts[IndexOf(path)]++;
+        };
+
+#ifdef CMD_LINE_TEST_PARALLEL_ALGORITHMS
+        std::for_each(std::execution::par, partition.begin(), 
+            partition.end(), process);
+#else
+        std::for_each(partition.begin(), partition.end(), process);
+#endif
+
+        std::vector<int> processed{ counts.begin(), counts.end() };
+        EXPECT_TRUE(EachProcessedOnce(processed));
+    }
+
+    TEST_F(ValuePartitionTests, PoolProcessesEachValueOnce)
+    {
+        WorkerPool pool{ 4 };
+        EXPECT_EQ(pool.ThreadCount(), 4);
+
+        // The pool is reused, so run it more than once.
+        for (std::size_t chunkSize : { 1, 7, 1000 })
+        {
+            std::vector<std::atomic<int>> counts(paths.size());
+            pool.ForEach(ValuePartition{ ArgView{ paths }, chunkSize },
+                [&](std::string_view path) { counts[IndexOf(path)]++; });
+
+            std::vector<int> processed{ counts.begin(), counts.end() };
+            EXPECT_TRUE(EachProcessedOnce(processed)) << chunkSize;
+        }
+
+        pool.ForEach(ValuePartition{ ArgView{} }, [](std::string_view) { });
+
+        WorkerPool single{ 1 };
+        std::vector<std::atomic<int>> counts(paths.size());
+        single.ForEach(ValuePartition{ ArgView{ paths } },
+            [&](std::string_view path) { counts[IndexOf(path)]++; });
+        std::vector<int> processed{ counts.begin(), counts.end() };
+        EXPECT_TRUE(EachProcessedOnce(processed));
+    }
+
+    TEST_F(ValuePartitionTests, IdleThreadsStealChunks)
+    {
+        // The first chunk doesn't finish until every other chunk has, 
+        // including those shared out to the same thread, so they can only
+        // finish if another thread steals them.
+        WorkerPool pool{ 2 };
+        ValuePartition partition{ ArgView{ paths }, 10 };
+        std::atomic<std::size_t> finished{ 0 };
+        bool othersFinished = false;
+
+        pool.ForEachChunk(partition, [&](ArgView chunk)
+        {
+            if (chunk[0].data() == paths[0].data())
+            {
+                auto deadline = std::chrono::steady_clock::now() + 
+                    std::chrono::seconds{ 10 };
+                while (finished < partition.Size() - 1 && 
+                    std::chrono::steady_clock::now() < deadline)
+                {
+                    std::this_thread::yield();
+                }
+
+                othersFinished = finished == partition.Size() - 1;
+            }
+
+            finished++;
+        });
+
+        EXPECT_TRUE(othersFinished);
+        EXPECT_EQ(finished, partition.Size());
+    }
+
+    TEST_F(ValuePartitionTests, PoolRethrowsExceptions)
+    {
+#ifdef CMD_LINE_NO_EXCEPTIONS
+        GTEST_SKIP() << "the library is built without exceptions";
+#else
+        WorkerPool pool{ 3 };
+        ValuePartition partition{ ArgView{ paths }, 10 };
+        EXPECT_THROW(pool.ForEach(partition, [&](std::string_view path)
+        {
+            if (path == paths[500])
+                throw std::runtime_error{ "unreadable" };
+        }), std::runtime_error);
+
+        // The pool still works afterwards.
+        std::atomic<std::size_t> count{ 0 };
+        pool.ForEach(partition, [&](std::string_view) { count++; });
+        EXPECT_EQ(count, paths.size());
+#endif
+    }
+}
@@ -0,0 +1,56 @@
+// ValuePartitionTests.h - Declares the ValuePartition test fixture.
+//
+// Copyright (C) 2024 Stephen Bonar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http ://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissionsand
+// limitations under the License.
+
+
+#ifndef CMD_LINE_VALUE_PARTITION_TESTS_H
+#define CMD_LINE_VALUE_PARTITION_TESTS_H
+
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "ArgView.h"
+#include "MultiPosParam.h"
+#include "ValuePartition.h"
+#include "WorkerPool.h"
+
+namespace CmdLine
+{
+    /// @brief Test fixture for the ValuePartition and WorkerPool tests.
+    ///
+    /// Splits a list of file paths into chunks and processes them on 
+    /// several threads. See ValuePartitionTests.cpp for the actual tests.
+    class ValuePartitionTests : public ::testing::Test
+    {
+    protected:
+        ValuePartitionTests();
+
+        /// @brief Determines if every path was processed exactly once.
+        ///
+        /// @param counts How many times each path was processed, by index.
+        /// @return True if each count is 1, otherwise false.
+        bool EachProcessedOnce(const std::vector<int>& counts) const;
+
+        /// @brief Gets the index of a path from its value.
+        ///
+        /// @param path A path from paths.
+        /// @return The index of the path.
+        std::size_t IndexOf(std::string_view path) const;
+
+        std::vector<std::string> paths;
+    };
+}
+
+#endif